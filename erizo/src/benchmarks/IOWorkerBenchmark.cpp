@@ -0,0 +1,137 @@
+/*
+ * IOWorkerBenchmark.cpp
+ *
+ * Echoes UDP packets through the UdpMux of a single IOWorker and reports how many packets per second of
+ * worker CPU time each backend handles.
+ *
+ * Usage: IOWorkerBenchmark [packets] [packet_size]
+ */
+
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <future>  // NOLINT
+#include <memory>
+#include <thread>  // NOLINT
+
+#include "UdpMux.h"
+#include "thread/IOUringWorker.h"
+#include "thread/IOWorker.h"
+
+using erizo::PacketPtr;
+using erizo::IOUringWorker;
+using erizo::IOWorker;
+using erizo::UdpMux;
+using erizo::UdpMuxAddress;
+using erizo::UdpMuxListener;
+
+static constexpr int kBurst = 32;
+static constexpr int kSocketBufferSize = 8 * 1024 * 1024;
+
+class EchoListener : public UdpMuxListener {
+ public:
+  explicit EchoListener(std::shared_ptr<UdpMux> mux) : mux_{mux} {}
+
+  void onMuxPacket(const UdpMuxAddress& remote, PacketPtr packet) override {
+    mux_->queueSend(remote, packet);
+  }
+
+ private:
+  std::shared_ptr<UdpMux> mux_;
+};
+
+static void runInWorker(std::shared_ptr<IOWorker> worker, std::function<void()> f) {
+  auto done = std::make_shared<std::promise<void>>();
+  worker->task([f, done] {
+    f();
+    done->set_value();
+  });
+  done->get_future().wait();
+}
+
+static double workerCpuSeconds(std::shared_ptr<IOWorker> worker) {
+  double seconds = 0;
+  runInWorker(worker, [&seconds] {
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    seconds = now.tv_sec + now.tv_nsec / 1e9;
+  });
+  return seconds;
+}
+
+static void runBenchmark(const char *name, std::shared_ptr<IOWorker> worker, IOUringWorker *driver,
+                         int packets, int packet_size) {
+  auto mux = std::make_shared<UdpMux>(0, "", worker);
+  if (driver) {
+    mux->setIoDriver(driver);
+  }
+  worker->setUdpMux(mux);
+  worker->start();
+
+  int client = socket(AF_INET, SOCK_DGRAM, 0);
+  setsockopt(client, SOL_SOCKET, SO_RCVBUF, &kSocketBufferSize, sizeof(kSocketBufferSize));
+  timeval timeout = {0, 200000};
+  setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  UdpMuxAddress client_address;
+  inet_pton(AF_INET, "127.0.0.1", &client_address.addr.sin_addr);
+  bind(client, reinterpret_cast<sockaddr*>(&client_address.addr), sizeof(client_address.addr));
+  socklen_t length = sizeof(client_address.addr);
+  getsockname(client, reinterpret_cast<sockaddr*>(&client_address.addr), &length);
+
+  auto listener = std::make_shared<EchoListener>(mux);
+  runInWorker(worker, [mux, listener, client_address] {
+    mux->start();
+    mux->bindRemote(client_address, listener);
+  });
+  UdpMuxAddress mux_address = client_address;
+  mux_address.addr.sin_port = htons(mux->getPort());
+
+  char buf[1500];
+  memset(buf, 0x80, sizeof(buf));
+  int echoed = 0;
+  double cpu_start = workerCpuSeconds(worker);
+  auto wall_start = std::chrono::steady_clock::now();
+  // Bursts keep the kernel buffers from overflowing while still giving the loop something to batch
+  for (int sent = 0; sent < packets; sent += kBurst) {
+    for (int index = 0; index < kBurst; index++) {
+      sendto(client, buf, packet_size, 0, reinterpret_cast<sockaddr*>(&mux_address.addr), sizeof(mux_address.addr));
+    }
+    while (echoed < sent + kBurst && recv(client, buf, sizeof(buf), 0) > 0) {
+      echoed++;
+    }
+  }
+  double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+  double cpu = workerCpuSeconds(worker) - cpu_start;
+
+  printf("%-9s packets: %d echoed: %d wall: %.3fs worker cpu: %.3fs pps/core: %.0f", name, packets, echoed,
+         wall, cpu, cpu > 0 ? echoed / cpu : 0);
+  if (driver) {
+    printf(" sqes/enter: %.2f", driver->getSubmitCalls() ?
+           static_cast<double>(driver->getSubmittedSqes()) / driver->getSubmitCalls() : 0);
+  }
+  printf("\n");
+
+  worker->close();
+  ::close(client);
+}
+
+int main(int argc, char *argv[]) {
+  int packets = argc > 1 ? atoi(argv[1]) : 200000;
+  int packet_size = argc > 2 ? atoi(argv[2]) : 1200;
+
+  runBenchmark("nrappkit", std::make_shared<IOWorker>(), nullptr, packets, packet_size);
+  if (IOUringWorker::isSupported()) {
+    auto worker = std::make_shared<IOUringWorker>();
+    runBenchmark("io_uring", worker, worker.get(), packets, packet_size);
+  } else {
+    printf("io_uring is not supported, skipping\n");
+  }
+  return 0;
+}
@@ -0,0 +1,217 @@
+/*
+ * PipelineBenchmark.cpp
+ *
+ * Reads and writes audio and video RTP packets through a chain of pass-through handlers laid out like the
+ * MediaStream one, built as a dynamic Pipeline, as a StaticPipeline and as a StaticPipeline whose video-only
+ * handlers narrow down the packets they see as the MediaStream ones do, and reports the ns per packet of each,
+ * one packet at a time and in batches of the given size. Audio packets also go through the shorter chain of audio
+ * only streams. The handlers do nothing, so the numbers are the cost of
+ * the pipeline itself.
+ *
+ * Usage: PipelineBenchmark [packets] [batch size]
+ */
+
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "pipeline/Handler.h"
+#include "pipeline/StaticPipeline.h"
+#include "rtp/RtpHeaders.h"
+
+using erizo::DataPacket;
+using erizo::Handler;
+using erizo::InboundHandler;
+using erizo::OutboundHandler;
+using erizo::PacketBatch;
+using erizo::PacketPtr;
+using erizo::Pipeline;
+using erizo::RtpHeader;
+using erizo::StaticPipeline;
+using erizo::kAllPackets;
+using erizo::kNoPackets;
+using erizo::kRtcpFeedbackPackets;
+using erizo::kRtcpReportPackets;
+using erizo::kRtpVideoPackets;
+
+// The handlers of MediaStream are in their own translation units, so StaticPipeline can't inline them there either
+#define NOINLINE __attribute__((noinline))
+
+template <int N, uint8_t kRead = kAllPackets>
+class InPass : public InboundHandler {
+ public:
+  static const uint8_t read_packets = kRead;
+
+  void enable() override {}
+  void disable() override {}
+  std::string getName() override { return "in"; }
+  NOINLINE void read(Context *ctx, PacketPtr packet) override { ctx->fireRead(std::move(packet)); }
+  void notifyUpdate() override {}
+};
+
+template <int N, uint8_t kWrite = kAllPackets>
+class OutPass : public OutboundHandler {
+ public:
+  static const uint8_t write_packets = kWrite;
+
+  void enable() override {}
+  void disable() override {}
+  std::string getName() override { return "out"; }
+  NOINLINE void write(Context *ctx, PacketPtr packet) override { ctx->fireWrite(std::move(packet)); }
+  void notifyUpdate() override {}
+};
+
+template <int N, uint8_t kRead = kAllPackets, uint8_t kWrite = kAllPackets>
+class BothPass : public Handler {
+ public:
+  static const uint8_t read_packets = kRead;
+  static const uint8_t write_packets = kWrite;
+
+  void enable() override {}
+  void disable() override {}
+  std::string getName() override { return "both"; }
+  NOINLINE void read(Context *ctx, PacketPtr packet) override { ctx->fireRead(std::move(packet)); }
+  NOINLINE void write(Context *ctx, PacketPtr packet) override { ctx->fireWrite(std::move(packet)); }
+  void notifyUpdate() override {}
+};
+
+class Sink : public InboundHandler {
+ public:
+  void enable() override {}
+  void disable() override {}
+  std::string getName() override { return "sink"; }
+  void read(Context *ctx, PacketPtr packet) override { packets++; }
+  void notifyUpdate() override {}
+
+  uint64_t packets = 0;
+};
+
+class Source : public OutboundHandler {
+ public:
+  void enable() override {}
+  void disable() override {}
+  std::string getName() override { return "source"; }
+  void write(Context *ctx, PacketPtr packet) override { packets++; }
+  void notifyUpdate() override {}
+
+  uint64_t packets = 0;
+};
+
+template <class... Handlers>
+struct HandlerList {};
+
+// Same directions, in the same order, as the handlers of a subscriber MediaStream, between its PacketWriter and
+// PacketReader
+typedef HandlerList<InPass<0>, OutPass<1>, BothPass<3>, BothPass<4>, BothPass<5>, BothPass<6>, BothPass<7>,
+                    BothPass<8>, BothPass<9>, BothPass<10>, BothPass<11>, BothPass<12>, InPass<13>, BothPass<14>,
+                    OutPass<15>, OutPass<16>, BothPass<17>> AllPacketsHandlers;
+
+// The same with the packets PliPacer, RtpPaddingGenerator, RtpSlideShow, QualityFilter and LayerBitrateCalculation
+// ask for
+typedef HandlerList<InPass<0>, OutPass<1>, BothPass<3>, BothPass<4>, BothPass<5>, BothPass<6>, BothPass<7>,
+                    BothPass<8>, BothPass<9, kRtpVideoPackets, kRtcpFeedbackPackets>,
+                    BothPass<10, kNoPackets, kRtpVideoPackets>,
+                    BothPass<11, kRtcpFeedbackPackets | kRtcpReportPackets, kRtpVideoPackets>, BothPass<12>,
+                    InPass<13>, BothPass<14, kRtcpFeedbackPackets | kRtcpReportPackets, kRtpVideoPackets>,
+                    OutPass<15, kRtpVideoPackets>, OutPass<16>, BothPass<17>> MediaStreamHandlers;
+
+// The ones an audio only MediaStream keeps
+typedef HandlerList<InPass<0>, OutPass<1>, BothPass<4>, BothPass<5>, BothPass<6>, BothPass<12>, InPass<13>,
+                    BothPass<17>> AudioOnlyHandlers;
+
+template <class... Handlers>
+static Pipeline::Ptr createDynamicPipeline(HandlerList<Handlers...>, std::shared_ptr<Source> source,
+                                           std::shared_ptr<Sink> sink) {
+  Pipeline::Ptr pipeline = Pipeline::create();
+  pipeline->addBack(source);
+  int added[] = {(pipeline->addBack(std::make_shared<Handlers>()), 0)...};
+  (void)added;
+  pipeline->addBack(sink);
+  pipeline->finalize();
+  return pipeline;
+}
+
+template <class... Handlers>
+static Pipeline::Ptr createStaticPipeline(HandlerList<Handlers...>, std::shared_ptr<Source> source,
+                                          std::shared_ptr<Sink> sink) {
+  Pipeline::Ptr pipeline = StaticPipeline<Source, Handlers..., Sink>::create(source, std::make_shared<Handlers>()...,
+                                                                             sink);
+  pipeline->finalize();
+  return pipeline;
+}
+
+static PacketPtr rtpPacket(erizo::packetType type) {
+  PacketPtr packet = std::make_shared<DataPacket>();
+  memset(packet->data, 0, sizeof(RtpHeader));
+  RtpHeader *header = reinterpret_cast<RtpHeader*>(packet->data);
+  header->setVersion(2);
+  header->setPayloadType(type == erizo::AUDIO_PACKET ? 111 : 96);
+  packet->length = type == erizo::AUDIO_PACKET ? 160 : 1100;
+  packet->type = type;
+  return packet;
+}
+
+static void runBenchmark(const char *name, Pipeline::Ptr pipeline, std::shared_ptr<Source> source,
+                         std::shared_ptr<Sink> sink, PacketPtr packet, int packets, int batch_size) {
+  PacketBatch batch(batch_size, packet);
+  auto start = std::chrono::steady_clock::now();
+  if (batch_size > 1) {
+    for (int index = 0; index < packets; index += batch_size) {
+      pipeline->readBatch(batch);
+    }
+  } else {
+    for (int index = 0; index < packets; index++) {
+      pipeline->read(packet);
+    }
+  }
+  auto read_time = std::chrono::steady_clock::now() - start;
+  start = std::chrono::steady_clock::now();
+  if (batch_size > 1) {
+    for (int index = 0; index < packets; index += batch_size) {
+      pipeline->writeBatch(batch);
+    }
+  } else {
+    for (int index = 0; index < packets; index++) {
+      pipeline->write(packet);
+    }
+  }
+  auto write_time = std::chrono::steady_clock::now() - start;
+
+  printf("%-16s %s batch: %2d packets: %d read: %6.1f ns/packet write: %6.1f ns/packet delivered: %lu/%lu\n",
+         name, packet->type == erizo::AUDIO_PACKET ? "audio" : "video", batch_size, packets,
+         std::chrono::duration<double, std::nano>(read_time).count() / packets,
+         std::chrono::duration<double, std::nano>(write_time).count() / packets, sink->packets, source->packets);
+}
+
+int main(int argc, char *argv[]) {
+  int packets = argc > 1 ? atoi(argv[1]) : 5000000;
+  int batch_size = argc > 2 ? atoi(argv[2]) : 16;
+
+  for (int size : {1, batch_size}) {
+    for (erizo::packetType type : {erizo::AUDIO_PACKET, erizo::VIDEO_PACKET}) {
+      auto source = std::make_shared<Source>();
+      auto sink = std::make_shared<Sink>();
+      runBenchmark("dynamic", createDynamicPipeline(AllPacketsHandlers(), source, sink), source, sink,
+                   rtpPacket(type), packets, size);
+      source = std::make_shared<Source>();
+      sink = std::make_shared<Sink>();
+      runBenchmark("static", createStaticPipeline(AllPacketsHandlers(), source, sink), source, sink,
+                   rtpPacket(type), packets, size);
+      source = std::make_shared<Source>();
+      sink = std::make_shared<Sink>();
+      runBenchmark("static masked", createStaticPipeline(MediaStreamHandlers(), source, sink), source, sink,
+                   rtpPacket(type), packets, size);
+      if (type == erizo::AUDIO_PACKET) {
+        source = std::make_shared<Source>();
+        sink = std::make_shared<Sink>();
+        runBenchmark("audio only", createStaticPipeline(AudioOnlyHandlers(), source, sink), source, sink,
+                     rtpPacket(type), packets, size);
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,243 @@
+/*
+ * SrtpBenchmark.cpp
+ *
+ * Protects and unprotects RTP and RTCP packets of several sizes with every SRTP profile SrtpChannel can be keyed
+ * for, on one thread and then on several at once, and reports packets per second and ns per byte of each.
+ * The AES-128-CTR and AES-128-GCM rates of OpenSSL itself are printed first as a reference: when libsrtp is
+ * built against OpenSSL and the CPU has AES-NI its AES-CM profiles should be close to them, the table based AES of
+ * a native libsrtp build is several times slower.
+ *
+ * Usage: SrtpBenchmark [packets] [threads]
+ */
+
+extern "C" {
+#include <srtp2/srtp.h>
+}
+
+#include <glib.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "SrtpChannel.h"
+#include "rtp/RtpHeaders.h"
+
+using erizo::RtcpHeader;
+using erizo::RtpHeader;
+using erizo::SrtpChannel;
+
+struct Profile {
+  const char *name;
+  srtp_profile_t srtp_profile;
+  bool aead;
+};
+
+static const Profile kProfiles[] = {
+  {"SRTP_AES128_CM_SHA1_80", srtp_profile_aes128_cm_sha1_80, false},
+  {"SRTP_AES128_CM_SHA1_32", srtp_profile_aes128_cm_sha1_32, false},
+  {"SRTP_AEAD_AES_128_GCM", srtp_profile_aead_aes_128_gcm, true},
+  {"SRTP_AEAD_AES_256_GCM", srtp_profile_aead_aes_256_gcm, true},
+};
+
+// Audio frames, small and large video packets and a full MTU
+static const int kPayloadSizes[] = {100, 500, 1100, 1400};
+
+struct Result {
+  double protect_ns = 0;
+  double unprotect_ns = 0;
+  double protect_rtcp_ns = 0;
+  int overhead = 0;
+  int failures = 0;
+};
+
+static std::string randomKey(srtp_profile_t profile) {
+  std::vector<unsigned char> key(srtp_profile_get_master_key_length(profile) +
+                                 srtp_profile_get_master_salt_length(profile));
+  RAND_bytes(key.data(), key.size());
+  gchar *encoded = g_base64_encode(key.data(), key.size());
+  std::string result = encoded;
+  g_free(encoded);
+  return result;
+}
+
+static double elapsedNs(std::chrono::steady_clock::duration duration) {
+  return std::chrono::duration<double, std::nano>(duration).count();
+}
+
+// A sender and a receiver keyed alike, so whatever one side protects the other one can unprotect
+class ChannelPair {
+ public:
+  ChannelPair(const Profile &profile, const std::string &key) {
+    ready = sender.setRtpParams(key, key, profile.name) && receiver.setRtpParams(key, key, profile.name);
+  }
+
+  Result run(int packets, int payload_size) {
+    Result result;
+    char packet[1500];
+    memset(packet, 0x55, sizeof(packet));
+    memset(packet, 0, sizeof(RtpHeader));
+    RtpHeader *header = reinterpret_cast<RtpHeader*>(packet);
+    header->setVersion(2);
+    header->setPayloadType(96);
+    header->setSSRC(1234);
+    int rtp_length = header->getHeaderLength() + payload_size;
+
+    std::chrono::steady_clock::duration protect_time{0};
+    std::chrono::steady_clock::duration unprotect_time{0};
+    for (int index = 0; index < packets; index++) {
+      header->setSeqNumber(index);
+      header->setTimestamp(index * 3000);
+      int length = rtp_length;
+      auto start = std::chrono::steady_clock::now();
+      result.failures += sender.protectRtp(packet, &length) < 0;
+      auto protected_time = std::chrono::steady_clock::now();
+      result.overhead = length - rtp_length;
+      result.failures += receiver.unprotectRtp(packet, &length) < 0;
+      unprotect_time += std::chrono::steady_clock::now() - protected_time;
+      protect_time += protected_time - start;
+    }
+
+    // An RTCP packet of the same size, libsrtp does not look past the first header
+    char rtcp[1500];
+    memset(rtcp, 0x55, sizeof(rtcp));
+    memset(rtcp, 0, sizeof(RtcpHeader));
+    RtcpHeader *rtcp_header = reinterpret_cast<RtcpHeader*>(rtcp);
+    int rtcp_length = (rtp_length / 4) * 4;
+    rtcp_header->setPacketType(RTCP_Receiver_PT);
+    rtcp_header->setLength(rtcp_length / 4 - 1);
+    rtcp_header->setSSRC(1234);
+    rtcp[0] = static_cast<char>(0x80);
+    std::chrono::steady_clock::duration protect_rtcp_time{0};
+    for (int index = 0; index < packets; index++) {
+      char protected_rtcp[1500];
+      memcpy(protected_rtcp, rtcp, rtcp_length);
+      int length = rtcp_length;
+      auto start = std::chrono::steady_clock::now();
+      result.failures += sender.protectRtcp(protected_rtcp, &length) < 0;
+      protect_rtcp_time += std::chrono::steady_clock::now() - start;
+    }
+
+    result.protect_ns = elapsedNs(protect_time) / packets;
+    result.unprotect_ns = elapsedNs(unprotect_time) / packets;
+    result.protect_rtcp_ns = elapsedNs(protect_rtcp_time) / packets;
+    return result;
+  }
+
+  bool ready;
+
+ private:
+  SrtpChannel sender;
+  SrtpChannel receiver;
+};
+
+static double evpNsPerByte(const EVP_CIPHER *cipher, int packets, int size) {
+  unsigned char key[32];
+  unsigned char iv[16];
+  unsigned char data[1500];
+  unsigned char out[1500 + 16];
+  RAND_bytes(key, sizeof(key));
+  RAND_bytes(iv, sizeof(iv));
+  memset(data, 0x55, sizeof(data));
+  EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+  EVP_EncryptInit_ex(ctx, cipher, NULL, key, iv);
+  int length = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int index = 0; index < packets; index++) {
+    EVP_EncryptInit_ex(ctx, NULL, NULL, NULL, iv);
+    EVP_EncryptUpdate(ctx, out, &length, data, size);
+    EVP_EncryptFinal_ex(ctx, out + length, &length);
+  }
+  double elapsed = elapsedNs(std::chrono::steady_clock::now() - start);
+  EVP_CIPHER_CTX_free(ctx);
+  return elapsed / packets / size;
+}
+
+static void runSingleThread(const Profile &profile, int packets, int payload_size) {
+  ChannelPair pair(profile, randomKey(profile.srtp_profile));
+  if (!pair.ready) {
+    printf("%-24s could not create the SRTP sessions\n", profile.name);
+    return;
+  }
+  Result result = pair.run(packets, payload_size);
+  int rtp_length = payload_size + 12;
+  printf("%-24s payload: %4d overhead: %2d protect: %7.0f pps %5.2f ns/byte unprotect: %7.0f pps %5.2f ns/byte"
+         " protectRtcp: %7.0f pps failures: %d\n", profile.name, payload_size, result.overhead,
+         1e9 / result.protect_ns, result.protect_ns / rtp_length, 1e9 / result.unprotect_ns,
+         result.unprotect_ns / rtp_length, 1e9 / result.protect_rtcp_ns, result.failures);
+}
+
+static void runThreads(const Profile &profile, int packets, int payload_size, int threads) {
+  // Every thread gets its own sessions, as every connection does, and they are keyed before the clock starts
+  std::string key = randomKey(profile.srtp_profile);
+  std::vector<std::unique_ptr<ChannelPair>> pairs;
+  for (int index = 0; index < threads; index++) {
+    pairs.emplace_back(new ChannelPair(profile, key));
+    if (!pairs.back()->ready) {
+      printf("%-24s could not create the SRTP sessions\n", profile.name);
+      return;
+    }
+  }
+  std::vector<Result> results(threads);
+  std::vector<std::thread> workers;
+  auto start = std::chrono::steady_clock::now();
+  for (int index = 0; index < threads; index++) {
+    workers.emplace_back([&pairs, &results, index, packets, payload_size] {
+      results[index] = pairs[index]->run(packets, payload_size);
+    });
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  double elapsed = elapsedNs(std::chrono::steady_clock::now() - start);
+  int failures = 0;
+  for (const Result &result : results) {
+    failures += result.failures;
+  }
+  // Each packet is protected and unprotected as RTP and protected once more as RTCP
+  double total_packets = 3.0 * packets * threads;
+  printf("%-24s payload: %4d threads: %2d aggregate: %9.0f pps %5.2f ns/byte failures: %d\n", profile.name,
+         payload_size, threads, total_packets * 1e9 / elapsed, elapsed / total_packets / (payload_size + 12),
+         failures);
+}
+
+int main(int argc, char *argv[]) {
+  int packets = argc > 1 ? atoi(argv[1]) : 100000;
+  int threads = argc > 2 ? atoi(argv[2]) : std::thread::hardware_concurrency();
+
+  printf("libsrtp: %s aead: %s\n", SrtpChannel::getLibraryVersion().c_str(),
+         SrtpChannel::isAeadSupported() ? "yes" : "no");
+  for (int payload_size : kPayloadSizes) {
+    printf("openssl payload: %4d AES-128-CTR: %5.2f ns/byte AES-128-GCM: %5.2f ns/byte\n", payload_size,
+           evpNsPerByte(EVP_aes_128_ctr(), packets, payload_size),
+           evpNsPerByte(EVP_aes_128_gcm(), packets, payload_size));
+  }
+
+  std::vector<int> thread_counts{1};
+  if (threads > 1) {
+    thread_counts.push_back(threads);
+  }
+  for (int thread_count : thread_counts) {
+    for (const Profile &profile : kProfiles) {
+      if (profile.aead && !SrtpChannel::isAeadSupported()) {
+        printf("%-24s not supported by this libsrtp build, skipping\n", profile.name);
+        continue;
+      }
+      for (int payload_size : kPayloadSizes) {
+        if (thread_count == 1) {
+          runSingleThread(profile, packets, payload_size);
+        } else {
+          runThreads(profile, packets, payload_size, thread_count);
+        }
+      }
+    }
+  }
+  return 0;
+}
@@ -12,6 +12,7 @@
 #include "rtp/RtpHeaders.h"
 #include "./LibNiceConnection.h"
 #include "./NicerConnection.h"
+#include "./UdpMuxConnection.h"
 
 using erizo::TimeoutChecker;
 using erizo::DtlsTransport;
@@ -22,8 +23,6 @@ DEFINE_LOGGER(TimeoutChecker, "TimeoutChecker");
 
 using std::memcpy;
 
-static std::mutex dtls_mutex;
-
 TimeoutChecker::TimeoutChecker(DtlsTransport* transport, dtls::DtlsSocketContext* ctx)
     : transport_(transport), socket_context_(ctx),
       check_seconds_(kInitialSecsPerTimeoutCheck), max_checks_(kMaxTimeoutChecks),
@@ -56,13 +55,12 @@ void TimeoutChecker::scheduleNext() {
         if (max_checks_-- > 0) {
           ELOG_DEBUG("Handling dtls timeout, checks left: %d", max_checks_);
           if (socket_context_) {
-            std::lock_guard<std::mutex> guard(dtls_mutex);
-            socket_context_->handleTimeout();
+            transport_->handleDtlsTimeout(socket_context_);
           }
           scheduleNext();
         } else {
           ELOG_DEBUG("%s message: DTLS timeout", transport_->toLog());
-          transport_->onHandshakeFailed(socket_context_, "Dtls Timeout on TimeoutChecker");
+          transport_->onHandshakeFailedSync(socket_context_, "Dtls Timeout on TimeoutChecker");
         }
       }
   }, std::chrono::seconds(check_seconds_));
@@ -71,9 +69,10 @@ void TimeoutChecker::scheduleNext() {
 DtlsTransport::DtlsTransport(MediaType med, const std::string &transport_name, const std::string& connection_id,
                             bool bundle, bool rtcp_mux, std::weak_ptr<TransportListener> transport_listener,
                             const IceConfig& iceConfig, std::string username, std::string password,
-                            bool isServer, std::shared_ptr<Worker> worker, std::shared_ptr<IOWorker> io_worker):
+                            bool isServer, std::shared_ptr<Worker> worker, std::shared_ptr<IOWorker> io_worker,
+                            std::shared_ptr<Worker> crypto_worker):
   Transport(med, transport_name, connection_id, bundle, rtcp_mux, transport_listener, iceConfig, worker, io_worker),
-  readyRtp(false), readyRtcp(false), isServer_(isServer) {
+  readyRtp(false), readyRtcp(false), dtls_started_(false), isServer_(isServer), crypto_worker_{crypto_worker} {
     ELOG_DEBUG("%s message: constructor, transportName: %s, isBundle: %d", toLog(), transport_name.c_str(), bundle);
     dtlsRtp.reset(new DtlsSocketContext());
 
@@ -107,7 +106,13 @@ DtlsTransport::DtlsTransport(MediaType med, const std::string &transport_name, c
     iceConfig_.ice_components = comps;
     iceConfig_.username = username;
     iceConfig_.password = password;
-    if (iceConfig_.use_nicer) {
+    if (iceConfig_.use_udp_mux && comps > 1) {
+      // The mux only demultiplexes one component, RTCP would never get through
+      ELOG_WARN("%s message: UdpMux needs rtcp-mux, falling back to a socket per component", toLog());
+    }
+    if (iceConfig_.use_udp_mux && comps == 1) {
+      ice_ = UdpMuxConnection::create(io_worker_, iceConfig_);
+    } else if (iceConfig_.use_nicer) {
       ice_ = NicerConnection::create(io_worker_, iceConfig_);
     } else {
       ice_.reset(LibNiceConnection::create(iceConfig_));
@@ -142,12 +147,16 @@ void DtlsTransport::close() {
     rtcp_timeout_checker_->cancel();
   }
   ice_->close();
-  if (dtlsRtp) {
-    dtlsRtp->close();
-  }
-  if (dtlsRtcp) {
-    dtlsRtcp->close();
-  }
+  std::shared_ptr<DtlsSocketContext> rtp_context = dtlsRtp;
+  std::shared_ptr<DtlsSocketContext> rtcp_context = dtlsRtcp;
+  crypto_worker_->task([rtp_context, rtcp_context]() {
+    if (rtp_context) {
+      rtp_context->close();
+    }
+    if (rtcp_context) {
+      rtcp_context->close();
+    }
+  });
   this->state_ = TRANSPORT_FINISHED;
   ELOG_DEBUG("%s message: closed", toLog());
 }
@@ -160,22 +169,20 @@ void DtlsTransport::onIceData(packetPtr packet) {
   char *data = packet->data;
   unsigned int component_id = packet->comp;
 
-  int length = len;
   SrtpChannel *srtp = srtp_.get();
   if (DtlsTransport::isDtlsPacket(data, len)) {
     ELOG_DEBUG("%s message: Received DTLS message, transportName: %s, componentId: %u",
                toLog(), transport_name.c_str(), component_id);
-    if (component_id == 1) {
-      std::lock_guard<std::mutex> guard(dtls_mutex);
-      dtlsRtp->read(reinterpret_cast<unsigned char*>(data), len);
-    } else {
-      std::lock_guard<std::mutex> guard(dtls_mutex);
-      dtlsRtcp->read(reinterpret_cast<unsigned char*>(data), len);
+    DtlsSocketContext *ctx = component_id == 1 ? dtlsRtp.get() : dtlsRtcp.get();
+    if (ctx == nullptr) {
+      return;
     }
+    cryptoTask([ctx, packet]() {
+      ctx->read(reinterpret_cast<unsigned char*>(packet->data), packet->length);
+    });
     return;
   } else if (this->getTransportState() == TRANSPORT_READY) {
-    PacketPtr unprotect_packet = std::make_shared<DataPacket>(component_id,
-      data, len, VIDEO_PACKET, packet->received_time_ms);
+    PacketPtr unprotect_packet = takePacketToUnprotect(std::move(packet));
 
     if (dtlsRtcp != NULL && component_id == 2) {
       srtp = srtcp_.get();
@@ -195,7 +202,7 @@ void DtlsTransport::onIceData(packetPtr packet) {
       return;
     }
 
-    if (length <= 0) {
+    if (unprotect_packet->length <= 0) {
       return;
     }
     if (auto listener = getTransportListener().lock()) {
@@ -204,49 +211,65 @@ void DtlsTransport::onIceData(packetPtr packet) {
   }
 }
 
+erizo::PacketPtr DtlsTransport::takePacketToUnprotect(PacketPtr packet) {
+  // Packets fresh from the ICE connection are only referenced here, so they are unprotected in place
+  if (packet.use_count() > 1) {
+    PacketPtr copy = std::make_shared<DataPacket>(packet->comp, packet->data, packet->length, VIDEO_PACKET,
+                                                  packet->received_time_ms);
+    copy->setReceivedTime(packet->received_time_us);
+    return copy;
+  }
+  packet->resetMetadata();
+  return packet;
+}
+
 void DtlsTransport::onCandidate(const CandidateInfo &candidate, IceConnection *conn) {
   if (auto listener = getTransportListener().lock()) {
     listener->onCandidate(candidate, this);
   }
 }
 
-void DtlsTransport::write(char* data, int len) {
+void DtlsTransport::write(PacketPtr packet) {
   if (ice_ == nullptr || !running_) {
     return;
   }
-  int length = len;
   SrtpChannel *srtp = srtp_.get();
 
   if (this->getTransportState() == TRANSPORT_READY) {
-    memcpy(protectBuf_, data, len);
+    bool is_rtcp = reinterpret_cast<RtcpHeader*>(packet->data)->isRtcp();
+    if (is_rtcp && dtlsRtcp != NULL) {
+      srtp = srtcp_.get();
+    }
+    if (srtp && packet->length > srtp->getMaxPlainLength(is_rtcp)) {
+      ELOG_WARN("%s message: Packet too big to be protected, length: %d", toLog(), packet->length);
+      return;
+    }
+    // Packets are protected in place, unless someone else (e.g. the retransmission buffer) still needs them in clear
+    if (packet.use_count() > 1) {
+      packet = std::make_shared<DataPacket>(*packet);
+    }
     int comp = 1;
-    RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(protectBuf_);
-    if (chead->isRtcp()) {
+    if (is_rtcp) {
       if (!rtcp_mux_) {
         comp = 2;
       }
-      if (dtlsRtcp != NULL) {
-        srtp = srtcp_.get();
-      }
       if (srtp && ice_->checkIceState() == IceState::READY) {
-        if (srtp->protectRtcp(protectBuf_, &length) < 0) {
+        if (srtp->protectRtcp(packet->data, &packet->length) < 0) {
           return;
         }
       }
     } else {
-      comp = 1;
-
       if (srtp && ice_->checkIceState() == IceState::READY) {
-        if (srtp->protectRtp(protectBuf_, &length) < 0) {
+        if (srtp->protectRtp(packet->data, &packet->length) < 0) {
           return;
         }
       }
     }
-    if (length <= 10) {
+    if (packet->length <= 10) {
       return;
     }
     if (ice_->checkIceState() == IceState::READY) {
-      writeOnIce(comp, protectBuf_, length);
+      writeOnIce(comp, std::move(packet));
     }
   }
 }
@@ -268,15 +291,29 @@ void DtlsTransport::onDtlsPacket(DtlsSocketContext *ctx, const unsigned char* da
 }
 
 void DtlsTransport::writeDtlsPacket(DtlsSocketContext *ctx, packetPtr packet) {
-  char data[1500];
-  unsigned int len = packet->length;
-  memcpy(data, packet->data, len);
-  writeOnIce(packet->comp, data, len);
+  writeOnIce(packet->comp, packet);
 }
 
 void DtlsTransport::onHandshakeCompleted(DtlsSocketContext *ctx, std::string clientKey, std::string serverKey,
                                          std::string srtp_profile) {
+  // Called from the crypto worker, only the keys go back to the connection worker
+  ELOG_INFO("%s message: DTLS handshake completed, transportName: %s, version: %s, durationMs: %lu, cpuUs: %lu",
+            toLog(), transport_name.c_str(), ctx->getVersion().c_str(), ctx->getHandshakeDurationMs(),
+            ctx->getHandshakeCpuUs());
+  std::weak_ptr<Transport> weak_transport = Transport::shared_from_this();
+  worker_->task([weak_transport, ctx, clientKey, serverKey, srtp_profile, this]() {
+    if (auto transport = weak_transport.lock()) {
+      onHandshakeCompletedSync(ctx, clientKey, serverKey, srtp_profile);
+    }
+  });
+}
+
+void DtlsTransport::onHandshakeCompletedSync(DtlsSocketContext *ctx, std::string clientKey, std::string serverKey,
+                                             std::string srtp_profile) {
   boost::mutex::scoped_lock lock(sessionMutex_);
+  if (!running_) {
+    return;
+  }
   std::string temp;
 
   if (rtp_timeout_checker_) {
@@ -292,7 +329,7 @@ void DtlsTransport::onHandshakeCompleted(DtlsSocketContext *ctx, std::string cli
   }
   if (ctx == dtlsRtp.get()) {
     srtp_.reset(new SrtpChannel());
-    if (srtp_->setRtpParams(clientKey, serverKey)) {
+    if (srtp_->setRtpParams(clientKey, serverKey, srtp_profile)) {
       readyRtp = true;
     } else {
       updateTransportState(TRANSPORT_FAILED);
@@ -303,20 +340,29 @@ void DtlsTransport::onHandshakeCompleted(DtlsSocketContext *ctx, std::string cli
   }
   if (ctx == dtlsRtcp.get()) {
     srtcp_.reset(new SrtpChannel());
-    if (srtcp_->setRtpParams(clientKey, serverKey)) {
+    if (srtcp_->setRtpParams(clientKey, serverKey, srtp_profile)) {
       readyRtcp = true;
     } else {
       updateTransportState(TRANSPORT_FAILED);
     }
   }
-  ELOG_DEBUG("%s message:HandShakeCompleted, transportName:%s, readyRtp:%d, readyRtcp:%d",
-             toLog(), transport_name.c_str(), readyRtp, readyRtcp);
+  ELOG_DEBUG("%s message:HandShakeCompleted, transportName:%s, readyRtp:%d, readyRtcp:%d, srtpProfile: %s",
+             toLog(), transport_name.c_str(), readyRtp, readyRtcp, srtp_profile.c_str());
   if (readyRtp && readyRtcp) {
     updateTransportState(TRANSPORT_READY);
   }
 }
 
 void DtlsTransport::onHandshakeFailed(DtlsSocketContext *ctx, const std::string& error) {
+  std::weak_ptr<Transport> weak_transport = Transport::shared_from_this();
+  worker_->task([weak_transport, ctx, error, this]() {
+    if (auto transport = weak_transport.lock()) {
+      onHandshakeFailedSync(ctx, error);
+    }
+  });
+}
+
+void DtlsTransport::onHandshakeFailedSync(DtlsSocketContext *ctx, const std::string& error) {
   ELOG_WARN("%s message: Handshake failed, transportName:%s, openSSLerror: %s",
             toLog(), transport_name.c_str(), error.c_str());
   running_ = false;
@@ -350,24 +396,47 @@ void DtlsTransport::updateIceStateSync(IceState state, IceConnection *conn) {
     ELOG_DEBUG("%s message: Ice Failed", toLog());
     running_ = false;
     updateTransportState(TRANSPORT_FAILED);
-  } else if (state == IceState::READY) {
-    if (!isServer_ && dtlsRtp && !dtlsRtp->started) {
-      ELOG_INFO("%s message: DTLSRTP Start, transportName: %s", toLog(), transport_name.c_str());
-      dtlsRtp->start();
-      rtp_timeout_checker_->scheduleCheck();
-    }
-    if (!isServer_ && dtlsRtcp != NULL && !dtlsRtcp->started) {
+  } else if (state == IceState::READY && !isServer_ && !dtls_started_) {
+    dtls_started_ = true;
+    ELOG_INFO("%s message: DTLSRTP Start, transportName: %s", toLog(), transport_name.c_str());
+    DtlsSocketContext *rtp_context = dtlsRtp.get();
+    DtlsSocketContext *rtcp_context = dtlsRtcp.get();
+    cryptoTask([rtp_context, rtcp_context]() {
+      rtp_context->start();
+      if (rtcp_context) {
+        rtcp_context->start();
+      }
+    });
+    rtp_timeout_checker_->scheduleCheck();
+    if (rtcp_timeout_checker_) {
       ELOG_DEBUG("%s message: DTLSRTCP Start, transportName: %s", toLog(), transport_name.c_str());
-      dtlsRtcp->start();
       rtcp_timeout_checker_->scheduleCheck();
     }
   }
 }
 
+void DtlsTransport::handleDtlsTimeout(DtlsSocketContext *ctx) {
+  cryptoTask([ctx]() {
+    ctx->handleTimeout();
+  });
+}
+
+void DtlsTransport::cryptoTask(std::function<void()> f) {
+  std::weak_ptr<Transport> weak_transport = Transport::shared_from_this();
+  crypto_worker_->task([weak_transport, f, this]() {
+    if (auto transport = weak_transport.lock()) {
+      if (running_) {
+        f();
+      }
+    }
+  });
+}
+
 void DtlsTransport::processLocalSdp(SdpInfo *localSdp_) {
   ELOG_DEBUG("%s message: processing local sdp, transportName: %s", toLog(), transport_name.c_str());
   localSdp_->isFingerprint = true;
   localSdp_->fingerprint = getMyFingerprint();
+  localSdp_->isIceLite = ice_->isIceLite();
   std::string username(ice_->getLocalUsername());
   std::string password(ice_->getLocalPassword());
   if (bundle_) {
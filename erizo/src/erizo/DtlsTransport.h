@@ -7,6 +7,8 @@
 #include <boost/asio.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/shared_ptr.hpp>
+#include <functional>
+#include <memory>
 #include <string>
 #include "dtls/DtlsSocket.h"
 #include "./IceConnection.h"
@@ -23,34 +25,47 @@ class DtlsTransport : dtls::DtlsReceiver, public Transport {
   DtlsTransport(MediaType med, const std::string& transport_name, const std::string& connection_id, bool bundle,
                 bool rtcp_mux, std::weak_ptr<TransportListener> transport_listener, const IceConfig& iceConfig,
                 std::string username, std::string password, bool isServer, std::shared_ptr<Worker> worker,
-                std::shared_ptr<IOWorker> io_worker);
+                std::shared_ptr<IOWorker> io_worker, std::shared_ptr<Worker> crypto_worker);
   virtual ~DtlsTransport();
   void connectionStateChanged(IceState newState);
   std::string getMyFingerprint() const;
   static bool isDtlsPacket(const char* buf, int len);
+  // Returns a packet with the same data that can be unprotected in place, copying it only when it is shared
+  static PacketPtr takePacketToUnprotect(PacketPtr packet);
   void start() override;
   void close() override;
   void onIceData(packetPtr packet) override;
   void onCandidate(const CandidateInfo &candidate, IceConnection *conn) override;
-  void write(char* data, int len) override;
+  void write(PacketPtr packet) override;
   void onDtlsPacket(dtls::DtlsSocketContext *ctx, const unsigned char* data, unsigned int len) override;
   void writeDtlsPacket(dtls::DtlsSocketContext *ctx, packetPtr packet);
   void onHandshakeCompleted(dtls::DtlsSocketContext *ctx, std::string clientKey, std::string serverKey,
                             std::string srtp_profile) override;
   void onHandshakeFailed(dtls::DtlsSocketContext *ctx, const std::string& error) override;
+  void onHandshakeCompletedSync(dtls::DtlsSocketContext *ctx, std::string clientKey, std::string serverKey,
+                                std::string srtp_profile);
+  void onHandshakeFailedSync(dtls::DtlsSocketContext *ctx, const std::string& error);
   void updateIceState(IceState state, IceConnection *conn) override;
   void processLocalSdp(SdpInfo *localSdp_) override;
 
   void updateIceStateSync(IceState state, IceConnection *conn);
+  void handleDtlsTimeout(dtls::DtlsSocketContext *ctx);
 
  private:
-  char protectBuf_[5000];
-  boost::scoped_ptr<dtls::DtlsSocketContext> dtlsRtp, dtlsRtcp;
+  // Every DtlsSocketContext call happens in the crypto worker
+  void cryptoTask(std::function<void()> f);
+
+ private:
+  // Shared with the crypto worker, which closes them after any handshake step still queued
+  std::shared_ptr<dtls::DtlsSocketContext> dtlsRtp, dtlsRtcp;
   boost::mutex writeMutex_, sessionMutex_;
   boost::scoped_ptr<SrtpChannel> srtp_, srtcp_;
   bool readyRtp, readyRtcp;
+  bool dtls_started_;
   bool isServer_;
   std::unique_ptr<TimeoutChecker> rtcp_timeout_checker_, rtp_timeout_checker_;
+  // Where DTLS packets are read, so handshakes never delay the media of the connection worker
+  std::shared_ptr<Worker> crypto_worker_;
   packetPtr p_;
 };
 
@@ -16,6 +16,7 @@
 #include "./SdpInfo.h"
 #include "./logger.h"
 #include "lib/LibNiceInterface.h"
+#include "stats/SocketStats.h"
 
 typedef struct _NiceAgent NiceAgent;
 typedef struct _GMainContext GMainContext;
@@ -52,6 +53,7 @@ class IceConfig {
     uint16_t stun_port, turn_port, min_port, max_port;
     bool should_trickle;
     bool use_nicer;
+    bool use_udp_mux;
     IceConfig()
       : media_type{MediaType::OTHER},
         transport_name{""},
@@ -69,7 +71,8 @@ class IceConfig {
         min_port{0},
         max_port{0},
         should_trickle{false},
-        use_nicer{false} {
+        use_nicer{false},
+        use_udp_mux{false} {
     }
 };
 
@@ -99,11 +102,23 @@ class IceConnection : public LogContext {
   virtual bool setRemoteCandidates(const std::vector<CandidateInfo> &candidates, bool is_bundle) = 0;
   virtual void setRemoteCredentials(const std::string& username, const std::string& password) = 0;
   virtual int sendData(unsigned int component_id, const void* buf, int len) = 0;
+  /**
+   * Sends a packet the caller is done with. Connections that send from another thread keep a reference to it
+   * until the send completes instead of copying it.
+   */
+  virtual int sendPacket(unsigned int component_id, PacketPtr packet) {
+    return sendData(component_id, packet->data, packet->length);
+  }
 
   virtual void onData(unsigned int component_id, char* buf, int len) = 0;
   virtual CandidatePair getSelectedPair() = 0;
   virtual void setReceivedLastCandidate(bool hasReceived) = 0;
   virtual void close() = 0;
+  virtual bool isIceLite() { return false; }
+  /**
+   * Not available unless the connection owns or shares a socket that erizo can query
+   */
+  virtual SocketStats getSocketStats() { return SocketStats(); }
 
   virtual void updateIceState(IceState state);
   virtual IceState checkIceState();
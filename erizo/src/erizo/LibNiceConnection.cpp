@@ -119,7 +119,7 @@ void LibNiceConnection::onData(unsigned int component_id, char* buf, int len) {
     memcpy(packet->data, buf, len);
     packet->comp = component_id;
     packet->length = len;
-    packet->received_time_ms = ClockUtils::timePointToMs(clock::now());
+    packet->setReceivedTime(ClockUtils::timePointToUs(clock::now()));
     if (auto listener = getIceListener().lock()) {
       listener->onPacketReceived(packet);
     }
@@ -5,6 +5,7 @@
 #define ERIZO_SRC_ERIZO_MEDIADEFINITIONS_H_
 
 #include <boost/thread/mutex.hpp>
+#include <map>
 #include <vector>
 #include <algorithm>
 
@@ -19,25 +20,49 @@ enum packetType {
     OTHER_PACKET
 };
 
+// What a packet carries, handlers use them to say which packets they want to see (see Handler::read_packets)
+constexpr uint8_t kNoPackets = 0;
+constexpr uint8_t kRtpAudioPackets = 1 << 0;
+constexpr uint8_t kRtpVideoPackets = 1 << 1;
+constexpr uint8_t kRtcpFeedbackPackets = 1 << 2;
+constexpr uint8_t kRtcpReportPackets = 1 << 3;
+constexpr uint8_t kAllPackets = 0xff;
+
+// What changed when a pipeline notifies its handlers, handlers use them to say which changes they want to hear
+// about (see Handler::notified_updates). A pipeline tells all of them once it is finalized.
+constexpr uint8_t kNoUpdates = 0;
+constexpr uint8_t kBandwidthUpdate = 1 << 0;         // max video bandwidth
+constexpr uint8_t kMuteUpdate = 1 << 1;              // audio or video muted
+constexpr uint8_t kLayerConstraintsUpdate = 1 << 2;  // slideshow, padding and quality layers
+constexpr uint8_t kSdpUpdate = 1 << 3;               // remote SDP, with its SSRCs and extensions
+constexpr uint8_t kAllUpdates = 0xff;
+
 struct DataPacket {
   DataPacket() = default;
 
   DataPacket(int comp_, const char *data_, int length_, packetType type_, uint64_t received_time_ms_) :
     comp{comp_}, length{length_}, type{type_}, received_time_ms{received_time_ms_}, is_keyframe{false},
-    ending_of_layer_frame{false}, picture_id{-1}, tl0_pic_idx{-1} {
+    ending_of_layer_frame{false}, picture_id{-1}, tl0_pic_idx{-1}, received_time_us{received_time_ms_ * 1000} {
       memcpy(data, data_, length_);
   }
 
   DataPacket(int comp_, const char *data_, int length_, packetType type_) :
-    comp{comp_}, length{length_}, type{type_}, received_time_ms{ClockUtils::timePointToMs(clock::now())},
-    is_keyframe{false}, ending_of_layer_frame{false}, picture_id{-1}, tl0_pic_idx{-1} {
+    comp{comp_}, length{length_}, type{type_}, is_keyframe{false}, ending_of_layer_frame{false}, picture_id{-1},
+    tl0_pic_idx{-1} {
       memcpy(data, data_, length_);
+      setReceivedTime(ClockUtils::timePointToUs(clock::now()));
   }
 
   DataPacket(int comp_, const unsigned char *data_, int length_) :
-    comp{comp_}, length{length_}, type{VIDEO_PACKET}, received_time_ms{ClockUtils::timePointToMs(clock::now())},
-    is_keyframe{false}, ending_of_layer_frame{false}, picture_id{-1}, tl0_pic_idx{-1} {
+    comp{comp_}, length{length_}, type{VIDEO_PACKET}, is_keyframe{false}, ending_of_layer_frame{false},
+    picture_id{-1}, tl0_pic_idx{-1} {
       memcpy(data, data_, length_);
+      setReceivedTime(ClockUtils::timePointToUs(clock::now()));
+  }
+
+  void setReceivedTime(uint64_t time_us) {
+    received_time_us = time_us;
+    received_time_ms = time_us / 1000;
   }
 
   bool belongsToSpatialLayer(int spatial_layer_) {
@@ -56,6 +81,20 @@ struct DataPacket {
     return item != compatible_temporal_layers.end();
   }
 
+  // Leaves only the received data and times, so the packet can be reused for another one
+  void resetMetadata() {
+    type = VIDEO_PACKET;
+    compatible_spatial_layers.clear();
+    compatible_temporal_layers.clear();
+    is_keyframe = false;
+    ending_of_layer_frame = false;
+    picture_id = -1;
+    tl0_pic_idx = -1;
+    codec.clear();
+    clock_rate = 0;
+    source_packet.reset();
+  }
+
   int comp;
   char data[1500];
   int length;
@@ -69,8 +108,20 @@ struct DataPacket {
   int tl0_pic_idx;
   std::string codec;
   unsigned int clock_rate = 0;
+  // Same clock as received_time_ms, taken by the kernel when the socket supports it
+  uint64_t received_time_us = 0;
+  // The packet of the publisher this one was copied from, shared by all its subscribers. Their retransmission
+  // buffers keep it instead of their own copy when they only rewrote its first bytes, see PacketBufferService.
+  std::shared_ptr<DataPacket> source_packet;
 };
 using PacketPtr = std::shared_ptr<DataPacket>;
+// Packets of one stream that are handled together, in order
+using PacketBatch = std::vector<PacketPtr>;
+
+// SRTP appends at most the 16 byte tag of the AEAD profiles to RTP packets, so packets that handlers make bigger
+// (like RTX ones) must not go over this length or they are dropped when protecting them
+constexpr int kMaxSrtpRtpTrailerLength = 16;
+constexpr int kMaxPlainRtpPacketLength = sizeof(DataPacket::data) - kMaxSrtpRtpTrailerLength;
 
 class Monitor {
  protected:
@@ -117,6 +168,8 @@ class MediaSink: public virtual Monitor {
     // SSRCs received by the SINK
     uint32_t audio_sink_ssrc_;
     uint32_t video_sink_ssrc_;
+    // Retransmissions of the video are sent on it, 0 if there is none
+    uint32_t video_sink_rtx_ssrc_;
     // Is it able to provide Feedback
     FeedbackSource* sink_fb_source_;
 
@@ -135,6 +188,14 @@ class MediaSink: public virtual Monitor {
         boost::mutex::scoped_lock lock(monitor_mutex_);
         video_sink_ssrc_ = ssrc;
     }
+    uint32_t getVideoSinkRtxSSRC() {
+        boost::mutex::scoped_lock lock(monitor_mutex_);
+        return video_sink_rtx_ssrc_;
+    }
+    void setVideoSinkRtxSSRC(uint32_t ssrc) {
+        boost::mutex::scoped_lock lock(monitor_mutex_);
+        video_sink_rtx_ssrc_ = ssrc;
+    }
     uint32_t getAudioSinkSSRC() {
         boost::mutex::scoped_lock lock(monitor_mutex_);
         return audio_sink_ssrc_;
@@ -156,7 +217,7 @@ class MediaSink: public virtual Monitor {
     int deliverEvent(MediaEventPtr event) {
       return this->deliverEvent_(event);
     }
-    MediaSink() : audio_sink_ssrc_{0}, video_sink_ssrc_{0}, sink_fb_source_{nullptr} {}
+    MediaSink() : audio_sink_ssrc_{0}, video_sink_ssrc_{0}, video_sink_rtx_ssrc_{0}, sink_fb_source_{nullptr} {}
     virtual ~MediaSink() {}
 
     virtual void close() = 0;
@@ -175,6 +236,8 @@ class MediaSource: public virtual Monitor {
     // SSRCs coming from the source
     uint32_t audio_source_ssrc_;
     std::vector<uint32_t> video_source_ssrc_list_;
+    // The video SSRC (value) retransmitted on each RTX SSRC (key)
+    std::map<uint32_t, uint32_t> video_source_rtx_ssrc_map_;
     MediaSink* video_sink_;
     MediaSink* audio_sink_;
     MediaSink* event_sink_;
@@ -223,6 +286,23 @@ class MediaSource: public virtual Monitor {
         boost::mutex::scoped_lock lock(monitor_mutex_);
         video_source_ssrc_list_ = new_ssrc_list;
     }
+    uint32_t getVideoSourceRtxSSRC(uint32_t ssrc) {
+        boost::mutex::scoped_lock lock(monitor_mutex_);
+        for (const auto &rtx_ssrc : video_source_rtx_ssrc_map_) {
+          if (rtx_ssrc.second == ssrc) {
+            return rtx_ssrc.first;
+          }
+        }
+        return 0;
+    }
+    // With the RTX SSRC (value) of each video SSRC (key), as SdpInfo has them
+    void setVideoSourceRtxSSRCMap(const std::map<uint32_t, uint32_t>& new_rtx_ssrc_map) {
+        boost::mutex::scoped_lock lock(monitor_mutex_);
+        video_source_rtx_ssrc_map_.clear();
+        for (const auto &rtx_ssrc : new_rtx_ssrc_map) {
+          video_source_rtx_ssrc_map_[rtx_ssrc.second] = rtx_ssrc.first;
+        }
+    }
     uint32_t getAudioSourceSSRC() {
         boost::mutex::scoped_lock lock(monitor_mutex_);
         return audio_source_ssrc_;
@@ -244,6 +324,16 @@ class MediaSource: public virtual Monitor {
       return audio_source_ssrc_ == ssrc;
     }
 
+    // The video SSRC retransmitted on the given RTX SSRC, 0 if it is not one
+    uint32_t getVideoSSRCOfRtxSSRC(uint32_t ssrc) {
+      boost::mutex::scoped_lock lock(monitor_mutex_);
+      if (video_source_rtx_ssrc_map_.empty()) {
+        return 0;
+      }
+      auto found_ssrc = video_source_rtx_ssrc_map_.find(ssrc);
+      return found_ssrc == video_source_rtx_ssrc_map_.end() ? 0 : found_ssrc->second;
+    }
+
     MediaSource() : audio_source_ssrc_{0}, video_source_ssrc_list_{std::vector<uint32_t>(1, 0)},
       video_sink_{nullptr}, audio_sink_{nullptr}, event_sink_{nullptr}, source_fb_sink_{nullptr} {}
     virtual ~MediaSource() {}
@@ -14,6 +14,7 @@
 
 #include "./MediaStream.h"
 #include "./SdpInfo.h"
+#include "./SrtpChannel.h"
 #include"./WebRtcConnection.h"
 #include "rtp/RtpHeaders.h"
 #include "rtp/RtpVP8Parser.h"
@@ -38,6 +39,7 @@
 #include "rtp/RtpPaddingGeneratorHandler.h"
 #include "rtp/RtpUtils.h"
 #include "rtp/PacketCodecParser.h"
+#include "pipeline/StaticPipeline.h"
 
 namespace erizo {
 DEFINE_LOGGER(MediaStream, "MediaStream");
@@ -45,6 +47,118 @@ log4cxx::LoggerPtr MediaStream::statsLogger = log4cxx::Logger::getLogger("Stream
 
 static constexpr auto kStreamStatsPeriod = std::chrono::seconds(30);
 
+// The chains MediaStream uses, from the transport (PacketWriter) to the stream (PacketReader), one per role. They are
+// composed at compile time so packets go from one handler to the next with direct calls, see StaticPipeline.
+// A publisher only writes RTCP to its client, so it leaves out the handlers that only work on the video a subscriber
+// is sent. A subscriber only reads RTCP from its client, so it leaves out the layer detection of incoming video.
+// Every handler of the chosen chain is still built with the pipeline, once the remote SDP is set, whether it ends up
+// enabled or not. What roles share is the chain type, not handler instances.
+typedef StaticPipeline<PacketWriter,
+                       PacketCodecParser,
+                       OutgoingStatsHandler,
+                       LayerDetectorHandler,
+                       SenderBandwidthEstimationHandler,
+                       SRPacketHandler,
+                       RtpRetransmissionHandler,
+                       RtcpFeedbackGenerationHandler,
+                       RtpPaddingRemovalHandler,
+                       BandwidthEstimationHandler,
+                       PliPacerHandler,
+                       RtpSlideShowHandler,
+                       RtpTrackMuteHandler,
+                       IncomingStatsHandler,
+                       QualityFilterHandler,
+                       RtcpProcessorHandler,
+                       PacketReader> PublisherPipeline;
+
+typedef StaticPipeline<PacketWriter,
+                       PacketCodecParser,
+                       OutgoingStatsHandler,
+                       SenderBandwidthEstimationHandler,
+                       SRPacketHandler,
+                       RtpRetransmissionHandler,
+                       RtcpFeedbackGenerationHandler,
+                       RtpPaddingRemovalHandler,
+                       BandwidthEstimationHandler,
+                       PliPacerHandler,
+                       RtpPaddingGeneratorHandler,
+                       RtpSlideShowHandler,
+                       RtpTrackMuteHandler,
+                       IncomingStatsHandler,
+                       QualityFilterHandler,
+                       LayerBitrateCalculationHandler,
+                       FecReceiverHandler,
+                       RtcpProcessorHandler,
+                       PacketReader> SubscriberPipeline;
+
+// Streams without video, in either role, only keep what audio needs: RTCP, round trip time, NACK retransmissions,
+// mute and stats
+typedef StaticPipeline<PacketWriter,
+                       PacketCodecParser,
+                       OutgoingStatsHandler,
+                       SenderBandwidthEstimationHandler,
+                       SRPacketHandler,
+                       RtpRetransmissionHandler,
+                       RtcpFeedbackGenerationHandler,
+                       RtpTrackMuteHandler,
+                       IncomingStatsHandler,
+                       RtcpProcessorHandler,
+                       PacketReader> AudioOnlyPipeline;
+
+static Pipeline::Ptr createPipeline(MediaStream *media_stream, bool is_publisher, bool audio_only) {
+  if (audio_only) {
+    return AudioOnlyPipeline::create(std::make_shared<PacketWriter>(media_stream),
+                                     std::make_shared<PacketCodecParser>(),
+                                     std::make_shared<OutgoingStatsHandler>(),
+                                     std::make_shared<SenderBandwidthEstimationHandler>(),
+                                     std::make_shared<SRPacketHandler>(),
+                                     std::make_shared<RtpRetransmissionHandler>(),
+                                     std::make_shared<RtcpFeedbackGenerationHandler>(),
+                                     std::make_shared<RtpTrackMuteHandler>(),
+                                     std::make_shared<IncomingStatsHandler>(),
+                                     std::make_shared<RtcpProcessorHandler>(),
+                                     std::make_shared<PacketReader>(media_stream));
+  }
+  if (is_publisher) {
+    return PublisherPipeline::create(std::make_shared<PacketWriter>(media_stream),
+                                     std::make_shared<PacketCodecParser>(),
+                                     std::make_shared<OutgoingStatsHandler>(),
+                                     std::make_shared<LayerDetectorHandler>(),
+                                     std::make_shared<SenderBandwidthEstimationHandler>(),
+                                     std::make_shared<SRPacketHandler>(),
+                                     std::make_shared<RtpRetransmissionHandler>(),
+                                     std::make_shared<RtcpFeedbackGenerationHandler>(),
+                                     std::make_shared<RtpPaddingRemovalHandler>(),
+                                     std::make_shared<BandwidthEstimationHandler>(),
+                                     std::make_shared<PliPacerHandler>(),
+                                     std::make_shared<RtpSlideShowHandler>(),
+                                     std::make_shared<RtpTrackMuteHandler>(),
+                                     std::make_shared<IncomingStatsHandler>(),
+                                     std::make_shared<QualityFilterHandler>(),
+                                     std::make_shared<RtcpProcessorHandler>(),
+                                     std::make_shared<PacketReader>(media_stream));
+  }
+  return SubscriberPipeline::create(std::make_shared<PacketWriter>(media_stream),
+                                    std::make_shared<PacketCodecParser>(),
+                                    std::make_shared<OutgoingStatsHandler>(),
+                                    std::make_shared<SenderBandwidthEstimationHandler>(),
+                                    std::make_shared<SRPacketHandler>(),
+                                    std::make_shared<RtpRetransmissionHandler>(),
+                                    std::make_shared<RtcpFeedbackGenerationHandler>(),
+                                    std::make_shared<RtpPaddingRemovalHandler>(),
+                                    std::make_shared<BandwidthEstimationHandler>(),
+                                    std::make_shared<PliPacerHandler>(),
+                                    std::make_shared<RtpPaddingGeneratorHandler>(),
+                                    std::make_shared<RtpSlideShowHandler>(),
+                                    std::make_shared<RtpTrackMuteHandler>(),
+                                    std::make_shared<IncomingStatsHandler>(),
+                                    std::make_shared<QualityFilterHandler>(),
+                                    std::make_shared<LayerBitrateCalculationHandler>(),
+                                    std::make_shared<FecReceiverHandler>(),
+                                    std::make_shared<RtcpProcessorHandler>(),
+                                    std::make_shared<PacketReader>(media_stream));
+}
+
 MediaStream::MediaStream(std::shared_ptr<Worker> worker,
   std::shared_ptr<WebRtcConnection> connection,
   const std::string& media_stream_id,
@@ -55,11 +169,11 @@ MediaStream::MediaStream(std::shared_ptr<Worker> worker,
     stream_id_{media_stream_id},
     mslabel_ {media_stream_label},
     bundle_{false},
-    pipeline_{Pipeline::create()},
     worker_{std::move(worker)},
     audio_muted_{false}, video_muted_{false},
     pipeline_initialized_{false},
-    is_publisher_{is_publisher} {
+    is_publisher_{is_publisher},
+    audio_only_{false} {
   setVideoSinkSSRC(kDefaultVideoSinkSSRC);
   setAudioSinkSSRC(kDefaultAudioSinkSSRC);
   ELOG_INFO("%s message: constructor, id: %s",
@@ -69,7 +183,6 @@ MediaStream::MediaStream(std::shared_ptr<Worker> worker,
   stats_ = std::make_shared<Stats>();
   log_stats_ = std::make_shared<Stats>();
   quality_manager_ = std::make_shared<QualityManager>();
-  packet_buffer_ = std::make_shared<PacketBufferService>();
   std::srand(std::time(nullptr));
   audio_sink_ssrc_ = std::rand();
   video_sink_ssrc_ = std::rand();
@@ -100,7 +213,7 @@ void MediaStream::setMaxVideoBW(uint32_t max_video_bw) {
     if (stream->rtcp_processor_) {
       stream->rtcp_processor_->setMaxVideoBW(max_video_bw * 1000);
       if (stream->pipeline_) {
-        stream->pipeline_->notifyUpdate();
+        stream->pipeline_->notifyUpdate(kBandwidthUpdate);
       }
     }
   });
@@ -115,9 +228,7 @@ void MediaStream::syncClose() {
   video_sink_ = nullptr;
   audio_sink_ = nullptr;
   fb_sink_ = nullptr;
-  pipeline_initialized_ = false;
-  pipeline_->close();
-  pipeline_.reset();
+  closePipeline();
   connection_.reset();
   ELOG_DEBUG("%s message: Close ended", toLog());
 }
@@ -134,13 +245,17 @@ bool MediaStream::init() {
 }
 
 bool MediaStream::isSourceSSRC(uint32_t ssrc) {
-  return isVideoSourceSSRC(ssrc) || isAudioSourceSSRC(ssrc);
+  return isVideoSourceSSRC(ssrc) || isAudioSourceSSRC(ssrc) || getVideoSSRCOfRtxSSRC(ssrc) != 0;
 }
 
 bool MediaStream::isSinkSSRC(uint32_t ssrc) {
   return isVideoSinkSSRC(ssrc) || isAudioSinkSSRC(ssrc);
 }
 
+bool MediaStream::isRtxSSRC(uint32_t ssrc) {
+  return ssrc != 0 && (ssrc == getVideoSinkRtxSSRC() || getVideoSSRCOfRtxSSRC(ssrc) != 0);
+}
+
 bool MediaStream::setRemoteSdp(std::shared_ptr<SdpInfo> sdp) {
   ELOG_DEBUG("%s message: setting remote SDP", toLog());
   if (!sending_) {
@@ -153,17 +268,28 @@ bool MediaStream::setRemoteSdp(std::shared_ptr<SdpInfo> sdp) {
   }
 
   if (pipeline_initialized_ && pipeline_) {
-    pipeline_->notifyUpdate();
-    return true;
+    bool audio_only = remote_sdp_->hasAudio && !remote_sdp_->hasVideo;
+    if (audio_only == audio_only_) {
+      pipeline_->notifyUpdate(kSdpUpdate | kBandwidthUpdate);
+      return true;
+    }
+    // The pipeline was picked for the media of the first remote SDP, so it is built again for the new one
+    ELOG_INFO("%s message: Media changed in the remote SDP, rebuilding the pipeline, audioOnly: %d",
+              toLog(), audio_only);
+    closePipeline();
   }
 
-
   bundle_ = remote_sdp_->isBundle;
   auto video_ssrc_list_it = remote_sdp_->video_ssrc_map.find(getLabel());
   if (video_ssrc_list_it != remote_sdp_->video_ssrc_map.end()) {
     setVideoSourceSSRCList(video_ssrc_list_it->second);
   }
 
+  auto video_rtx_ssrc_map_it = remote_sdp_->video_rtx_ssrc_map.find(getLabel());
+  if (video_rtx_ssrc_map_it != remote_sdp_->video_rtx_ssrc_map.end()) {
+    setVideoSourceRtxSSRCMap(video_rtx_ssrc_map_it->second);
+  }
+
   auto audio_ssrc_it = remote_sdp_->audio_ssrc_map.find(getLabel());
   if (audio_ssrc_it != remote_sdp_->audio_ssrc_map.end()) {
     setAudioSourceSSRC(audio_ssrc_it->second);
@@ -182,6 +308,7 @@ bool MediaStream::setRemoteSdp(std::shared_ptr<SdpInfo> sdp) {
 
   audio_enabled_ = remote_sdp_->hasAudio;
   video_enabled_ = remote_sdp_->hasVideo;
+  audio_only_ = audio_enabled_ && !video_enabled_;
 
   rtcp_processor_->addSourceSsrc(getAudioSourceSSRC());
   std::for_each(video_source_ssrc_list_.begin(), video_source_ssrc_list_.end(), [this] (uint32_t new_ssrc){
@@ -329,54 +456,79 @@ void MediaStream::printStats() {
   transferMediaStats("rtxBitrate", "total", "rtxBitrate");
   transferMediaStats("bwe", "total", "senderBitrateEstimation");
 
+  flushHandlerStats();
+
   ELOG_INFOT(statsLogger, "%s", log_stats_->getStats());
 }
 
 void MediaStream::initializePipeline() {
+  // The remote SDP tells whether there is any video, which picks the handlers, see createPipeline
+  pipeline_ = createPipeline(this, is_publisher_, audio_only_);
   handler_manager_ = std::make_shared<HandlerManager>(shared_from_this());
+  packet_buffer_ = std::make_shared<PacketBufferService>(!audio_only_);
   pipeline_->addService(shared_from_this());
   pipeline_->addService(handler_manager_);
   pipeline_->addService(rtcp_processor_);
   pipeline_->addService(stats_);
-  pipeline_->addService(quality_manager_);
+  if (!audio_only_) {
+    pipeline_->addService(quality_manager_);
+  }
   pipeline_->addService(packet_buffer_);
 
-  pipeline_->addFront(std::make_shared<PacketReader>(this));
-
-  pipeline_->addFront(std::make_shared<RtcpProcessorHandler>());
-  pipeline_->addFront(std::make_shared<FecReceiverHandler>());
-  pipeline_->addFront(std::make_shared<LayerBitrateCalculationHandler>());
-  pipeline_->addFront(std::make_shared<QualityFilterHandler>());
-  pipeline_->addFront(std::make_shared<IncomingStatsHandler>());
-  pipeline_->addFront(std::make_shared<RtpTrackMuteHandler>());
-  pipeline_->addFront(std::make_shared<RtpSlideShowHandler>());
-  pipeline_->addFront(std::make_shared<RtpPaddingGeneratorHandler>());
-  pipeline_->addFront(std::make_shared<PliPacerHandler>());
-  pipeline_->addFront(std::make_shared<BandwidthEstimationHandler>());
-  pipeline_->addFront(std::make_shared<RtpPaddingRemovalHandler>());
-  pipeline_->addFront(std::make_shared<RtcpFeedbackGenerationHandler>());
-  pipeline_->addFront(std::make_shared<RtpRetransmissionHandler>());
-  pipeline_->addFront(std::make_shared<SRPacketHandler>());
-  pipeline_->addFront(std::make_shared<SenderBandwidthEstimationHandler>());
-  pipeline_->addFront(std::make_shared<LayerDetectorHandler>());
-  pipeline_->addFront(std::make_shared<OutgoingStatsHandler>());
-  pipeline_->addFront(std::make_shared<PacketCodecParser>());
-
-  pipeline_->addFront(std::make_shared<PacketWriter>(this));
   pipeline_->finalize();
+  for (const auto &handler_state : requested_handler_states_) {
+    if (handler_state.second) {
+      pipeline_->enable(handler_state.first);
+    } else {
+      pipeline_->disable(handler_state.first);
+    }
+  }
+  if (audio_only_) {
+    ELOG_DEBUG("%s message: Audio only stream, using the audio pipeline", toLog());
+  }
+  if (worker_->isHandlerStatsEnabled()) {
+    pipeline_->enableHandlerStats();
+  }
   pipeline_initialized_ = true;
 }
 
+void MediaStream::closePipeline() {
+  pipeline_initialized_ = false;
+  flushHandlerStats();
+  flushed_handler_stats_.clear();
+  if (pipeline_) {
+    pipeline_->close();
+    pipeline_.reset();
+  }
+}
+
+void MediaStream::flushHandlerStats() {
+  if (!worker_->isHandlerStatsEnabled() || !pipeline_) {
+    return;
+  }
+  HandlerStatsMap stats = pipeline_->getHandlerStats();
+  HandlerStatsMap new_stats = stats;
+  for (auto &handler_stats : new_stats) {
+    handler_stats.second.subtract(flushed_handler_stats_[handler_stats.first]);
+  }
+  worker_->addHandlerStats(new_stats);
+  flushed_handler_stats_ = stats;
+}
+
 int MediaStream::deliverAudioData_(PacketPtr audio_packet) {
   if (audio_enabled_) {
-    sendPacketAsync(std::make_shared<DataPacket>(*audio_packet));
+    PacketPtr packet = std::make_shared<DataPacket>(*audio_packet);
+    packet->source_packet = audio_packet;
+    sendPacketAsync(std::move(packet));
   }
   return audio_packet->length;
 }
 
 int MediaStream::deliverVideoData_(PacketPtr video_packet) {
   if (video_enabled_) {
-    sendPacketAsync(std::make_shared<DataPacket>(*video_packet));
+    PacketPtr packet = std::make_shared<DataPacket>(*video_packet);
+    packet->source_packet = video_packet;
+    sendPacketAsync(std::move(packet));
   }
   return video_packet->length;
 }
@@ -420,42 +572,80 @@ int MediaStream::deliverEvent_(MediaEventPtr event) {
   return 1;
 }
 
-void MediaStream::onTransportData(PacketPtr incoming_packet, Transport *transport) {
+void MediaStream::onTransportData(PacketPtr packet, Transport *transport) {
   if ((audio_sink_ == nullptr && video_sink_ == nullptr && fb_sink_ == nullptr)) {
     return;
   }
 
-  PacketPtr packet = std::make_shared<DataPacket>(*incoming_packet);
-
   if (transport->mediaType == AUDIO_TYPE) {
     packet->type = AUDIO_PACKET;
   } else if (transport->mediaType == VIDEO_TYPE) {
     packet->type = VIDEO_PACKET;
   }
+  bool was_empty;
+  {
+    boost::mutex::scoped_lock lock(pending_reads_mutex_);
+    was_empty = pending_reads_.empty();
+    pending_reads_.push_back(std::move(packet));
+  }
+  if (!was_empty) {
+    return;
+  }
   auto stream_ptr = shared_from_this();
+  worker_->task([stream_ptr] {
+    stream_ptr->readPendingPackets();
+  });
+}
 
-  worker_->task([stream_ptr, packet]{
-    if (!stream_ptr->pipeline_initialized_) {
-      ELOG_DEBUG("%s message: Pipeline not initialized yet.", stream_ptr->toLog());
-      return;
-    }
+void MediaStream::readPendingPackets() {
+  PacketBatch packets;
+  {
+    boost::mutex::scoped_lock lock(pending_reads_mutex_);
+    packets.swap(pending_reads_);
+  }
+  if (!pipeline_initialized_) {
+    ELOG_DEBUG("%s message: Pipeline not initialized yet.", toLog());
+    return;
+  }
 
+  bool dropped_packets = false;
+  BandwidthEstimationHandler *bandwidth_estimator = nullptr;
+  for (PacketPtr &packet : packets) {
     char* buf = packet->data;
     RtpHeader *head = reinterpret_cast<RtpHeader*> (buf);
     RtcpHeader *chead = reinterpret_cast<RtcpHeader*> (buf);
     if (!chead->isRtcp()) {
       uint32_t recvSSRC = head->getSSRC();
-      if (stream_ptr->isVideoSourceSSRC(recvSSRC)) {
+      if (isVideoSourceSSRC(recvSSRC)) {
         packet->type = VIDEO_PACKET;
-      } else if (stream_ptr->isAudioSourceSSRC(recvSSRC)) {
+      } else if (isAudioSourceSSRC(recvSSRC)) {
         packet->type = AUDIO_PACKET;
+      } else if (uint32_t video_ssrc = getVideoSSRCOfRtxSSRC(recvSSRC)) {
+        // Handlers only know the original packets, so retransmissions are turned back into them
+        unsigned int payload_type = remote_sdp_->getVideoAssociatedPT(head->getPayloadType());
+        packet->type = VIDEO_PACKET;
+        if (payload_type == 0 || !RtpUtils::unwrapRtxPacket(packet, video_ssrc, payload_type)) {
+          // Padding-only ones are bandwidth probes, their transport-wide sequence numbers still have to be reported
+          if (!bandwidth_estimator && pipeline_) {
+            bandwidth_estimator = pipeline_->getHandler<BandwidthEstimationHandler>();
+          }
+          if (bandwidth_estimator) {
+            bandwidth_estimator->readProbe(packet);
+          }
+          packet.reset();
+          dropped_packets = true;
+          continue;
+        }
       }
     }
+  }
+  if (dropped_packets) {
+    packets.erase(std::remove(packets.begin(), packets.end(), nullptr), packets.end());
+  }
 
-    if (stream_ptr->pipeline_) {
-      stream_ptr->pipeline_->read(std::move(packet));
-    }
-  });
+  if (pipeline_) {
+    pipeline_->readBatch(std::move(packets));
+  }
 }
 
 void MediaStream::read(PacketPtr packet) {
@@ -565,8 +755,17 @@ void MediaStream::sendPacketAsync(PacketPtr packet) {
   }
 
   changeDeliverPayloadType(packet.get(), packet->type);
-  worker_->task([stream_ptr, packet]{
-    stream_ptr->sendPacket(packet);
+  bool was_empty;
+  {
+    boost::mutex::scoped_lock lock(pending_writes_mutex_);
+    was_empty = pending_writes_.empty();
+    pending_writes_.push_back(std::move(packet));
+  }
+  if (!was_empty) {
+    return;
+  }
+  worker_->task([stream_ptr] {
+    stream_ptr->sendPendingPackets();
   });
 }
 
@@ -581,7 +780,7 @@ void MediaStream::setSlideShowMode(bool state) {
        CumulativeStat{state});
   });
   slide_show_mode_ = state;
-  notifyUpdateToHandlers();
+  notifyUpdateToHandlers(kLayerConstraintsUpdate);
 }
 
 void MediaStream::muteStream(bool mute_video, bool mute_audio) {
@@ -594,7 +793,7 @@ void MediaStream::muteStream(bool mute_video, bool mute_audio) {
     media_stream->stats_->getNode()[media_stream->getAudioSinkSSRC()].insertStat("erizoVideoMute",
                                                                              CumulativeStat{mute_video});
     if (media_stream && media_stream->pipeline_) {
-      media_stream->pipeline_->notifyUpdate();
+      media_stream->pipeline_->notifyUpdate(kMuteUpdate);
     }
   });
 }
@@ -656,6 +855,20 @@ WebRTCEvent MediaStream::getCurrentState() {
 
 void MediaStream::getJSONStats(std::function<void(std::string)> callback) {
   asyncTask([callback] (std::shared_ptr<MediaStream> stream) {
+    // syncClose resets the connection, stats may still be asked for while or after the stream closes
+    std::shared_ptr<WebRtcConnection> connection = stream->connection_;
+    if (connection) {
+      SocketStats socket_stats = connection->getSocketStats();
+      if (socket_stats.available) {
+        socket_stats.fillNode(stream->stats_->getNode()["socket"]);
+      }
+    }
+    if (stream->pipeline_ && stream->worker_->isHandlerStatsEnabled()) {
+      fillHandlerStatsNode(stream->pipeline_->getHandlerStats(), stream->stats_->getNode()["handlers"]);
+    }
+    StatNode &srtp_node = stream->stats_->getNode()["srtp"];
+    srtp_node.insertStat("library", StringStat{SrtpChannel::getLibraryVersion()});
+    srtp_node.insertStat("aeadSupported", CumulativeStat{SrtpChannel::isAeadSupported()});
     std::string requested_stats = stream->stats_->getStats();
     //  ELOG_DEBUG("%s message: Stats, stats: %s", stream->toLog(), requested_stats.c_str());
     callback(requested_stats);
@@ -701,30 +914,38 @@ void MediaStream::parseIncomingPayloadType(char *buf, int len, packetType type)
 
 void MediaStream::write(PacketPtr packet) {
   if (connection_) {
-    connection_->write(packet);
+    connection_->write(std::move(packet));
   }
 }
 
 void MediaStream::enableHandler(const std::string &name) {
   asyncTask([name] (std::shared_ptr<MediaStream> conn) {
-      if (conn && conn->pipeline_) {
-        conn->pipeline_->enable(name);
-      }
+    if (!conn) {
+      return;
+    }
+    conn->requested_handler_states_[name] = true;
+    if (conn->pipeline_) {
+      conn->pipeline_->enable(name);
+    }
   });
 }
 
 void MediaStream::disableHandler(const std::string &name) {
   asyncTask([name] (std::shared_ptr<MediaStream> conn) {
-    if (conn && conn->pipeline_) {
+    if (!conn) {
+      return;
+    }
+    conn->requested_handler_states_[name] = false;
+    if (conn->pipeline_) {
       conn->pipeline_->disable(name);
     }
   });
 }
 
-void MediaStream::notifyUpdateToHandlers() {
-  asyncTask([] (std::shared_ptr<MediaStream> conn) {
+void MediaStream::notifyUpdateToHandlers(uint8_t updates) {
+  asyncTask([updates] (std::shared_ptr<MediaStream> conn) {
     if (conn && conn->pipeline_) {
-      conn->pipeline_->notifyUpdate();
+      conn->pipeline_->notifyUpdate(updates);
     }
   });
 }
@@ -739,9 +960,42 @@ void MediaStream::asyncTask(std::function<void(std::shared_ptr<MediaStream>)> f)
 }
 
 void MediaStream::sendPacket(PacketPtr p) {
+  if (!sending_ || exceedsRateControl(p)) {
+    return;
+  }
+  if (!pipeline_initialized_) {
+    ELOG_DEBUG("%s message: Pipeline not initialized yet.", toLog());
+    return;
+  }
+
+  if (pipeline_) {
+    pipeline_->write(std::move(p));
+  }
+}
+
+void MediaStream::sendPendingPackets() {
+  PacketBatch packets;
+  {
+    boost::mutex::scoped_lock lock(pending_writes_mutex_);
+    packets.swap(pending_writes_);
+  }
   if (!sending_) {
     return;
   }
+  packets.erase(std::remove_if(packets.begin(), packets.end(), [this](const PacketPtr &packet) {
+    return exceedsRateControl(packet);
+  }), packets.end());
+  if (!pipeline_initialized_) {
+    ELOG_DEBUG("%s message: Pipeline not initialized yet.", toLog());
+    return;
+  }
+
+  if (pipeline_) {
+    pipeline_->writeBatch(std::move(packets));
+  }
+}
+
+bool MediaStream::exceedsRateControl(const PacketPtr &p) {
   uint32_t partial_bitrate = 0;
   uint64_t sentVideoBytes = 0;
   uint64_t lastSecondVideoBytes = 0;
@@ -749,7 +1003,7 @@ void MediaStream::sendPacket(PacketPtr p) {
   if (rate_control_ && !slide_show_mode_) {
     if (p->type == VIDEO_PACKET) {
       if (rate_control_ == 1) {
-        return;
+        return true;
       }
       now_ = clock::now();
       if ((now_ - mark_) >= kBitrateControlPeriod) {
@@ -758,19 +1012,12 @@ void MediaStream::sendPacket(PacketPtr p) {
       }
       partial_bitrate = ((sentVideoBytes - lastSecondVideoBytes) * 8) * 10;
       if (partial_bitrate > this->rate_control_) {
-        return;
+        return true;
       }
       sentVideoBytes += p->length;
     }
   }
-  if (!pipeline_initialized_) {
-    ELOG_DEBUG("%s message: Pipeline not initialized yet.", toLog());
-    return;
-  }
-
-  if (pipeline_) {
-    pipeline_->write(std::move(p));
-  }
+  return false;
 }
 
 void MediaStream::setQualityLayer(int spatial_layer, int temporal_layer) {
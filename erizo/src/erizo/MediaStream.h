@@ -120,7 +120,7 @@ class MediaStream: public MediaSink, public MediaSource, public FeedbackSink,
 
   void enableHandler(const std::string &name);
   void disableHandler(const std::string &name);
-  void notifyUpdateToHandlers() override;
+  void notifyUpdateToHandlers(uint8_t updates) override;
 
   void notifyToEventSink(MediaEventPtr event);
 
@@ -144,12 +144,15 @@ class MediaStream: public MediaSink, public MediaSource, public FeedbackSink,
 
   bool isSourceSSRC(uint32_t ssrc);
   bool isSinkSSRC(uint32_t ssrc);
+  // Whether the SSRC is the RTX stream of a video source or sink, it only carries retransmissions
+  bool isRtxSSRC(uint32_t ssrc);
   void parseIncomingPayloadType(char *buf, int len, packetType type);
 
   bool isPipelineInitialized() { return pipeline_initialized_; }
   bool isRunning() { return pipeline_initialized_ && sending_; }
   Pipeline::Ptr getPipeline() { return pipeline_; }
   bool isPublisher() { return is_publisher_; }
+  bool isAudioOnly() { return audio_only_; }
 
   inline std::string toLog() {
     return "id: " + stream_id_ + ", role:" + (is_publisher_ ? "publisher" : "subscriber") + ", " + printLogContext();
@@ -157,11 +160,17 @@ class MediaStream: public MediaSink, public MediaSource, public FeedbackSink,
 
  private:
   void sendPacket(PacketPtr packet);
+  // Run on the worker, they take everything queued meanwhile through the pipeline as one batch
+  void readPendingPackets();
+  void sendPendingPackets();
+  bool exceedsRateControl(const PacketPtr &packet);
   int deliverAudioData_(PacketPtr audio_packet) override;
   int deliverVideoData_(PacketPtr video_packet) override;
   int deliverFeedback_(PacketPtr fb_packet) override;
   int deliverEvent_(MediaEventPtr event) override;
   void initializePipeline();
+  void closePipeline();
+  void flushHandlerStats();
   void transferLayerStats(std::string spatial, std::string temporal);
   void transferMediaStats(std::string target_node, std::string source_parent, std::string source_node);
 
@@ -170,6 +179,11 @@ class MediaStream: public MediaSink, public MediaSource, public FeedbackSink,
 
  private:
   boost::mutex event_listener_mutex_;
+  // Packets waiting for the worker. A task is posted only by the one that finds them empty
+  boost::mutex pending_reads_mutex_;
+  PacketBatch pending_reads_;
+  boost::mutex pending_writes_mutex_;
+  PacketBatch pending_writes_;
   MediaStreamEventListener* media_stream_event_listener_;
   std::shared_ptr<WebRtcConnection> connection_;
   std::string stream_id_;
@@ -193,6 +207,10 @@ class MediaStream: public MediaSink, public MediaSource, public FeedbackSink,
   std::shared_ptr<HandlerManager> handler_manager_;
 
   Pipeline::Ptr pipeline_;
+  // Handlers enabled (true) or disabled (false) by name, applied again to every pipeline the stream builds
+  std::map<std::string, bool> requested_handler_states_;
+  // Handler stats already added to the worker ones
+  HandlerStatsMap flushed_handler_stats_;
 
   std::shared_ptr<Worker> worker_;
 
@@ -202,6 +220,8 @@ class MediaStream: public MediaSink, public MediaSource, public FeedbackSink,
   bool pipeline_initialized_;
 
   bool is_publisher_;
+  // Negotiated without video, it gets the lighter audio pipeline
+  bool audio_only_;
  protected:
   std::shared_ptr<SdpInfo> remote_sdp_;
   std::shared_ptr<SdpInfo> local_sdp_;
@@ -209,6 +229,8 @@ class MediaStream: public MediaSink, public MediaSource, public FeedbackSink,
 
 class PacketReader : public InboundHandler {
  public:
+  static const uint8_t notified_updates = kNoUpdates;
+
   explicit PacketReader(MediaStream *media_stream) : media_stream_{media_stream} {}
 
   void enable() override {}
@@ -231,6 +253,8 @@ class PacketReader : public InboundHandler {
 
 class PacketWriter : public OutboundHandler {
  public:
+  static const uint8_t notified_updates = kNoUpdates;
+
   explicit PacketWriter(MediaStream *media_stream) : media_stream_{media_stream} {}
 
   void enable() override {}
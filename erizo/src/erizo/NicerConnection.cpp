@@ -478,6 +478,14 @@ int NicerConnection::sendData(unsigned int component_id, const void* buf, int le
   packetPtr packet (new DataPacket());
   memcpy(packet->data, buf, len);
   packet->length = len;
+  return sendPacket(component_id, packet);
+}
+
+int NicerConnection::sendPacket(unsigned int component_id, PacketPtr packet) {
+  if (checkIceState() != IceState::READY) {
+    return -1;
+  }
+  int len = packet->length;
   nr_ice_peer_ctx *peer = peer_;
   nr_ice_media_stream *stream = stream_;
   std::shared_ptr<NicerInterface> nicer = nicer_;
@@ -579,7 +587,7 @@ void NicerConnection::onData(unsigned int component_id, char* buf, int len) {
     memcpy(packet->data, buf, len);
     packet->comp = component_id;
     packet->length = len;
-    packet->received_time_ms = ClockUtils::timePointToMs(clock::now());
+    packet->setReceivedTime(ClockUtils::timePointToUs(clock::now()));
     if (auto listener = getIceListener().lock()) {
       listener->onPacketReceived(packet);
     }
@@ -53,6 +53,7 @@ class NicerConnection : public IceConnection, public std::enable_shared_from_thi
   void onCandidate(nr_ice_media_stream *stream, int component_id, nr_ice_candidate *candidate);
   void setRemoteCredentials(const std::string& username, const std::string& password) override;
   int sendData(unsigned int component_id, const void* buf, int len) override;
+  int sendPacket(unsigned int component_id, PacketPtr packet) override;
 
   void onData(unsigned int component_id, char* buf, int len) override;
   CandidatePair getSelectedPair() override;
@@ -94,6 +94,8 @@ namespace erizo {
     ELOG_DEBUG("From %u, %u ", publisher->getAudioSourceSSRC(), publisher->getVideoSourceSSRC());
     subscriber_stream->setAudioSinkSSRC(this->publisher->getAudioSourceSSRC());
     subscriber_stream->setVideoSinkSSRC(this->publisher->getVideoSourceSSRC());
+    subscriber_stream->setVideoSinkRtxSSRC(this->publisher->getVideoSourceRtxSSRC(
+        this->publisher->getVideoSourceSSRC()));
     ELOG_DEBUG("Subscribers ssrcs: Audio %u, video, %u from %u, %u ",
                subscriber_stream->getAudioSinkSSRC(), subscriber_stream->getVideoSinkSSRC(),
                this->publisher->getAudioSourceSSRC() , this->publisher->getVideoSourceSSRC());
@@ -53,6 +53,7 @@ namespace erizo {
     isBundle = false;
     isRtcpMux = false;
     isFingerprint = false;
+    isIceLite = false;
     dtlsRole = ACTPASS;
     hasAudio = false;
     hasVideo = false;
@@ -169,6 +170,9 @@ namespace erizo {
     sdp << "v=0\n" << "o=- 0 0 IN IP4 127.0.0.1\n";
     sdp << "s=" << SDP_IDENTIFIER << "\n";
     sdp << "t=0 0\n";
+    if (isIceLite) {
+      sdp << "a=ice-lite\n";
+    }
 
     if (isBundle) {
       sdp << "a=group:BUNDLE";
@@ -509,6 +513,8 @@ namespace erizo {
     this->audioSdpMLine = offerSdp->audioSdpMLine;
     this->inOutPTMap = offerSdp->inOutPTMap;
     this->outInPTMap = offerSdp->outInPTMap;
+    this->rtxPTMap = offerSdp->rtxPTMap;
+    this->aptPTMap = offerSdp->aptPTMap;
     this->hasVideo = offerSdp->hasVideo;
     this->hasAudio = offerSdp->hasAudio;
     this->bundleTags = offerSdp->bundleTags;
@@ -963,7 +969,7 @@ namespace erizo {
         if (internal_map.encoding_name == "rtx") {
             auto parsed_apt = rtx_map.format_parameters.find(kAssociatedPt);
             auto internal_apt = internal_map.format_parameters.find(kAssociatedPt);
-            if (parsed_apt == rtx_map.format_parameters.end() &&
+            if (parsed_apt == rtx_map.format_parameters.end() ||
                 internal_apt == internal_map.format_parameters.end()) {
               continue;
             }
@@ -981,6 +987,8 @@ namespace erizo {
               }
               outInPTMap[rtx_map.payload_type] = internal_map.payload_type;
               inOutPTMap[internal_map.payload_type] = rtx_map.payload_type;
+              rtxPTMap[parsed_apt_pt] = rtx_map.payload_type;
+              aptPTMap[rtx_map.payload_type] = parsed_apt_pt;
               payloadVector.push_back(rtx_map);
             }
         }
@@ -1045,6 +1053,22 @@ namespace erizo {
     return getAudioExternalPT(internalPT);
   }
 
+  unsigned int SdpInfo::getVideoRtxPT(unsigned int externalPT) {
+    std::map<unsigned int, unsigned int>::iterator found = rtxPTMap.find(externalPT);
+    if (found != rtxPTMap.end()) {
+      return found->second;
+    }
+    return 0;
+  }
+
+  unsigned int SdpInfo::getVideoAssociatedPT(unsigned int externalPT) {
+    std::map<unsigned int, unsigned int>::iterator found = aptPTMap.find(externalPT);
+    if (found != aptPTMap.end()) {
+      return found->second;
+    }
+    return 0;
+  }
+
   bool SdpInfo::processCandidate(const std::vector<std::string>& pieces, MediaType mediaType, std::string line) {
     CandidateInfo cand;
     static const char* types_str[] = { "host", "srflx", "prflx", "relay" };
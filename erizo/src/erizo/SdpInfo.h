@@ -222,6 +222,18 @@ class SdpInfo {
    * @return The external video payload type
    */
   unsigned int getVideoExternalPT(unsigned int internalPT);
+  /**
+   * @brief map an external payload type to the one of its RTX retransmissions
+   * @param externalPT The payload type of the retransmitted packets as provided to this source
+   * @return The external RTX payload type, 0 if RTX was not negotiated for it
+   */
+  unsigned int getVideoRtxPT(unsigned int externalPT);
+  /**
+   * @brief map an external RTX payload type to the one of the packets it retransmits
+   * @param externalPT The RTX payload type as coming from this source
+   * @return The external payload type of the original packets, 0 if it is not an RTX one
+   */
+  unsigned int getVideoAssociatedPT(unsigned int externalPT);
 
   RtpMap* getCodecByExternalPayloadType(const unsigned int payload_type);
 
@@ -259,6 +271,7 @@ class SdpInfo {
    */
   std::map<std::string, unsigned int> audio_ssrc_map;
   std::map<std::string, std::vector<uint32_t>> video_ssrc_map;
+  // The RTX SSRC (value) of each video SSRC (key) that has one, as in their ssrc-group:FID
   std::map<std::string, std::map<uint32_t, uint32_t>> video_rtx_ssrc_map;
   /**
   * Is it Bundle
@@ -287,6 +300,10 @@ class SdpInfo {
   */
   bool isFingerprint;
   /**
+  * Is this an ICE-lite agent
+  */
+  bool isIceLite;
+  /**
   * DTLS Fingerprint
   */
   std::string fingerprint;
@@ -302,6 +319,14 @@ class SdpInfo {
   * Mapping from external PT (key) to intermal PT (value)
   */
   std::map<unsigned int, unsigned int> outInPTMap;
+  /**
+  * Mapping from external PT (key) to the external PT of its RTX retransmissions (value)
+  */
+  std::map<unsigned int, unsigned int> rtxPTMap;
+  /**
+  * Mapping from external RTX PT (key) to the external PT it retransmits (value)
+  */
+  std::map<unsigned int, unsigned int> aptPTMap;
   /**
    * The negotiated payload list
    */
@@ -8,11 +8,16 @@
 #include <string>
 
 #include "SrtpChannel.h"
+#include "./MediaDefinitions.h"
 
 namespace erizo {
 DEFINE_LOGGER(SrtpChannel, "SrtpChannel");
 bool SrtpChannel::initialized = false;
+int SrtpChannel::aead_supported = -1;
+const char *SrtpChannel::library_version = "";
 boost::mutex SrtpChannel::sessionMutex_;
+constexpr const char* SrtpChannel::kDefaultProfile;
+constexpr int SrtpChannel::kSrtcpIndexLength;
 
 constexpr int kKeyStringLength = 32;
 
@@ -31,24 +36,22 @@ std::string octet_string_hex_string(const void *s, int length) {
   const uint8_t *str = (const uint8_t*)s;
   int i = 0;
 
-  char bit_string[kKeyStringLength * 2];
+  char bit_string[kKeyStringLength];
 
-  for (i = 0; i < kKeyStringLength * 2; i += 2) {
+  for (i = 0; i < kKeyStringLength; i += 2) {
       bit_string[i]   = nibble_to_hex_char(*str >> 4);
       bit_string[i + 1] = nibble_to_hex_char(*str++ & 0xF);
   }
-  return std::string(bit_string);
+  return std::string(bit_string, kKeyStringLength);
 }
 
 SrtpChannel::SrtpChannel() {
-  boost::mutex::scoped_lock lock(SrtpChannel::sessionMutex_);
-  if (SrtpChannel::initialized != true) {
-    int res = srtp_init();
-    ELOG_DEBUG("Initialized SRTP library %d", res);
-    SrtpChannel::initialized = true;
-  }
+  initialize();
 
   active_ = false;
+  profile_ = kDefaultProfile;
+  rtp_trailer_length_ = 0;
+  rtcp_trailer_length_ = 0;
   send_session_ = NULL;
   receive_session_ = NULL;
 }
@@ -65,8 +68,75 @@ SrtpChannel::~SrtpChannel() {
   }
 }
 
-bool SrtpChannel::setRtpParams(const std::string &sendingKey, const std::string &receivingKey) {
-  ELOG_DEBUG("Configuring srtp local key %s remote key %s", sendingKey.c_str(), receivingKey.c_str());
+void SrtpChannel::initialize() {
+  boost::mutex::scoped_lock lock(SrtpChannel::sessionMutex_);
+  if (SrtpChannel::initialized != true) {
+    int res = srtp_init();
+    ELOG_DEBUG("Initialized SRTP library %d", res);
+    SrtpChannel::initialized = true;
+
+    aead_supported = probeAead();
+    library_version = srtp_get_version_string();
+    ELOG_INFO("message: SRTP crypto, library: %s, aeadSupported: %d", library_version, aead_supported);
+  }
+}
+
+bool SrtpChannel::probeAead() {
+  // libsrtp only registers the GCM ciphers when it has a crypto backend, so creating a session tells
+  srtp_policy_t policy;
+  memset(&policy, 0, sizeof(policy));
+  int master_key_length = 0;
+  setPolicyFromProfile(&policy, "SRTP_AEAD_AES_128_GCM", &master_key_length);
+  uint8_t key[SRTP_MAX_KEY_LEN];
+  memset(key, 0, sizeof(key));
+  policy.ssrc.type = ssrc_any_outbound;
+  policy.key = key;
+  srtp_t session = NULL;
+  bool supported = srtp_create(&session, &policy) == srtp_err_status_ok;
+  if (session != NULL) {
+    srtp_dealloc(session);
+  }
+  return supported;
+}
+
+bool SrtpChannel::isAeadSupported() {
+  initialize();
+  return aead_supported;
+}
+
+std::string SrtpChannel::getLibraryVersion() {
+  initialize();
+  return library_version;
+}
+
+bool SrtpChannel::setPolicyFromProfile(srtp_policy_t *policy, const std::string &profile, int *master_key_length) {
+  srtp_profile_t srtp_profile;
+  if (profile == "SRTP_AES128_CM_SHA1_80") {
+    srtp_profile = srtp_profile_aes128_cm_sha1_80;
+  } else if (profile == "SRTP_AES128_CM_SHA1_32") {
+    srtp_profile = srtp_profile_aes128_cm_sha1_32;
+  } else if (profile == "SRTP_AEAD_AES_128_GCM") {
+    srtp_profile = srtp_profile_aead_aes_128_gcm;
+  } else if (profile == "SRTP_AEAD_AES_256_GCM") {
+    srtp_profile = srtp_profile_aead_aes_256_gcm;
+  } else {
+    return false;
+  }
+  // SRTCP keeps the 80 bit tag with SHA1_32 (RFC 5764 section 4.1.2), libsrtp takes care of it
+  if (srtp_crypto_policy_set_from_profile_for_rtp(&policy->rtp, srtp_profile) != srtp_err_status_ok ||
+      srtp_crypto_policy_set_from_profile_for_rtcp(&policy->rtcp, srtp_profile) != srtp_err_status_ok) {
+    return false;
+  }
+  *master_key_length = srtp_profile_get_master_key_length(srtp_profile) +
+                       srtp_profile_get_master_salt_length(srtp_profile);
+  return true;
+}
+
+bool SrtpChannel::setRtpParams(const std::string &sendingKey, const std::string &receivingKey,
+                               const std::string &profile) {
+  ELOG_DEBUG("Configuring srtp local key %s remote key %s profile %s", sendingKey.c_str(), receivingKey.c_str(),
+             profile.c_str());
+  profile_ = profile;
   if (configureSrtpSession(&send_session_,    sendingKey,   SENDING) &&
       configureSrtpSession(&receive_session_, receivingKey, RECEIVING)) {
     active_ = true;
@@ -79,6 +149,10 @@ bool SrtpChannel::setRtcpParams(const std::string &sendingKey, const std::string
     return 0;
 }
 
+int SrtpChannel::getMaxPlainLength(bool rtcp) {
+  return static_cast<int>(sizeof(DataPacket::data)) - (rtcp ? rtcp_trailer_length_ : rtp_trailer_length_);
+}
+
 int SrtpChannel::protectRtp(char* buffer, int *len) {
   if (!active_) {
     return -1;
@@ -150,8 +224,13 @@ int SrtpChannel::unprotectRtcp(char* buffer, int *len) {
 bool SrtpChannel::configureSrtpSession(srtp_t *session, const std::string &key, enum TransmissionType type) {
   srtp_policy_t policy;
   memset(&policy, 0, sizeof(policy));
-  srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtp);
-  srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtcp);
+  int master_key_length = 0;
+  if (!setPolicyFromProfile(&policy, profile_, &master_key_length)) {
+    ELOG_ERROR("Unsupported SRTP profile %s", profile_.c_str());
+    return false;
+  }
+  rtp_trailer_length_ = policy.rtp.auth_tag_len;
+  rtcp_trailer_length_ = policy.rtcp.auth_tag_len + kSrtcpIndexLength;
   if (type == SENDING) {
     policy.ssrc.type = ssrc_any_outbound;
   } else {
@@ -166,6 +245,12 @@ bool SrtpChannel::configureSrtpSession(srtp_t *session, const std::string &key,
 
   gsize len = 0;
   uint8_t *akey = reinterpret_cast<uint8_t*>(g_base64_decode(reinterpret_cast<const gchar*>(key.c_str()), &len));
+  if (len != static_cast<gsize>(master_key_length)) {
+    ELOG_ERROR("Wrong master key length for SRTP profile %s, expected: %d, got: %lu", profile_.c_str(),
+               master_key_length, len);
+    g_free(akey);
+    return false;
+  }
   ELOG_DEBUG("set master key/salt to %s/", octet_string_hex_string(akey, 16).c_str());
   // allocate and initialize the SRTP session
   policy.key = akey;
@@ -23,6 +23,8 @@ namespace erizo {
 class SrtpChannel {
   DECLARE_LOGGER();
   static bool initialized;
+  static int aead_supported;
+  static const char *library_version;
   static boost::mutex sessionMutex_;
 
  public:
@@ -63,9 +65,11 @@ class SrtpChannel {
    * Sets a key pair for the RTP channel
    * @param sendingKey The key for protecting data
    * @param receivingKey The key for unprotecting data
+   * @param profile The DTLS-SRTP profile the keys were negotiated for, as named by OpenSSL
    * @return true if everything is ok
    */
-  bool setRtpParams(const std::string &sendingKey, const std::string &receivingKey);
+  bool setRtpParams(const std::string &sendingKey, const std::string &receivingKey,
+                    const std::string &profile = kDefaultProfile);
   /**
    * Sets a key pair for the RTCP channel
    * @param sendingKey The key for protecting data
@@ -73,15 +77,40 @@ class SrtpChannel {
    * @return true if everything is ok
    */
   bool setRtcpParams(const std::string &sendingKey, const std::string &receivingKey);
+  /**
+   * The longest packet that still fits in a DataPacket once protected with the negotiated profile
+   * @param rtcp Whether it is a RTCP packet, they also carry the SRTCP index
+   * @return The max length in bytes
+   */
+  int getMaxPlainLength(bool rtcp);
+
+  /**
+   * Whether libsrtp was built with AES-GCM, it needs a crypto backend such as OpenSSL for it
+   */
+  static bool isAeadSupported();
+  /**
+   * The libsrtp version string, logged once when the library is initialized
+   */
+  static std::string getLibraryVersion();
+
+  static constexpr const char* kDefaultProfile = "SRTP_AES128_CM_SHA1_80";
+  static constexpr int kSrtcpIndexLength = 4;
 
  private:
   enum TransmissionType {
     SENDING, RECEIVING
   };
 
+  static void initialize();
+  static bool probeAead();
+  static bool setPolicyFromProfile(srtp_policy_t *policy, const std::string &profile, int *master_key_length);
   bool configureSrtpSession(srtp_t *session, const std::string &key, enum TransmissionType type);
 
   bool active_;
+  std::string profile_;
+  // Authentication tag plus, for RTCP, the SRTCP index. We never use a MKI
+  int rtp_trailer_length_;
+  int rtcp_trailer_length_;
   srtp_t send_session_;
   srtp_t receive_session_;
 };
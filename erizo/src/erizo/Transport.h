@@ -1,6 +1,7 @@
 #ifndef ERIZO_SRC_ERIZO_TRANSPORT_H_
 #define ERIZO_SRC_ERIZO_TRANSPORT_H_
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <cstdio>
@@ -41,7 +42,7 @@ class Transport : public std::enable_shared_from_this<Transport>, public IceConn
   virtual void updateIceState(IceState state, IceConnection *conn) = 0;
   virtual void onIceData(packetPtr packet) = 0;
   virtual void onCandidate(const CandidateInfo &candidate, IceConnection *conn) = 0;
-  virtual void write(char* data, int len) = 0;
+  virtual void write(PacketPtr packet) = 0;
   virtual void processLocalSdp(SdpInfo *localSdp_) = 0;
   virtual void start() = 0;
   virtual void close() = 0;
@@ -64,11 +65,11 @@ class Transport : public std::enable_shared_from_this<Transport>, public IceConn
       listener->updateState(state, this);
     }
   }
-  void writeOnIce(int comp, void* buf, int len) {
+  void writeOnIce(int comp, PacketPtr packet) {
     if (!running_) {
       return;
     }
-    ice_->sendData(comp, buf, len);
+    ice_->sendPacket(comp, std::move(packet));
   }
   bool setRemoteCandidates(const std::vector<CandidateInfo> &candidates, bool isBundle) {
     return ice_->setRemoteCandidates(candidates, isBundle);
@@ -76,15 +77,15 @@ class Transport : public std::enable_shared_from_this<Transport>, public IceConn
 
   void onPacketReceived(packetPtr packet) {
     std::weak_ptr<Transport> weak_transport = Transport::shared_from_this();
-    worker_->task([weak_transport, packet]() {
+    worker_->task([weak_transport, packet]() mutable {
       if (auto this_ptr = weak_transport.lock()) {
-        if (packet->length > 0) {
-          this_ptr->onIceData(packet);
-        }
         if (packet->length == -1) {
           this_ptr->running_ = false;
           return;
         }
+        if (packet->length > 0) {
+          this_ptr->onIceData(std::move(packet));
+        }
       }
     });
   }
@@ -107,7 +108,8 @@ class Transport : public std::enable_shared_from_this<Transport>, public IceConn
   TransportState state_;
   IceConfig iceConfig_;
   bool bundle_;
-  bool running_;
+  // Read from the IO and crypto workers while the worker closes the transport
+  std::atomic<bool> running_;
   std::shared_ptr<Worker> worker_;
   std::shared_ptr<IOWorker> io_worker_;
 };
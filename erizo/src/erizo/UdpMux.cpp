@@ -0,0 +1,637 @@
+/*
+ * UdpMux.cpp
+ */
+
+#include "./UdpMux.h"
+
+extern "C" {
+#include <async_wait.h>
+}
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <ifaddrs.h>
+#include <linux/sock_diag.h>
+#include <net/if.h>
+#include <netinet/udp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "lib/ClockUtils.h"
+#include "lib/StunMessage.h"
+
+namespace erizo {
+
+DEFINE_LOGGER(UdpMux, "UdpMux");
+
+static constexpr int kMaxReadsPerWakeup = 64;
+static constexpr size_t kMaxPendingPackets = 256;
+// Kernel limits for a single UDP_SEGMENT send
+static constexpr size_t kMaxGsoSegments = 64;
+static constexpr int kMaxGsoBytes = 65000;
+static constexpr int kMaxGroBufferSize = 65535;
+// Socket buffers are sized to hold this much of the observed traffic, within the limits below
+static constexpr uint64_t kBufferedTrafficMs = 200;
+static constexpr uint64_t kMinSocketBufferSize = 256 * 1024;
+static constexpr uint64_t kMaxSocketBufferSize = 16 * 1024 * 1024;
+static constexpr uint64_t kBufferTuningIntervalUs = 1000000;
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
+std::string UdpMuxAddress::getIp() const {
+  char str[INET_ADDRSTRLEN];
+  inet_ntop(AF_INET, &addr.sin_addr, str, INET_ADDRSTRLEN);
+  return std::string(str);
+}
+
+int UdpMuxAddress::getPort() const {
+  return ntohs(addr.sin_port);
+}
+
+std::string UdpMuxAddress::toString() const {
+  return getIp() + ":" + std::to_string(getPort());
+}
+
+UdpMuxSteeringTable::UdpMuxSteeringTable() : routes_{std::make_shared<const Routes>()} {
+}
+
+std::shared_ptr<const UdpMuxSteeringTable::Routes> UdpMuxSteeringTable::getRoutes() const {
+  return std::atomic_load(&routes_);
+}
+
+void UdpMuxSteeringTable::updateRoutes(std::function<void(Routes*)> update) {
+  std::lock_guard<std::mutex> guard(write_mutex_);
+  auto routes = std::make_shared<Routes>(*getRoutes());
+  update(routes.get());
+  std::atomic_store(&routes_, std::shared_ptr<const Routes>(routes));
+}
+
+void UdpMuxSteeringTable::addUfrag(const std::string& ufrag, std::weak_ptr<UdpMux> owner) {
+  updateRoutes([&ufrag, &owner] (Routes* routes) {
+    routes->ufrags[ufrag] = owner;
+  });
+}
+
+void UdpMuxSteeringTable::removeUfrag(const std::string& ufrag) {
+  updateRoutes([&ufrag] (Routes* routes) {
+    routes->ufrags.erase(ufrag);
+  });
+}
+
+void UdpMuxSteeringTable::addRemote(const UdpMuxAddress& remote, std::weak_ptr<UdpMux> owner) {
+  updateRoutes([&remote, &owner] (Routes* routes) {
+    routes->remotes[remote] = owner;
+  });
+}
+
+void UdpMuxSteeringTable::removeRemote(const UdpMuxAddress& remote) {
+  updateRoutes([&remote] (Routes* routes) {
+    routes->remotes.erase(remote);
+  });
+}
+
+std::shared_ptr<UdpMux> UdpMuxSteeringTable::findByUfrag(const std::string& ufrag) {
+  std::shared_ptr<const Routes> routes = getRoutes();
+  auto it = routes->ufrags.find(ufrag);
+  return it == routes->ufrags.end() ? nullptr : it->second.lock();
+}
+
+std::shared_ptr<UdpMux> UdpMuxSteeringTable::findByRemote(const UdpMuxAddress& remote) {
+  std::shared_ptr<const Routes> routes = getRoutes();
+  auto it = routes->remotes.find(remote);
+  return it == routes->remotes.end() ? nullptr : it->second.lock();
+}
+
+size_t UdpMuxSteeringTable::size() {
+  std::shared_ptr<const Routes> routes = getRoutes();
+  return routes->ufrags.size() + routes->remotes.size();
+}
+
+UdpMux::UdpMux(uint16_t port, const std::string& network_interface, std::weak_ptr<IOWorker> io_worker,
+               std::shared_ptr<UdpMuxSteeringTable> steering)
+    : port_{port}, network_interface_{network_interface}, io_worker_{io_worker}, steering_{steering},
+      io_driver_{nullptr}, socket_{-1}, steered_packets_{0}, gso_enabled_{false}, gro_requested_{false},
+      gro_enabled_{false}, timestamps_enabled_{false}, gso_calls_{0}, gso_segments_{0}, gro_calls_{0},
+      gro_segments_{0}, receive_queue_drops_{0}, send_would_block_{0}, send_no_buffers_{0}, send_errors_{0},
+      received_bytes_{0}, sent_bytes_{0}, tune_start_us_{0}, receive_buffer_size_{0}, send_buffer_size_{0} {
+}
+
+UdpMux::~UdpMux() {
+  close();
+}
+
+bool UdpMux::start() {
+  if (socket_ >= 0) {
+    return true;
+  }
+  socket_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+  if (socket_ < 0) {
+    ELOG_ERROR("%s message: Could not create socket, errno: %d", toLog(), errno);
+    return false;
+  }
+  fcntl(socket_, F_SETFL, fcntl(socket_, F_GETFL, 0) | O_NONBLOCK);
+  if (steering_) {
+    int enable = 1;
+    if (setsockopt(socket_, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) < 0) {
+      ELOG_ERROR("%s message: Could not set SO_REUSEPORT, errno: %d", toLog(), errno);
+      ::close(socket_);
+      socket_ = -1;
+      return false;
+    }
+  }
+
+  sockaddr_in local;
+  memset(&local, 0, sizeof(local));
+  local.sin_family = AF_INET;
+  local.sin_addr.s_addr = htonl(INADDR_ANY);
+  local.sin_port = htons(port_);
+  if (::bind(socket_, reinterpret_cast<sockaddr*>(&local), sizeof(local)) < 0) {
+    ELOG_ERROR("%s message: Could not bind socket, errno: %d", toLog(), errno);
+    ::close(socket_);
+    socket_ = -1;
+    return false;
+  }
+  if (port_ == 0) {
+    socklen_t local_length = sizeof(local);
+    getsockname(socket_, reinterpret_cast<sockaddr*>(&local), &local_length);
+    port_ = ntohs(local.sin_port);
+  }
+  discoverLocalAddresses();
+  detectOffloads();
+  int enable = 1;
+  if (setsockopt(socket_, SOL_SOCKET, SO_RXQ_OVFL, &enable, sizeof(enable)) < 0) {
+    ELOG_WARN("%s message: SO_RXQ_OVFL is not supported, socket drops will not be counted, errno: %d", toLog(), errno);
+  }
+  receive_buffer_size_ = 0;
+  send_buffer_size_ = 0;
+  setBufferSize(SO_RCVBUF, SO_RCVBUFFORCE, 0, &receive_buffer_size_);
+  setBufferSize(SO_SNDBUF, SO_SNDBUFFORCE, 0, &send_buffer_size_);
+  received_bytes_ = 0;
+  sent_bytes_ = 0;
+  tune_start_us_ = ClockUtils::timePointToUs(clock::now());
+  if (io_driver_) {
+    io_driver_->watch(socket_);
+  } else {
+    waitForData();
+  }
+  ELOG_INFO("%s message: started, addresses: %lu, gso: %d, gro: %d, timestamps: %d", toLog(),
+            local_addresses_.size(), gso_enabled_, gro_enabled_, timestamps_enabled_);
+  return true;
+}
+
+void UdpMux::close() {
+  if (socket_ < 0) {
+    return;
+  }
+  if (io_driver_) {
+    io_driver_->unwatch(socket_);
+  } else {
+    NR_ASYNC_CANCEL(socket_, NR_ASYNC_WAIT_READ);
+  }
+  pending_.clear();
+  ::close(socket_.exchange(-1));
+  if (steering_) {
+    for (auto &ufrag : ufrags_) {
+      steering_->removeUfrag(ufrag.first);
+    }
+    for (auto &remote : remotes_) {
+      steering_->removeRemote(remote.first);
+    }
+  }
+  ufrags_.clear();
+  remotes_.clear();
+}
+
+void UdpMux::discoverLocalAddresses() {
+  local_addresses_.clear();
+  std::vector<std::string> loopback_addresses;
+  struct ifaddrs *interfaces;
+  if (getifaddrs(&interfaces) < 0) {
+    ELOG_WARN("%s message: Could not list network interfaces", toLog());
+    return;
+  }
+  for (struct ifaddrs *it = interfaces; it != nullptr; it = it->ifa_next) {
+    if (it->ifa_addr == nullptr || it->ifa_addr->sa_family != AF_INET || !(it->ifa_flags & IFF_UP)) {
+      continue;
+    }
+    if (!network_interface_.empty() && network_interface_ != it->ifa_name) {
+      continue;
+    }
+    UdpMuxAddress address{*reinterpret_cast<sockaddr_in*>(it->ifa_addr)};
+    if (it->ifa_flags & IFF_LOOPBACK) {
+      loopback_addresses.push_back(address.getIp());
+    } else {
+      local_addresses_.push_back(address.getIp());
+    }
+  }
+  freeifaddrs(interfaces);
+  if (local_addresses_.empty()) {
+    local_addresses_ = loopback_addresses;
+  }
+}
+
+void UdpMux::detectOffloads() {
+  // Setting a zero segment size is harmless and only fails when the kernel does not know about UDP_SEGMENT
+  int segment_size = 0;
+  gso_enabled_ = setsockopt(socket_, SOL_UDP, UDP_SEGMENT, &segment_size, sizeof(segment_size)) == 0;
+  gro_enabled_ = false;
+  if (gro_requested_) {
+    int enable = 1;
+    gro_enabled_ = setsockopt(socket_, SOL_UDP, UDP_GRO, &enable, sizeof(enable)) == 0;
+    if (!gro_enabled_) {
+      ELOG_WARN("%s message: UDP_GRO is not supported, errno: %d", toLog(), errno);
+    }
+  }
+  if (gro_enabled_) {
+    receive_buffer_.resize(kMaxGroBufferSize);
+  }
+  int enable = 1;
+  timestamps_enabled_ = setsockopt(socket_, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable)) == 0;
+  if (!timestamps_enabled_) {
+    ELOG_WARN("%s message: SO_TIMESTAMPNS is not supported, using read times, errno: %d", toLog(), errno);
+  }
+}
+
+void UdpMux::waitForData() {
+  NR_ASYNC_WAIT(socket_, NR_ASYNC_WAIT_READ, &UdpMux::onReadable, this);
+}
+
+void UdpMux::onReadable(int socket, int how, void *arg) {
+  UdpMux *mux = reinterpret_cast<UdpMux*>(arg);
+  mux->readPackets();
+}
+
+void UdpMux::readPackets() {
+  char control[kControlSize];
+  for (int i = 0; i < kMaxReadsPerWakeup; i++) {
+    // Without GRO datagrams are read straight into the packet that goes up the stack, which is reused
+    // when nobody kept it (STUN, unknown remotes)
+    if (!gro_enabled_ && !receive_packet_) {
+      receive_packet_ = std::make_shared<DataPacket>();
+    }
+    UdpMuxAddress remote;
+    iovec iov;
+    iov.iov_base = gro_enabled_ ? receive_buffer_.data() : receive_packet_->data;
+    iov.iov_len = gro_enabled_ ? receive_buffer_.size() : sizeof(receive_packet_->data);
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_name = &remote.addr;
+    msg.msg_namelen = sizeof(remote.addr);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    ssize_t len = recvmsg(socket_, &msg, 0);
+    if (len <= 0) {
+      break;
+    }
+    int segment_size = 0;
+    uint64_t received_time_us = 0;
+    parseControlMessages(&msg, &segment_size, &received_time_us);
+    if (!gro_enabled_) {
+      received_bytes_ += len;
+      receive_packet_->length = len;
+      receive_packet_->setReceivedTime(received_time_us);
+      dispatch(remote, receive_packet_);
+      if (receive_packet_.use_count() > 1) {
+        receive_packet_.reset();
+      }
+      continue;
+    }
+    onReceived(remote, receive_buffer_.data(), len, segment_size, received_time_us);
+  }
+  // nrappkit callbacks are one-shot
+  if (socket_ >= 0) {
+    waitForData();
+  }
+}
+
+void UdpMux::parseControlMessages(msghdr* msg, int* segment_size, uint64_t* received_time_us) {
+  uint64_t now_us = ClockUtils::timePointToUs(clock::now());
+  *received_time_us = now_us;
+  if (msg->msg_controllen == 0) {
+    return;
+  }
+  for (cmsghdr *cmsg = CMSG_FIRSTHDR(msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(msg, cmsg)) {
+    if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+      memcpy(segment_size, CMSG_DATA(cmsg), sizeof(*segment_size));
+    } else if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+      // The kernel stamps with CLOCK_REALTIME, so we carry the age of the datagram over to erizo::clock
+      timespec kernel_time;
+      timespec realtime;
+      memcpy(&kernel_time, CMSG_DATA(cmsg), sizeof(kernel_time));
+      clock_gettime(CLOCK_REALTIME, &realtime);
+      int64_t age_us = (realtime.tv_sec - kernel_time.tv_sec) * 1000000 +
+                       (realtime.tv_nsec - kernel_time.tv_nsec) / 1000;
+      if (age_us > 0 && static_cast<uint64_t>(age_us) < now_us) {
+        *received_time_us = now_us - age_us;
+      }
+    } else if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_RXQ_OVFL) {
+      // Total drops on the socket when the datagram was queued, only attached once there has been one
+      uint32_t drops;
+      memcpy(&drops, CMSG_DATA(cmsg), sizeof(drops));
+      receive_queue_drops_ = drops;
+    }
+  }
+}
+
+void UdpMux::onReceived(const UdpMuxAddress& remote, char* buf, int len, int segment_size,
+                        uint64_t received_time_us) {
+  received_bytes_ += len;
+  if (segment_size <= 0 || segment_size >= len) {
+    segment_size = len;
+  } else {
+    gro_calls_++;
+    gro_segments_ += (len + segment_size - 1) / segment_size;
+  }
+  for (int offset = 0; offset < len; offset += segment_size) {
+    int length = std::min(segment_size, len - offset);
+    if (length > static_cast<int>(sizeof(DataPacket::data))) {
+      continue;
+    }
+    auto packet = std::make_shared<DataPacket>();
+    memcpy(packet->data, buf + offset, length);
+    packet->length = length;
+    packet->setReceivedTime(received_time_us);
+    dispatch(remote, packet);
+  }
+}
+
+void UdpMux::dispatch(const UdpMuxAddress& remote, PacketPtr packet) {
+  std::string ufrag;
+  if (StunMessage::isStun(packet->data, packet->length)) {
+    StunMessage message;
+    if (message.parse(packet->data, packet->length) && message.getType() == StunMessage::kBindingRequest) {
+      ufrag = message.getLocalUfrag();
+    }
+  }
+  if (dispatchLocally(remote, ufrag, packet)) {
+    return;
+  }
+  std::shared_ptr<UdpMux> owner;
+  if (steering_) {
+    owner = ufrag.empty() ? nullptr : steering_->findByUfrag(ufrag);
+    if (!owner) {
+      owner = steering_->findByRemote(remote);
+    }
+  }
+  if (!owner || owner.get() == this) {
+    ELOG_TRACE("%s message: Dropping packet from unknown remote, remote: %s", toLog(), remote.toString().c_str());
+    return;
+  }
+  steer(owner, remote, ufrag, std::move(packet));
+}
+
+bool UdpMux::dispatchLocally(const UdpMuxAddress& remote, const std::string& ufrag, PacketPtr packet) {
+  if (!ufrag.empty()) {
+    auto ufrag_it = ufrags_.find(ufrag);
+    if (ufrag_it != ufrags_.end()) {
+      if (auto listener = ufrag_it->second.lock()) {
+        listener->onMuxPacket(remote, std::move(packet));
+        return true;
+      }
+      ufrags_.erase(ufrag_it);
+    }
+  }
+  auto remote_it = remotes_.find(remote);
+  if (remote_it == remotes_.end()) {
+    return false;
+  }
+  if (auto listener = remote_it->second.lock()) {
+    listener->onMuxPacket(remote, std::move(packet));
+    return true;
+  }
+  remotes_.erase(remote_it);
+  return false;
+}
+
+void UdpMux::steer(std::shared_ptr<UdpMux> owner, const UdpMuxAddress& remote, const std::string& ufrag,
+                   PacketPtr packet) {
+  auto owner_worker = owner->io_worker_.lock();
+  if (!owner_worker) {
+    return;
+  }
+  steered_packets_++;
+  std::weak_ptr<UdpMux> weak_owner = owner;
+  owner_worker->task([weak_owner, remote, ufrag, packet] {
+    if (auto owner = weak_owner.lock()) {
+      owner->dispatchLocally(remote, ufrag, packet);
+    }
+  });
+}
+
+void UdpMux::registerUfrag(const std::string& ufrag, std::weak_ptr<UdpMuxListener> listener) {
+  ufrags_[ufrag] = listener;
+  if (steering_) {
+    steering_->addUfrag(ufrag, shared_from_this());
+  }
+}
+
+void UdpMux::unregisterUfrag(const std::string& ufrag) {
+  ufrags_.erase(ufrag);
+  if (steering_) {
+    steering_->removeUfrag(ufrag);
+  }
+}
+
+void UdpMux::bindRemote(const UdpMuxAddress& remote, std::weak_ptr<UdpMuxListener> listener) {
+  ELOG_DEBUG("%s message: Binding remote, remote: %s", toLog(), remote.toString().c_str());
+  remotes_[remote] = listener;
+  if (steering_) {
+    steering_->addRemote(remote, shared_from_this());
+  }
+}
+
+void UdpMux::unbindRemote(const UdpMuxAddress& remote) {
+  remotes_.erase(remote);
+  if (steering_) {
+    steering_->removeRemote(remote);
+  }
+}
+
+int UdpMux::sendTo(const UdpMuxAddress& remote, const char* buf, int len) {
+  if (socket_ < 0) {
+    return -1;
+  }
+  ssize_t sent = sendto(socket_, buf, len, 0, reinterpret_cast<const sockaddr*>(&remote.addr), sizeof(remote.addr));
+  if (sent < 0) {
+    ELOG_DEBUG("%s message: Error sending packet, remote: %s, errno: %d", toLog(), remote.toString().c_str(), errno);
+    onSendError(remote, errno);
+  }
+  return sent;
+}
+
+void UdpMux::onSendError(const UdpMuxAddress& remote, int error) {
+  if (error == EAGAIN || error == EWOULDBLOCK) {
+    send_would_block_++;
+  } else if (error == ENOBUFS) {
+    send_no_buffers_++;
+  } else {
+    send_errors_++;
+  }
+  auto remote_it = remotes_.find(remote);
+  if (remote_it != remotes_.end()) {
+    if (auto listener = remote_it->second.lock()) {
+      listener->onMuxSendError(remote, error);
+    }
+  }
+}
+
+SocketStats UdpMux::getSocketStats() const {
+  SocketStats stats;
+  int socket = socket_;
+  stats.available = socket >= 0;
+  stats.receive_queue_drops = receive_queue_drops_;
+  stats.send_would_block = send_would_block_;
+  stats.send_no_buffers = send_no_buffers_;
+  stats.send_errors = send_errors_;
+  uint32_t meminfo[SK_MEMINFO_VARS];
+  socklen_t length = sizeof(meminfo);
+  if (socket >= 0 && getsockopt(socket, SOL_SOCKET, SO_MEMINFO, meminfo, &length) == 0) {
+    stats.receive_queued_bytes = meminfo[SK_MEMINFO_RMEM_ALLOC];
+    stats.receive_buffer_size = meminfo[SK_MEMINFO_RCVBUF];
+    stats.send_queued_bytes = meminfo[SK_MEMINFO_WMEM_ALLOC];
+    stats.send_buffer_size = meminfo[SK_MEMINFO_SNDBUF];
+  }
+  return stats;
+}
+
+void UdpMux::tuneBuffers() {
+  uint64_t now_us = ClockUtils::timePointToUs(clock::now());
+  uint64_t elapsed_us = now_us - tune_start_us_;
+  if (elapsed_us < kBufferTuningIntervalUs) {
+    return;
+  }
+  setBufferSize(SO_RCVBUF, SO_RCVBUFFORCE, received_bytes_ * 1000000 / elapsed_us, &receive_buffer_size_);
+  setBufferSize(SO_SNDBUF, SO_SNDBUFFORCE, sent_bytes_ * 1000000 / elapsed_us, &send_buffer_size_);
+  received_bytes_ = 0;
+  sent_bytes_ = 0;
+  tune_start_us_ = now_us;
+}
+
+void UdpMux::setBufferSize(int option, int force_option, uint64_t bytes_per_second, uint32_t *size) {
+  uint64_t target = std::min(std::max(bytes_per_second * kBufferedTrafficMs / 1000, kMinSocketBufferSize),
+                             kMaxSocketBufferSize);
+  // Grow as soon as the traffic needs it but only shrink when it is well below, so the size does not flap
+  if (*size != 0 && target <= *size && target * 2 > *size) {
+    return;
+  }
+  int value = target;
+  // The forced variant goes over net.core.[rw]mem_max but needs CAP_NET_ADMIN
+  if (setsockopt(socket_, SOL_SOCKET, force_option, &value, sizeof(value)) < 0 &&
+      setsockopt(socket_, SOL_SOCKET, option, &value, sizeof(value)) < 0) {
+    ELOG_WARN("%s message: Could not resize socket buffer, buffer: %s, size: %d, errno: %d", toLog(),
+              option == SO_RCVBUF ? "receive" : "send", value, errno);
+    return;
+  }
+  ELOG_DEBUG("%s message: Socket buffer resized, buffer: %s, size: %d, bytes_per_second: %lu", toLog(),
+             option == SO_RCVBUF ? "receive" : "send", value, bytes_per_second);
+  *size = target;
+}
+
+void UdpMux::queueSend(const UdpMuxAddress& remote, PacketPtr packet) {
+  sent_bytes_ += packet->length;
+  pending_.emplace_back(remote, packet);
+  if (pending_.size() >= kMaxPendingPackets) {
+    flush();
+  }
+}
+
+void UdpMux::flush() {
+  if (socket_ < 0) {
+    pending_.clear();
+    return;
+  }
+  tuneBuffers();
+  size_t begin = 0;
+  while (begin < pending_.size()) {
+    size_t end = begin + 1;
+    if (gso_enabled_) {
+      // Every segment but the last one must have the same size
+      const UdpMuxAddress &remote = pending_[begin].first;
+      int segment_size = pending_[begin].second->length;
+      int total_size = segment_size;
+      while (end < pending_.size() && end - begin < kMaxGsoSegments && pending_[end].first == remote) {
+        int length = pending_[end].second->length;
+        if (length > segment_size || total_size + length > kMaxGsoBytes) {
+          break;
+        }
+        total_size += length;
+        end++;
+        if (length < segment_size) {
+          break;
+        }
+      }
+    }
+    if (io_driver_) {
+      uint16_t segment_size = end - begin > 1 ? pending_[begin].second->length : 0;
+      std::vector<PacketPtr> packets;
+      packets.reserve(end - begin);
+      for (size_t index = begin; index < end; index++) {
+        packets.push_back(std::move(pending_[index].second));
+      }
+      if (segment_size != 0) {
+        gso_calls_++;
+        gso_segments_ += packets.size();
+      }
+      io_driver_->send(pending_[begin].first, std::move(packets), segment_size);
+    } else if (end - begin == 1 || !sendSegments(begin, end)) {
+      for (size_t index = begin; index < end; index++) {
+        sendTo(pending_[index].first, pending_[index].second->data, pending_[index].second->length);
+      }
+    }
+    begin = end;
+  }
+  pending_.clear();
+}
+
+bool UdpMux::sendSegments(size_t begin, size_t end) {
+  std::vector<iovec> iovs(end - begin);
+  for (size_t index = begin; index < end; index++) {
+    iovs[index - begin].iov_base = pending_[index].second->data;
+    iovs[index - begin].iov_len = pending_[index].second->length;
+  }
+  char control[CMSG_SPACE(sizeof(uint16_t))];
+  memset(control, 0, sizeof(control));
+  msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_name = const_cast<sockaddr_in*>(&pending_[begin].first.addr);
+  msg.msg_namelen = sizeof(sockaddr_in);
+  msg.msg_iov = iovs.data();
+  msg.msg_iovlen = iovs.size();
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_UDP;
+  cmsg->cmsg_type = UDP_SEGMENT;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+  uint16_t segment_size = pending_[begin].second->length;
+  memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+
+  if (sendmsg(socket_, &msg, 0) < 0) {
+    if (errno == EIO || errno == EINVAL || errno == EOPNOTSUPP) {
+      // The egress device cannot segment (e.g. no checksum offload), stop trying
+      ELOG_WARN("%s message: Disabling GSO, errno: %d", toLog(), errno);
+      gso_enabled_ = false;
+    } else {
+      ELOG_DEBUG("%s message: Error sending segments, errno: %d", toLog(), errno);
+    }
+    // The caller sends them one by one, so each packet that still fails is counted
+    return false;
+  }
+  gso_calls_++;
+  gso_segments_ += end - begin;
+  return true;
+}
+
+}  // namespace erizo
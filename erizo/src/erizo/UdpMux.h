@@ -0,0 +1,254 @@
+/*
+ * UdpMux.h
+ */
+
+#ifndef ERIZO_SRC_ERIZO_UDPMUX_H_
+#define ERIZO_SRC_ERIZO_UDPMUX_H_
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <time.h>
+
+#include <cstring>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "./logger.h"
+#include "./MediaDefinitions.h"
+#include "stats/SocketStats.h"
+#include "thread/IOWorker.h"
+
+namespace erizo {
+
+struct UdpMuxAddress {
+  sockaddr_in addr;
+
+  UdpMuxAddress() {
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+  }
+  explicit UdpMuxAddress(const sockaddr_in& address) : addr(address) {}
+
+  bool operator==(const UdpMuxAddress& other) const {
+    return addr.sin_addr.s_addr == other.addr.sin_addr.s_addr && addr.sin_port == other.addr.sin_port;
+  }
+  bool operator!=(const UdpMuxAddress& other) const {
+    return !(*this == other);
+  }
+
+  std::string getIp() const;
+  int getPort() const;
+  std::string toString() const;
+};
+
+struct UdpMuxAddressHash {
+  std::size_t operator()(const UdpMuxAddress& address) const {
+    return std::hash<uint64_t>()((static_cast<uint64_t>(address.addr.sin_addr.s_addr) << 16) |
+                                 address.addr.sin_port);
+  }
+};
+
+class UdpMuxListener {
+ public:
+  virtual ~UdpMuxListener() {}
+  /**
+   * The packet holds the datagram as it was read from the socket and it is not used by the mux afterwards
+   */
+  virtual void onMuxPacket(const UdpMuxAddress& remote, PacketPtr packet) = 0;
+  /**
+   * A packet queued for remote could not be sent, error is the errno of the failed send
+   */
+  virtual void onMuxSendError(const UdpMuxAddress& remote, int error) {}
+};
+
+class UdpMux;
+
+/**
+ * Lets an IOWorker backend other than nrappkit drive the socket of a UdpMux.
+ */
+class UdpMuxIoDriver {
+ public:
+  virtual ~UdpMuxIoDriver() {}
+  virtual void watch(int socket) = 0;
+  virtual void unwatch(int socket) = 0;
+  /**
+   * Sends packets to remote, as GSO segments of segment_size when it is not 0.
+   * The packets must be kept alive until the send completes.
+   */
+  virtual void send(const UdpMuxAddress& remote, std::vector<PacketPtr> packets, uint16_t segment_size) = 0;
+};
+
+/**
+ * Maps ufrags and nominated remote addresses to the UdpMux (and thus the IOWorker) that owns the
+ * connection. It is shared by all the muxes of an IOThreadPool when they listen on the same port with
+ * SO_REUSEPORT, because the kernel spreads remotes across sockets regardless of who owns them.
+ * It can be used from any thread. Lookups happen for every misdelivered packet while changes only happen when
+ * connections come and go, so readers take an immutable snapshot and writers replace it with an updated copy.
+ */
+class UdpMuxSteeringTable {
+ public:
+  UdpMuxSteeringTable();
+
+  void addUfrag(const std::string& ufrag, std::weak_ptr<UdpMux> owner);
+  void removeUfrag(const std::string& ufrag);
+  void addRemote(const UdpMuxAddress& remote, std::weak_ptr<UdpMux> owner);
+  void removeRemote(const UdpMuxAddress& remote);
+
+  std::shared_ptr<UdpMux> findByUfrag(const std::string& ufrag);
+  std::shared_ptr<UdpMux> findByRemote(const UdpMuxAddress& remote);
+
+  size_t size();
+
+ private:
+  struct Routes {
+    std::unordered_map<std::string, std::weak_ptr<UdpMux>> ufrags;
+    std::unordered_map<UdpMuxAddress, std::weak_ptr<UdpMux>, UdpMuxAddressHash> remotes;
+  };
+
+  std::shared_ptr<const Routes> getRoutes() const;
+  void updateRoutes(std::function<void(Routes*)> update);
+
+  // Only serializes writers, readers never take it
+  std::mutex write_mutex_;
+  std::shared_ptr<const Routes> routes_;
+};
+
+/**
+ * A UDP socket shared by every IceConnection running on one IOWorker.
+ * STUN requests are routed by the local ufrag in their USERNAME and, once a connection has
+ * nominated a remote address, everything else is routed by that remote address.
+ * When a steering table is given the socket is bound with SO_REUSEPORT, so every IOWorker can listen on
+ * the same port, and packets that the kernel delivers to the wrong worker are handed over to the owner.
+ * Media is queued with queueSend and flushed once per IOWorker loop, coalescing runs of same-size packets to
+ * the same remote in a single UDP_SEGMENT (GSO) sendmsg when the kernel supports it. UDP_GRO on receive is
+ * optional and coalesced buffers are split back into datagrams before dispatching them.
+ * Received packets are stamped with the SO_TIMESTAMPNS time the kernel took when the datagram arrived, or
+ * with the time the socket was read when it is not available, so a busy worker does not skew their timing.
+ * Kernel drops (SO_RXQ_OVFL) and send errors are counted, and the socket buffers follow the observed bitrate.
+ * Everything but construction must be called from the IOWorker thread that owns it.
+ */
+class UdpMux : public std::enable_shared_from_this<UdpMux> {
+  DECLARE_LOGGER();
+
+ public:
+  UdpMux(uint16_t port, const std::string& network_interface, std::weak_ptr<IOWorker> io_worker = {},
+         std::shared_ptr<UdpMuxSteeringTable> steering = nullptr);
+  virtual ~UdpMux();
+
+  virtual bool start();
+  virtual void close();
+
+  virtual void registerUfrag(const std::string& ufrag, std::weak_ptr<UdpMuxListener> listener);
+  virtual void unregisterUfrag(const std::string& ufrag);
+  virtual void bindRemote(const UdpMuxAddress& remote, std::weak_ptr<UdpMuxListener> listener);
+  virtual void unbindRemote(const UdpMuxAddress& remote);
+
+  virtual int sendTo(const UdpMuxAddress& remote, const char* buf, int len);
+  virtual void queueSend(const UdpMuxAddress& remote, PacketPtr packet);
+  virtual void flush();
+
+  /**
+   * Hands reading and queued sends over to driver instead of nrappkit, it has to be called before start
+   */
+  void setIoDriver(UdpMuxIoDriver* driver) { io_driver_ = driver; }
+  /**
+   * Entry point for drivers: dispatches a received buffer, split in segment_size datagrams if it is not 0
+   */
+  void onReceived(const UdpMuxAddress& remote, char* buf, int len, int segment_size, uint64_t received_time_us);
+  /**
+   * Reads the GRO segment size and the arrival time (in erizo::clock microseconds) out of the control
+   * messages of a datagram that has just been received, and keeps track of the kernel drop counter
+   */
+  void parseControlMessages(msghdr* msg, int* segment_size, uint64_t* received_time_us);
+  /**
+   * Entry point for drivers: accounts a send that failed with error (an errno value)
+   */
+  void onSendError(const UdpMuxAddress& remote, int error);
+  /**
+   * Room needed for the control messages the mux enables on its socket
+   */
+  static constexpr size_t kControlSize = CMSG_SPACE(sizeof(int)) + CMSG_SPACE(sizeof(timespec)) +
+                                         CMSG_SPACE(sizeof(uint32_t));
+  int getSocket() const { return socket_; }
+  void disableGso() { gso_enabled_ = false; }
+
+  /**
+   * Requests UDP_GRO on the socket, it has to be called before start
+   */
+  void setGroEnabled(bool enabled) { gro_requested_ = enabled; }
+  bool isGsoEnabled() const { return gso_enabled_; }
+  bool isGroEnabled() const { return gro_enabled_; }
+  bool areTimestampsEnabled() const { return timestamps_enabled_; }
+
+  virtual std::vector<std::string> getLocalAddresses() const { return local_addresses_; }
+  virtual uint16_t getPort() const { return port_; }
+  uint64_t getSteeredPackets() const { return steered_packets_; }
+  uint64_t getGsoCalls() const { return gso_calls_; }
+  uint64_t getGsoSegments() const { return gso_segments_; }
+  uint64_t getGroCalls() const { return gro_calls_; }
+  uint64_t getGroSegments() const { return gro_segments_; }
+  /**
+   * It can be called from any thread
+   */
+  SocketStats getSocketStats() const;
+
+  inline std::string toLog() const {
+    return "port: " + std::to_string(port_);
+  }
+
+ private:
+  static void onReadable(int socket, int how, void *arg);
+  void readPackets();
+  void dispatch(const UdpMuxAddress& remote, PacketPtr packet);
+  bool dispatchLocally(const UdpMuxAddress& remote, const std::string& ufrag, PacketPtr packet);
+  void steer(std::shared_ptr<UdpMux> owner, const UdpMuxAddress& remote, const std::string& ufrag,
+             PacketPtr packet);
+  void waitForData();
+  void discoverLocalAddresses();
+  void detectOffloads();
+  bool sendSegments(size_t begin, size_t end);
+  void tuneBuffers();
+  void setBufferSize(int option, int force_option, uint64_t bytes_per_second, uint32_t *size);
+
+ private:
+  uint16_t port_;
+  std::string network_interface_;
+  std::weak_ptr<IOWorker> io_worker_;
+  std::shared_ptr<UdpMuxSteeringTable> steering_;
+  UdpMuxIoDriver* io_driver_;
+  // getSocketStats reads it from other threads
+  std::atomic<int> socket_;
+  std::atomic<uint64_t> steered_packets_;
+  bool gso_enabled_;
+  bool gro_requested_;
+  bool gro_enabled_;
+  bool timestamps_enabled_;
+  std::atomic<uint64_t> gso_calls_;
+  std::atomic<uint64_t> gso_segments_;
+  std::atomic<uint64_t> gro_calls_;
+  std::atomic<uint64_t> gro_segments_;
+  std::atomic<uint64_t> receive_queue_drops_;
+  std::atomic<uint64_t> send_would_block_;
+  std::atomic<uint64_t> send_no_buffers_;
+  std::atomic<uint64_t> send_errors_;
+  uint64_t received_bytes_;
+  uint64_t sent_bytes_;
+  uint64_t tune_start_us_;
+  uint32_t receive_buffer_size_;
+  uint32_t send_buffer_size_;
+  std::vector<char> receive_buffer_;
+  PacketPtr receive_packet_;
+  std::vector<std::pair<UdpMuxAddress, PacketPtr>> pending_;
+  std::vector<std::string> local_addresses_;
+  std::unordered_map<std::string, std::weak_ptr<UdpMuxListener>> ufrags_;
+  std::unordered_map<UdpMuxAddress, std::weak_ptr<UdpMuxListener>, UdpMuxAddressHash> remotes_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_UDPMUX_H_
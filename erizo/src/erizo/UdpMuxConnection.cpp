@@ -0,0 +1,295 @@
+/*
+ * UdpMuxConnection.cpp
+ */
+
+#include "./UdpMuxConnection.h"
+
+#include <errno.h>
+#include <openssl/rand.h>
+
+#include <string>
+#include <vector>
+#include <future>  // NOLINT
+
+#include "lib/ClockUtils.h"
+#include "lib/StunMessage.h"
+
+namespace erizo {
+
+DEFINE_LOGGER(UdpMuxConnection, "UdpMuxConnection");
+
+static constexpr unsigned int kUfragLength = 8;
+static constexpr unsigned int kPwdLength = 24;
+static constexpr int kStunResponseMaxLength = 128;
+// RFC 5245 4.1.2.1 with type preference 126 (host), local preference 65535 and component 1
+static constexpr unsigned int kHostCandidatePriority = 2130706431;
+
+static std::string getHostTypeString(HostType type) {
+  switch (type) {
+    case HOST: return "host";
+    case SRFLX: return "serverReflexive";
+    case PRFLX: return "peerReflexive";
+    case RELAY: return "relayed";
+    default: return "unknown";
+  }
+}
+
+UdpMuxConnection::UdpMuxConnection(std::shared_ptr<IOWorker> io_worker, std::shared_ptr<UdpMux> mux,
+                                   const IceConfig& ice_config)
+    : IceConnection(ice_config),
+      io_worker_{io_worker},
+      mux_{mux},
+      closed_{false},
+      has_selected_remote_{false},
+      send_would_block_{0},
+      send_no_buffers_{0},
+      send_errors_{0} {
+}
+
+UdpMuxConnection::~UdpMuxConnection() {
+}
+
+void UdpMuxConnection::async(std::function<void(std::shared_ptr<UdpMuxConnection>)> f) {
+  std::weak_ptr<UdpMuxConnection> weak_this = shared_from_this();
+  io_worker_->task([weak_this, f] {
+    if (auto this_ptr = weak_this.lock()) {
+      f(this_ptr);
+    }
+  });
+}
+
+std::string UdpMuxConnection::getRandomString(unsigned int length) {
+  static const char kIceChars[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789+/";
+  std::vector<unsigned char> random(length);
+  RAND_bytes(random.data(), length);
+  std::string result(length, '0');
+  for (unsigned int i = 0; i < length; i++) {
+    result[i] = kIceChars[random[i] % (sizeof(kIceChars) - 1)];
+  }
+  return result;
+}
+
+void UdpMuxConnection::start() {
+  ufrag_ = getRandomString(kUfragLength);
+  upass_ = getRandomString(kPwdLength);
+  if (!ice_config_.username.empty()) {
+    remote_ufrag_ = ice_config_.username;
+  }
+  auto start_promise = std::make_shared<std::promise<void>>();
+  async([start_promise] (std::shared_ptr<UdpMuxConnection> this_ptr) {
+    this_ptr->startSync();
+    start_promise->set_value();
+  });
+  std::future_status status = start_promise->get_future().wait_for(std::chrono::seconds(5));
+  if (status == std::future_status::timeout) {
+    ELOG_WARN("%s Start timed out", toLog());
+  }
+}
+
+void UdpMuxConnection::startSync() {
+  if (ice_config_.ice_components > 1) {
+    // Component 2 would never be ready, so fail now instead of waiting forever for it
+    ELOG_ERROR("%s message: UdpMux only supports rtcp-mux, components: %u", toLog(), ice_config_.ice_components);
+    updateIceState(IceState::FAILED);
+    return;
+  }
+  mux_->registerUfrag(ufrag_, shared_from_this());
+  for (const std::string &address : mux_->getLocalAddresses()) {
+    CandidateInfo cand_info;
+    cand_info.componentId = 1;
+    cand_info.foundation = "1";
+    cand_info.priority = kHostCandidatePriority;
+    cand_info.hostAddress = address;
+    cand_info.hostPort = mux_->getPort();
+    cand_info.hostType = HOST;
+    cand_info.netProtocol = "udp";
+    cand_info.transProtocol = ice_config_.transport_name;
+    cand_info.username = ufrag_;
+    cand_info.password = upass_;
+    cand_info.mediaType = ice_config_.media_type;
+    if (auto listener = getIceListener().lock()) {
+      ELOG_DEBUG("%s message: Candidate (%s, %s, %s)", toLog(), cand_info.hostAddress.c_str(),
+                                                       ufrag_.c_str(), upass_.c_str());
+      listener->onCandidate(cand_info, this);
+    }
+  }
+  updateIceState(IceState::CANDIDATES_RECEIVED);
+}
+
+bool UdpMuxConnection::setRemoteCandidates(const std::vector<CandidateInfo> &candidates, bool is_bundle) {
+  std::vector<CandidateInfo> cands(candidates);
+  async([cands] (std::shared_ptr<UdpMuxConnection> this_ptr) {
+    this_ptr->remote_candidates_.insert(this_ptr->remote_candidates_.end(), cands.begin(), cands.end());
+  });
+  return true;
+}
+
+void UdpMuxConnection::setRemoteCredentials(const std::string& username, const std::string& password) {
+  // As a lite agent we only validate checks with our own password
+  async([username] (std::shared_ptr<UdpMuxConnection> this_ptr) {
+    this_ptr->remote_ufrag_ = username;
+  });
+}
+
+void UdpMuxConnection::onMuxPacket(const UdpMuxAddress& remote, PacketPtr packet) {
+  if (closed_) {
+    return;
+  }
+  if (StunMessage::isStun(packet->data, packet->length)) {
+    onStunRequest(remote, packet->data, packet->length);
+    return;
+  }
+  if (has_selected_remote_ && remote == selected_remote_) {
+    packet->comp = 1;
+    onPacket(std::move(packet));
+  }
+}
+
+void UdpMuxConnection::onStunRequest(const UdpMuxAddress& remote, char* buf, int len) {
+  StunMessage request;
+  if (!request.parse(buf, len) || request.getType() != StunMessage::kBindingRequest) {
+    return;
+  }
+  if (request.getLocalUfrag() != ufrag_ || !request.checkIntegrity(upass_)) {
+    ELOG_DEBUG("%s message: Discarding unauthenticated binding request, remote: %s",
+               toLog(), remote.toString().c_str());
+    return;
+  }
+  if (request.hasFingerprint() && !request.checkFingerprint()) {
+    return;
+  }
+  char response[kStunResponseMaxLength];
+  int response_length = request.buildBindingResponse(remote.addr, upass_, response, sizeof(response));
+  if (response_length > 0) {
+    mux_->sendTo(remote, response, response_length);
+  }
+  if (request.hasUseCandidate() && (!has_selected_remote_ || remote != selected_remote_)) {
+    selectRemote(remote);
+  }
+}
+
+void UdpMuxConnection::selectRemote(const UdpMuxAddress& remote) {
+  if (has_selected_remote_) {
+    mux_->unbindRemote(selected_remote_);
+  }
+  ELOG_DEBUG("%s message: Remote nominated, remote: %s", toLog(), remote.toString().c_str());
+  selected_remote_ = remote;
+  has_selected_remote_ = true;
+  mux_->bindRemote(remote, shared_from_this());
+
+  CandidatePair pair;
+  pair.clientCandidateIp = remote.getIp();
+  pair.clientCandidatePort = remote.getPort();
+  pair.clientHostType = getHostTypeString(PRFLX);
+  for (const CandidateInfo &cand : remote_candidates_) {
+    if (cand.hostAddress == pair.clientCandidateIp && cand.hostPort == pair.clientCandidatePort) {
+      pair.clientHostType = getHostTypeString(cand.hostType);
+      break;
+    }
+  }
+  std::vector<std::string> local_addresses = mux_->getLocalAddresses();
+  pair.erizoCandidateIp = local_addresses.empty() ? "" : local_addresses.front();
+  pair.erizoCandidatePort = mux_->getPort();
+  pair.erizoHostType = getHostTypeString(HOST);
+  {
+    boost::mutex::scoped_lock lock(pair_mutex_);
+    selected_pair_ = pair;
+  }
+  updateIceState(IceState::READY);
+}
+
+int UdpMuxConnection::sendData(unsigned int component_id, const void* buf, int len) {
+  if (checkIceState() != IceState::READY) {
+    return -1;
+  }
+  packetPtr packet (new DataPacket());
+  memcpy(packet->data, buf, len);
+  packet->length = len;
+  return sendPacket(component_id, packet);
+}
+
+int UdpMuxConnection::sendPacket(unsigned int component_id, PacketPtr packet) {
+  if (checkIceState() != IceState::READY) {
+    return -1;
+  }
+  int len = packet->length;
+  async([packet] (std::shared_ptr<UdpMuxConnection> this_ptr) {
+    if (this_ptr->closed_ || !this_ptr->has_selected_remote_) {
+      return;
+    }
+    this_ptr->mux_->queueSend(this_ptr->selected_remote_, packet);
+  });
+  return len;
+}
+
+void UdpMuxConnection::onData(unsigned int component_id, char* buf, int len) {
+  packetPtr packet (new DataPacket());
+  memcpy(packet->data, buf, len);
+  packet->comp = component_id;
+  packet->length = len;
+  packet->setReceivedTime(ClockUtils::timePointToUs(clock::now()));
+  onPacket(std::move(packet));
+}
+
+void UdpMuxConnection::onPacket(PacketPtr packet) {
+  if (checkIceState() != IceState::READY) {
+    return;
+  }
+  if (auto listener = getIceListener().lock()) {
+    listener->onPacketReceived(std::move(packet));
+  }
+}
+
+void UdpMuxConnection::onMuxSendError(const UdpMuxAddress& remote, int error) {
+  if (error == EAGAIN || error == EWOULDBLOCK) {
+    send_would_block_++;
+  } else if (error == ENOBUFS) {
+    send_no_buffers_++;
+  } else {
+    send_errors_++;
+  }
+}
+
+SocketStats UdpMuxConnection::getSocketStats() {
+  SocketStats stats = mux_->getSocketStats();
+  stats.send_would_block = send_would_block_;
+  stats.send_no_buffers = send_no_buffers_;
+  stats.send_errors = send_errors_;
+  return stats;
+}
+
+CandidatePair UdpMuxConnection::getSelectedPair() {
+  boost::mutex::scoped_lock lock(pair_mutex_);
+  return selected_pair_;
+}
+
+void UdpMuxConnection::setReceivedLastCandidate(bool hasReceived) {
+}
+
+void UdpMuxConnection::closeSync() {
+  if (closed_) {
+    return;
+  }
+  listener_.reset();
+  mux_->unregisterUfrag(ufrag_);
+  if (has_selected_remote_) {
+    mux_->unbindRemote(selected_remote_);
+  }
+  closed_ = true;
+}
+
+void UdpMuxConnection::close() {
+  if (!closed_) {
+    auto shared_this = shared_from_this();
+    async([shared_this] (std::shared_ptr<UdpMuxConnection> this_ptr) {
+      shared_this->closeSync();
+    });
+  }
+}
+
+std::shared_ptr<IceConnection> UdpMuxConnection::create(std::shared_ptr<IOWorker> io_worker,
+                                                        const IceConfig& ice_config) {
+  return std::make_shared<UdpMuxConnection>(io_worker, io_worker->getUdpMux(), ice_config);
+}
+
+}  // namespace erizo
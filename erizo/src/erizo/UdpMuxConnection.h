@@ -0,0 +1,80 @@
+/*
+ * UdpMuxConnection.h
+ */
+
+#ifndef ERIZO_SRC_ERIZO_UDPMUXCONNECTION_H_
+#define ERIZO_SRC_ERIZO_UDPMUXCONNECTION_H_
+
+#include <boost/thread/mutex.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "./IceConnection.h"
+#include "./UdpMux.h"
+#include "./logger.h"
+#include "thread/IOWorker.h"
+
+namespace erizo {
+
+/**
+ * An ICE-lite connection that shares the UdpMux socket of its IOWorker with every other
+ * connection on that worker. It only gathers host candidates and answers connectivity checks,
+ * the remote peer is expected to be the controlling agent and to nominate a pair.
+ */
+class UdpMuxConnection : public IceConnection, public UdpMuxListener,
+                         public std::enable_shared_from_this<UdpMuxConnection> {
+  DECLARE_LOGGER();
+
+ public:
+  UdpMuxConnection(std::shared_ptr<IOWorker> io_worker, std::shared_ptr<UdpMux> mux, const IceConfig& ice_config);
+  virtual ~UdpMuxConnection();
+
+  void start() override;
+  bool setRemoteCandidates(const std::vector<CandidateInfo> &candidates, bool is_bundle) override;
+  void setRemoteCredentials(const std::string& username, const std::string& password) override;
+  int sendData(unsigned int component_id, const void* buf, int len) override;
+  int sendPacket(unsigned int component_id, PacketPtr packet) override;
+
+  void onData(unsigned int component_id, char* buf, int len) override;
+  CandidatePair getSelectedPair() override;
+  void setReceivedLastCandidate(bool hasReceived) override;
+  void close() override;
+  bool isIceLite() override { return true; }
+  /**
+   * Send errors are this connection's, drops and buffers belong to the socket shared with the whole IOWorker
+   */
+  SocketStats getSocketStats() override;
+
+  void onMuxPacket(const UdpMuxAddress& remote, PacketPtr packet) override;
+  void onMuxSendError(const UdpMuxAddress& remote, int error) override;
+
+  static std::shared_ptr<IceConnection> create(std::shared_ptr<IOWorker> io_worker, const IceConfig& ice_config);
+
+ private:
+  void async(std::function<void(std::shared_ptr<UdpMuxConnection>)> f);
+  void startSync();
+  void closeSync();
+  void onStunRequest(const UdpMuxAddress& remote, char* buf, int len);
+  void onPacket(PacketPtr packet);
+  void selectRemote(const UdpMuxAddress& remote);
+  static std::string getRandomString(unsigned int length);
+
+ private:
+  std::shared_ptr<IOWorker> io_worker_;
+  std::shared_ptr<UdpMux> mux_;
+  bool closed_;
+  bool has_selected_remote_;
+  UdpMuxAddress selected_remote_;
+  std::string remote_ufrag_;
+  std::vector<CandidateInfo> remote_candidates_;
+  CandidatePair selected_pair_;
+  boost::mutex pair_mutex_;
+  std::atomic<uint64_t> send_would_block_;
+  std::atomic<uint64_t> send_no_buffers_;
+  std::atomic<uint64_t> send_errors_;
+};
+
+}  // namespace erizo
+#endif  // ERIZO_SRC_ERIZO_UDPMUXCONNECTION_H_
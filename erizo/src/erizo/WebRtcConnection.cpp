@@ -40,12 +40,12 @@ namespace erizo {
 DEFINE_LOGGER(WebRtcConnection, "WebRtcConnection");
 
 WebRtcConnection::WebRtcConnection(std::shared_ptr<Worker> worker, std::shared_ptr<IOWorker> io_worker,
-    const std::string& connection_id, const IceConfig& ice_config, const std::vector<RtpMap> rtp_mappings,
-    const std::vector<erizo::ExtMap> ext_mappings, WebRtcConnectionEventListener* listener) :
+    std::shared_ptr<Worker> crypto_worker, const std::string& connection_id, const IceConfig& ice_config,
+    const std::vector<RtpMap> rtp_mappings, const std::vector<erizo::ExtMap> ext_mappings, WebRtcConnectionEventListener* listener) :
     connection_id_{connection_id},
     audio_enabled_{false}, video_enabled_{false}, bundle_{false}, conn_event_listener_{listener},
     ice_config_{ice_config}, rtp_mappings_{rtp_mappings}, extension_processor_{ext_mappings},
-    worker_{worker}, io_worker_{io_worker},
+    worker_{worker}, io_worker_{io_worker}, crypto_worker_{crypto_worker},
     remote_sdp_{std::make_shared<SdpInfo>(rtp_mappings)}, local_sdp_{std::make_shared<SdpInfo>(rtp_mappings)},
     audio_muted_{false}, video_muted_{false}, first_remote_sdp_processed_{false}
     {
@@ -114,6 +114,10 @@ bool WebRtcConnection::createOffer(bool video_enabled, bool audioEnabled, bool b
       std::vector<uint32_t> video_ssrc_list = std::vector<uint32_t>();
       video_ssrc_list.push_back(media_stream->getVideoSinkSSRC());
       local_sdp_->video_ssrc_map[media_stream->getLabel()] = video_ssrc_list;
+      if (media_stream->getVideoSinkRtxSSRC() != 0) {
+        local_sdp_->video_rtx_ssrc_map[media_stream->getLabel()][media_stream->getVideoSinkSSRC()] =
+          media_stream->getVideoSinkRtxSSRC();
+      }
     });
   }
   if (audio_enabled_) {
@@ -127,20 +131,23 @@ bool WebRtcConnection::createOffer(bool video_enabled, bool audioEnabled, bool b
 
   if (bundle_) {
     video_transport_.reset(new DtlsTransport(VIDEO_TYPE, "video", connection_id_, bundle_, true,
-                                            listener, ice_config_ , "", "", true, worker_, io_worker_));
+                                            listener, ice_config_ , "", "", true, worker_, io_worker_,
+                                            crypto_worker_));
     video_transport_->copyLogContextFrom(*this);
     video_transport_->start();
   } else {
     if (video_transport_.get() == nullptr && video_enabled_) {
       // For now we don't re/check transports, if they are already created we leave them there
       video_transport_.reset(new DtlsTransport(VIDEO_TYPE, "video", connection_id_, bundle_, true,
-                                              listener, ice_config_ , "", "", true, worker_, io_worker_));
+                                              listener, ice_config_ , "", "", true, worker_, io_worker_,
+                                              crypto_worker_));
       video_transport_->copyLogContextFrom(*this);
       video_transport_->start();
     }
     if (audio_transport_.get() == nullptr && audio_enabled_) {
       audio_transport_.reset(new DtlsTransport(AUDIO_TYPE, "audio", connection_id_, bundle_, true,
-                                              listener, ice_config_, "", "", true, worker_, io_worker_));
+                                              listener, ice_config_, "", "", true, worker_, io_worker_,
+                                              crypto_worker_));
       audio_transport_->copyLogContextFrom(*this);
       audio_transport_->start();
     }
@@ -178,6 +185,7 @@ void WebRtcConnection::removeMediaStream(const std::string& stream_id) {
           if (video_it != connection->local_sdp_->video_ssrc_map.end()) {
             connection->local_sdp_->video_ssrc_map.erase(video_it);
           }
+          connection->local_sdp_->video_rtx_ssrc_map.erase(stream->getLabel());
           auto audio_it = connection->local_sdp_->audio_ssrc_map.find(stream->getLabel());
           if (audio_it != connection->local_sdp_->audio_ssrc_map.end()) {
             connection->local_sdp_->audio_ssrc_map.erase(audio_it);
@@ -231,6 +239,10 @@ std::shared_ptr<SdpInfo> WebRtcConnection::getLocalSdpInfo() {
                toLog(), media_stream->getId(), media_stream->getAudioSinkSSRC());
     if (!video_ssrc_list.empty()) {
       local_sdp_->video_ssrc_map[media_stream->getLabel()] = video_ssrc_list;
+      if (media_stream->getVideoSinkRtxSSRC() != 0) {
+        local_sdp_->video_rtx_ssrc_map[media_stream->getLabel()][media_stream->getVideoSinkSSRC()] =
+          media_stream->getVideoSinkRtxSSRC();
+      }
     }
     if (media_stream->getAudioSinkSSRC() != kDefaultAudioSinkSSRC) {
       local_sdp_->audio_ssrc_map[media_stream->getLabel()] = media_stream->getAudioSinkSSRC();
@@ -338,7 +350,7 @@ bool WebRtcConnection::processRemoteSdp(std::string stream_id) {
                       toLog(), username.c_str(), password.c_str());
           video_transport_.reset(new DtlsTransport(VIDEO_TYPE, "video", connection_id_, bundle_, remote_sdp_->isRtcpMux,
                                                   listener, ice_config_ , username, password, false,
-                                                  worker_, io_worker_));
+                                                  worker_, io_worker_, crypto_worker_));
           video_transport_->copyLogContextFrom(*this);
           video_transport_->start();
         } else {
@@ -355,7 +367,7 @@ bool WebRtcConnection::processRemoteSdp(std::string stream_id) {
                       toLog(), username.c_str(), password.c_str());
           audio_transport_.reset(new DtlsTransport(AUDIO_TYPE, "audio", connection_id_, bundle_, remote_sdp_->isRtcpMux,
                                                   listener, ice_config_, username, password, false,
-                                                  worker_, io_worker_));
+                                                  worker_, io_worker_, crypto_worker_));
           audio_transport_->copyLogContextFrom(*this);
           audio_transport_->start();
         } else {
@@ -527,12 +539,24 @@ void WebRtcConnection::onRtcpFromTransport(PacketPtr packet, Transport *transpor
     PacketPtr rtcp = std::make_shared<DataPacket>(*packet);
     rtcp->length = (ntohs(chead->length) + 1) * 4;
     std::memcpy(rtcp->data, chead, rtcp->length);
-    forEachMediaStream([rtcp, transport, ssrc] (const std::shared_ptr<MediaStream> &media_stream) {
-      if (media_stream->isSourceSSRC(ssrc) || media_stream->isSinkSSRC(ssrc)) {
-        media_stream->onTransportData(rtcp, transport);
+    deliverToMediaStreams(rtcp, transport, ssrc);
+  });
+}
+
+void WebRtcConnection::deliverToMediaStreams(PacketPtr packet, Transport *transport, uint32_t ssrc) {
+  // Streams modify the packets they receive, so only the last one gets the original
+  std::shared_ptr<MediaStream> previous;
+  forEachMediaStream([&previous, packet, transport, ssrc] (const std::shared_ptr<MediaStream> &media_stream) {
+    if (media_stream->isSourceSSRC(ssrc) || media_stream->isSinkSSRC(ssrc)) {
+      if (previous) {
+        previous->onTransportData(std::make_shared<DataPacket>(*packet), transport);
       }
-    });
+      previous = media_stream;
+    }
   });
+  if (previous) {
+    previous->onTransportData(std::move(packet), transport);
+  }
 }
 
 void WebRtcConnection::onTransportData(PacketPtr packet, Transport *transport) {
@@ -547,11 +571,7 @@ void WebRtcConnection::onTransportData(PacketPtr packet, Transport *transport) {
   } else {
     RtpHeader *head = reinterpret_cast<RtpHeader*> (buf);
     uint32_t ssrc = head->getSSRC();
-    forEachMediaStream([packet, transport, ssrc] (const std::shared_ptr<MediaStream> &media_stream) {
-      if (media_stream->isSourceSSRC(ssrc) || media_stream->isSinkSSRC(ssrc)) {
-        media_stream->onTransportData(packet, transport);
-      }
-    });
+    deliverToMediaStreams(std::move(packet), transport, ssrc);
   }
 }
 
@@ -718,9 +738,17 @@ WebRTCEvent WebRtcConnection::getCurrentState() {
   return global_state_;
 }
 
+SocketStats WebRtcConnection::getSocketStats() {
+  std::shared_ptr<Transport> transport = video_transport_ ? video_transport_ : audio_transport_;
+  if (!transport || !transport->getIceConnection()) {
+    return SocketStats();
+  }
+  return transport->getIceConnection()->getSocketStats();
+}
+
 void WebRtcConnection::write(PacketPtr packet) {
-  asyncTask([packet] (std::shared_ptr<WebRtcConnection> connection) {
-    connection->syncWrite(packet);
+  asyncTask([packet] (std::shared_ptr<WebRtcConnection> connection) mutable {
+    connection->syncWrite(std::move(packet));
   });
 }
 
@@ -733,7 +761,7 @@ void WebRtcConnection::syncWrite(PacketPtr packet) {
     return;
   }
   this->extension_processor_.processRtpExtensions(packet);
-  transport->write(packet->data, packet->length);
+  transport->write(std::move(packet));
 }
 
 void WebRtcConnection::setTransport(std::shared_ptr<Transport> transport) {  // Only for Testing purposes
@@ -66,7 +66,7 @@ class WebRtcConnection: public TransportListener, public LogContext,
    * Constructs an empty WebRTCConnection without any configuration.
    */
   WebRtcConnection(std::shared_ptr<Worker> worker, std::shared_ptr<IOWorker> io_worker,
-      const std::string& connection_id, const IceConfig& ice_config,
+      std::shared_ptr<Worker> crypto_worker, const std::string& connection_id, const IceConfig& ice_config,
       const std::vector<RtpMap> rtp_mappings, const std::vector<erizo::ExtMap> ext_mappings,
       WebRtcConnectionEventListener* listener);
   /**
@@ -142,6 +142,10 @@ class WebRtcConnection: public TransportListener, public LogContext,
   void setTransport(std::shared_ptr<Transport> transport);  // Only for Testing purposes
 
   std::shared_ptr<Stats> getStatsService() { return stats_; }
+  /**
+   * Stats of the socket behind the video transport (or the audio one without bundle), from the connection worker
+   */
+  SocketStats getSocketStats();
 
   RtpExtensionProcessor& getRtpExtensionProcessor() { return extension_processor_; }
 
@@ -159,6 +163,7 @@ class WebRtcConnection: public TransportListener, public LogContext,
   void trackTransportInfo();
   void onRtcpFromTransport(PacketPtr packet, Transport *transport);
   void onREMBFromTransport(RtcpHeader *chead, Transport *transport);
+  void deliverToMediaStreams(PacketPtr packet, Transport *transport, uint32_t ssrc);
   void maybeNotifyWebRtcConnectionEvent(const WebRTCEvent& event, const std::string& message,
         const std::string& stream_id = "");
 
@@ -186,6 +191,7 @@ class WebRtcConnection: public TransportListener, public LogContext,
 
   std::shared_ptr<Worker> worker_;
   std::shared_ptr<IOWorker> io_worker_;
+  std::shared_ptr<Worker> crypto_worker_;
   std::vector<std::shared_ptr<MediaStream>> media_streams_;
   std::shared_ptr<SdpInfo> remote_sdp_;
   std::shared_ptr<SdpInfo> local_sdp_;
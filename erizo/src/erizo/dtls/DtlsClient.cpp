@@ -12,8 +12,13 @@ extern "C" {
 #include <openssl/crypto.h>
 #include <openssl/ssl.h>
 #include <openssl/bn.h>
+#include <openssl/ec.h>
 #include <openssl/srtp.h>
 #include <openssl/opensslv.h>
+#include <openssl/pem.h>
+
+#include <fcntl.h>
+#include <unistd.h>
 
 #include <nice/nice.h>
 
@@ -21,20 +26,59 @@ extern "C" {
 #include <cassert>
 #include <string>
 #include <cstring>
+#include <functional>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
 
 #include "./DtlsSocket.h"
 #include "./bf_dwrap.h"
+#include "../SrtpChannel.h"
 
 using dtls::DtlsSocketContext;
 using dtls::DtlsSocket;
 using std::memcpy;
 
+#ifdef SRTP_AEAD_AES_128_GCM
+const char* DtlsSocketContext::DefaultSrtpProfile =
+    "SRTP_AEAD_AES_128_GCM:SRTP_AEAD_AES_256_GCM:SRTP_AES128_CM_SHA1_80";
+#else
 const char* DtlsSocketContext::DefaultSrtpProfile = "SRTP_AES128_CM_SHA1_80";
+#endif
+const char* DtlsSocketContext::NoAeadSrtpProfile = "SRTP_AES128_CM_SHA1_80";
 
 X509 *DtlsSocketContext::mCert = NULL;
 EVP_PKEY *DtlsSocketContext::privkey = NULL;
+SSL_CTX *DtlsSocketContext::mSharedContext = NULL;
+char DtlsSocketContext::mFingerprint[100] = {};
+
+// ECDHE only, ECDSA suites go first as that is what our certificate uses. The RSA ones are there for when we are
+// the client of a peer with an RSA certificate. The SHA ones are the only ones DTLS 1.0 peers understand.
+static const char *kCipherSuites =
+    "ECDHE-ECDSA-AES128-GCM-SHA256:ECDHE-RSA-AES128-GCM-SHA256:"
+    "ECDHE-ECDSA-AES256-GCM-SHA384:ECDHE-RSA-AES256-GCM-SHA384:"
+    "ECDHE-ECDSA-CHACHA20-POLY1305:ECDHE-RSA-CHACHA20-POLY1305:"
+    "ECDHE-ECDSA-AES128-SHA:ECDHE-RSA-AES128-SHA:ECDHE-ECDSA-AES256-SHA:ECDHE-RSA-AES256-SHA";
+
+static std::once_flag init_flag;
+
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+// OpenSSL < 1.1 is only thread safe when the application provides the locks for its shared state
+// (refcounts, the error and session tables, the RNG...)
+static std::vector<std::mutex> *openssl_locks = nullptr;
+
+static void OpenSSLLockingCallback(int mode, int n, const char *file, int line) {
+  if (mode & CRYPTO_LOCK) {
+    (*openssl_locks)[n].lock();
+  } else {
+    (*openssl_locks)[n].unlock();
+  }
+}
 
-static const int KEY_LENGTH = 1024;
+static void OpenSSLThreadIdCallback(CRYPTO_THREADID *id) {
+  CRYPTO_THREADID_set_numeric(id, std::hash<std::thread::id>()(std::this_thread::get_id()));
+}
+#endif
 
 DEFINE_LOGGER(DtlsSocketContext, "dtls.DtlsSocketContext");
 log4cxx::LoggerPtr sslLogger(log4cxx::Logger::getLogger("dtls.SSL"));
@@ -127,30 +171,44 @@ int SSLVerifyCallback(int ok, X509_STORE_CTX* store) {
   return ok;
 }
 
-int createCert(const std::string& pAor, int expireDays, int keyLen, X509*& outCert, EVP_PKEY*& outKey) {  // NOLINT
+int createCert(const std::string& pAor, int expireDays, X509*& outCert, EVP_PKEY*& outKey) {  // NOLINT
   std::ostringstream info;
   info << "Generating new user cert for" << pAor;
   ELOG_DEBUG2(sslLogger, "%s", info.str().c_str());
   std::string aor = "sip:" + pAor;
 
   // Make sure that necessary algorithms exist:
-  assert(EVP_sha1());
-
+  assert(EVP_sha256());
+
+  // ECDSA P-256, as browsers do: generating the key takes milliseconds and signing is much cheaper than with RSA.
+  // Peers only accept named curves, not explicit parameters.
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+  // The EC_KEY functions are deprecated since OpenSSL 3.0
+  EVP_PKEY* privkey = NULL;
+  EVP_PKEY_CTX* key_ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, NULL);
+  assert(key_ctx);
+  int ret = EVP_PKEY_keygen_init(key_ctx);
+  assert(ret > 0);
+  ret = EVP_PKEY_CTX_set_ec_paramgen_curve_nid(key_ctx, NID_X9_62_prime256v1);
+  assert(ret > 0);
+  ret = EVP_PKEY_CTX_set_ec_param_enc(key_ctx, OPENSSL_EC_NAMED_CURVE);
+  assert(ret > 0);
+  ret = EVP_PKEY_keygen(key_ctx, &privkey);
+  assert(ret > 0);    // couldn't make key pair
+  EVP_PKEY_CTX_free(key_ctx);
+#else
   EVP_PKEY* privkey = EVP_PKEY_new();
   assert(privkey);
 
-  RSA* rsa = RSA_new();
-
-  BIGNUM* exponent = BN_new();
-  BN_set_word(exponent, 0x10001);
+  EC_KEY* ec_key = EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
+  assert(ec_key);
+  EC_KEY_set_asn1_flag(ec_key, OPENSSL_EC_NAMED_CURVE);
+  int ret = EC_KEY_generate_key(ec_key);
+  assert(ret);    // couldn't make key pair
 
-  RSA_generate_key_ex(rsa, KEY_LENGTH, exponent, NULL);
-
-  // RSA* rsa = RSA_generate_key(keyLen, RSA_F4, NULL, NULL);
-  assert(rsa);    // couldn't make key pair
-
-  int ret = EVP_PKEY_set1_RSA(privkey, rsa);
+  ret = EVP_PKEY_assign_EC_KEY(privkey, ec_key);
   assert(ret);
+#endif
 
   X509* cert = X509_new();
   assert(cert);
@@ -202,7 +260,7 @@ int createCert(const std::string& pAor, int expireDays, int keyLen, X509*& outCe
 
     // TODO(javier) add extensions NID_subject_key_identifier and NID_authority_key_identifier
 
-    ret = X509_sign(cert, privkey, EVP_sha1());
+    ret = X509_sign(cert, privkey, EVP_sha256());
     assert(ret);
 
     outCert = cert;
@@ -210,40 +268,116 @@ int createCert(const std::string& pAor, int expireDays, int keyLen, X509*& outCe
     return ret;
   }
 
-  // memory is only valid for duration of callback; must be copied if queueing
-  // is required
-  DtlsSocketContext::DtlsSocketContext() {
-    started = false;
-    DtlsSocketContext::Init();
+  // Reads a PEM certificate and its private key, fails if they do not match or the certificate has expired
+  bool loadIdentity(const std::string& cert_file, const std::string& key_file, X509*& outCert, EVP_PKEY*& outKey) {  // NOLINT
+    FILE* file = fopen(cert_file.c_str(), "r");
+    if (file == NULL) {
+      return false;
+    }
+    X509* cert = PEM_read_X509(file, NULL, NULL, NULL);
+    fclose(file);
+    file = fopen(key_file.c_str(), "r");
+    if (file == NULL) {
+      X509_free(cert);
+      return false;
+    }
+    EVP_PKEY* key = PEM_read_PrivateKey(file, NULL, NULL, NULL);
+    fclose(file);
+    if (cert == NULL || key == NULL || X509_check_private_key(cert, key) != 1 ||
+        X509_cmp_current_time(X509_get_notAfter(cert)) <= 0) {
+      ELOG_WARN2(sslLogger, "Could not use DTLS certificate %s with key %s", cert_file.c_str(), key_file.c_str());
+      X509_free(cert);
+      EVP_PKEY_free(key);
+      return false;
+    }
+    outCert = cert;
+    outKey = key;
+    return true;
+  }
 
-    ELOG_DEBUG("Creating Dtls factory, Openssl v %s", OPENSSL_VERSION_TEXT);
+  // Files are written aside and renamed into place, so processes starting at the same time never read half of them
+  bool saveIdentity(const std::string& cert_file, const std::string& key_file, X509* cert, EVP_PKEY* key) {
+    std::string suffix = "." + std::to_string(getpid()) + ".tmp";
+    std::string cert_tmp = cert_file + suffix;
+    std::string key_tmp = key_file + suffix;
+    FILE* file = fopen(cert_tmp.c_str(), "w");
+    if (file == NULL) {
+      return false;
+    }
+    bool written = PEM_write_X509(file, cert) == 1;
+    written = fclose(file) == 0 && written;
+    int fd = open(key_tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    file = fd < 0 ? NULL : fdopen(fd, "w");
+    if (file == NULL) {
+      if (fd >= 0) {
+        ::close(fd);
+      }
+      unlink(cert_tmp.c_str());
+      return false;
+    }
+    written = PEM_write_PrivateKey(file, key, NULL, NULL, 0, NULL, NULL) == 1 && written;
+    written = fclose(file) == 0 && written;
+    if (!written || rename(key_tmp.c_str(), key_file.c_str()) != 0 ||
+        rename(cert_tmp.c_str(), cert_file.c_str()) != 0) {
+      unlink(cert_tmp.c_str());
+      unlink(key_tmp.c_str());
+      return false;
+    }
+    return true;
+  }
 
-    mContext = SSL_CTX_new(DTLSv1_method());
-    assert(mContext);
+  SSL_CTX* createSSLContext(X509 *cert, EVP_PKEY *key) {
+#if OPENSSL_VERSION_NUMBER >= 0x10002000L
+    // Negotiates DTLS 1.2, and 1.0 with peers that do not support it
+    SSL_CTX* context = SSL_CTX_new(DTLS_method());
+#else
+    SSL_CTX* context = SSL_CTX_new(DTLSv1_method());
+#endif
+    assert(context);
 
-    int r = SSL_CTX_use_certificate(mContext, mCert);
+    int r = SSL_CTX_use_certificate(context, cert);
     assert(r == 1);
 
-    r = SSL_CTX_use_PrivateKey(mContext, privkey);
+    r = SSL_CTX_use_PrivateKey(context, key);
     assert(r == 1);
 
-    SSL_CTX_set_cipher_list(mContext, "ALL:!ADH:!LOW:!EXP:!MD5:@STRENGTH");
+    r = SSL_CTX_set_cipher_list(context, kCipherSuites);
+    assert(r == 1);
 
-    SSL_CTX_set_info_callback(mContext, SSLInfoCallback);
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+    // ECDHE is always available
+#elif OPENSSL_VERSION_NUMBER >= 0x10002000L
+    SSL_CTX_set_ecdh_auto(context, 1);
+#else
+    EC_KEY* ecdh = EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
+    SSL_CTX_set_tmp_ecdh(context, ecdh);
+    EC_KEY_free(ecdh);
+#endif
 
-    SSL_CTX_set_verify(mContext, SSL_VERIFY_PEER |SSL_VERIFY_FAIL_IF_NO_PEER_CERT,
+    SSL_CTX_set_info_callback(context, SSLInfoCallback);
+
+    SSL_CTX_set_verify(context, SSL_VERIFY_PEER |SSL_VERIFY_FAIL_IF_NO_PEER_CERT,
       SSLVerifyCallback);
 
-    SSL_CTX_set_options(mContext, SSL_OP_NO_QUERY_MTU);
-      // SSL_CTX_set_session_cache_mode(mContext, SSL_SESS_CACHE_OFF);
-      // SSL_CTX_set_options(mContext, SSL_OP_NO_TICKET);
-      // Set SRTP profiles
-    r = SSL_CTX_set_tlsext_use_srtp(mContext, DefaultSrtpProfile);
+    SSL_CTX_set_options(context, SSL_OP_NO_QUERY_MTU | SSL_OP_NO_TICKET);
+    // DTLS-SRTP sessions are never resumed, and with a shared context the cache would only grow
+    SSL_CTX_set_session_cache_mode(context, SSL_SESS_CACHE_OFF);
+    // Set SRTP profiles, as server OpenSSL picks the first one in this list that the client offers
+    r = SSL_CTX_set_tlsext_use_srtp(context,
+                                    erizo::SrtpChannel::isAeadSupported() ? DtlsSocketContext::DefaultSrtpProfile
+                                                                          : DtlsSocketContext::NoAeadSrtpProfile);
     assert(r == 0);
 
-    SSL_CTX_set_verify_depth(mContext, 2);
-    SSL_CTX_set_read_ahead(mContext, 1);
+    SSL_CTX_set_verify_depth(context, 2);
+    SSL_CTX_set_read_ahead(context, 1);
+    return context;
+  }
 
+  // memory is only valid for duration of callback; must be copied if queueing
+  // is required
+  DtlsSocketContext::DtlsSocketContext() {
+    started = false;
+    DtlsSocketContext::Init();
     ELOG_DEBUG("DtlsSocketContext created");
   }
 
@@ -251,21 +385,45 @@ int createCert(const std::string& pAor, int expireDays, int keyLen, X509*& outCe
       mSocket->close();
       delete mSocket;
       mSocket = NULL;
-      SSL_CTX_free(mContext);
     }
 
     void DtlsSocketContext::close() {
       mSocket->close();
     }
 
-    void DtlsSocketContext::Init() {
-      if (DtlsSocketContext::mCert == NULL) {
+    void DtlsSocketContext::Init(const std::string& cert_file, const std::string& key_file) {
+      // Contexts are created from many workers at once
+      std::call_once(init_flag, [&cert_file, &key_file]() {
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+        openssl_locks = new std::vector<std::mutex>(CRYPTO_num_locks());
+        CRYPTO_THREADID_set_callback(OpenSSLThreadIdCallback);
+        CRYPTO_set_locking_callback(OpenSSLLockingCallback);
+#endif
         OpenSSL_add_all_algorithms();
         SSL_library_init();
         SSL_load_error_strings();
         ERR_load_crypto_strings();
-        createCert("sip:licode@lynckia.com", 365, 1024, DtlsSocketContext::mCert, DtlsSocketContext::privkey);
-      }
+        bool use_files = !cert_file.empty() && !key_file.empty();
+        if (use_files && loadIdentity(cert_file, key_file, DtlsSocketContext::mCert, DtlsSocketContext::privkey)) {
+          ELOG_INFO("Loaded DTLS certificate from %s", cert_file.c_str());
+        } else {
+          createCert("sip:licode@lynckia.com", 365, DtlsSocketContext::mCert, DtlsSocketContext::privkey);
+          if (use_files && !saveIdentity(cert_file, key_file, DtlsSocketContext::mCert, DtlsSocketContext::privkey)) {
+            ELOG_WARN("Could not save DTLS certificate to %s", cert_file.c_str());
+          }
+        }
+        DtlsSocket::computeFingerprint(DtlsSocketContext::mCert, DtlsSocketContext::mFingerprint);
+        // A single context for every socket, SSL objects only take a reference to it
+        ELOG_DEBUG("Creating Dtls factory, Openssl v %s", OPENSSL_VERSION_TEXT);
+        DtlsSocketContext::mSharedContext = createSSLContext(DtlsSocketContext::mCert, DtlsSocketContext::privkey);
+      });
+    }
+
+    void DtlsSocketContext::Preload(const std::string& cert_file, const std::string& key_file) {
+      // The thread owns its copy of the paths, the caller's strings may be gone by the time it runs
+      std::thread([cert_file, key_file]() {
+        DtlsSocketContext::Init(cert_file, key_file);
+      }).detach();
     }
 
     DtlsSocket* DtlsSocketContext::createClient() {
@@ -278,21 +436,31 @@ int createCert(const std::string& pAor, int expireDays, int keyLen, X509*& outCe
     }
 
     void DtlsSocketContext::getMyCertFingerprint(char *fingerprint) {
-      DtlsSocket::computeFingerprint(DtlsSocketContext::mCert, fingerprint);
+      memcpy(fingerprint, mFingerprint, strlen(mFingerprint) + 1);
     }
 
     void DtlsSocketContext::setSrtpProfiles(const char *str) {
-      int r = SSL_CTX_set_tlsext_use_srtp(mContext, str);
-      assert(r == 0);
+      mSocket->setSrtpProfiles(str);
     }
 
     void DtlsSocketContext::setCipherSuites(const char *str) {
-      int r = SSL_CTX_set_cipher_list(mContext, str);
-      assert(r == 1);
+      mSocket->setCipherSuites(str);
     }
 
     SSL_CTX* DtlsSocketContext::getSSLContext() {
-      return mContext;
+      return mSharedContext;
+    }
+
+    uint64_t DtlsSocketContext::getHandshakeCpuUs() {
+      return mSocket->getHandshakeCpuUs();
+    }
+
+    uint64_t DtlsSocketContext::getHandshakeDurationMs() {
+      return mSocket->getHandshakeDurationMs();
+    }
+
+    std::string DtlsSocketContext::getVersion() {
+      return mSocket->getVersion();
     }
 
     DtlsSocketContext::PacketType DtlsSocketContext::demuxPacket(const unsigned char *data, unsigned int len) {
@@ -310,9 +478,7 @@ int createCert(const std::string& pAor, int expireDays, int keyLen, X509*& outCe
 
 
     std::string DtlsSocketContext::getFingerprint() const {
-      char fprint[100] = {};
-      mSocket->getMyCertFingerprint(fprint);
-      return std::string(fprint);
+      return std::string(mFingerprint);
     }
 
     void DtlsSocketContext::start() {
@@ -383,7 +549,7 @@ int createCert(const std::string& pAor, int expireDays, int keyLen, X509*& outCe
         }
 
         if (receiver != NULL) {
-          receiver->onHandshakeCompleted(this, clientKey, serverKey, srtp_profile->name);
+          receiver->onHandshakeCompleted(this, clientKey, serverKey, srtp_profile ? srtp_profile->name : "");
         }
       } else {
         ELOG_DEBUG("Peer did not authenticate");
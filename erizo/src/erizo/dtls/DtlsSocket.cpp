@@ -1,8 +1,11 @@
 #include "dtls/DtlsSocket.h"
 
+#include <time.h>
+
 #include <iostream>
 #include <cassert>
 #include <cstring>
+#include <memory>
 #include <string>
 
 #ifdef HAVE_CONFIG_H
@@ -21,10 +24,19 @@ int dummy_cb(int d, X509_STORE_CTX *x) {
   return 1;
 }
 
+static uint64_t threadCpuTimeUs() {
+  struct timespec now;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+  return static_cast<uint64_t>(now.tv_sec) * 1000000 + now.tv_nsec / 1000;
+}
+
 DtlsSocket::DtlsSocket(DtlsSocketContext* socketContext, enum SocketType type):
               mSocketContext(socketContext),
               mSocketType(type),
-              mHandshakeCompleted(false) {
+              mHandshakeCompleted(false),
+              mHandshakeStarted(false),
+              mHandshakeCpuUs(0),
+              mHandshakeDurationMs(0) {
   ELOG_DEBUG("Creating Dtls Socket");
   mSocketContext->setDtlsSocket(this);
   SSL_CTX* mContext = mSocketContext->getSSLContext();
@@ -32,8 +44,6 @@ DtlsSocket::DtlsSocket(DtlsSocketContext* socketContext, enum SocketType type):
   mSsl = SSL_new(mContext);
   assert(mSsl != 0);
   SSL_set_mtu(mSsl, DTLS_MTU);
-  mSsl->ctx = mContext;
-  mSsl->session_ctx = mContext;
 
   switch (type) {
     case Client:
@@ -67,6 +77,7 @@ DtlsSocket::~DtlsSocket() {
 
 void DtlsSocket::close() {
   // Properly shutdown the socket and free it - note: this also free's the BIO's
+  boost::mutex::scoped_lock lock(handshakeMutex_);
   if (mSsl != NULL) {
     ELOG_DEBUG("SSL Shutdown");
     SSL_shutdown(mSsl);
@@ -77,6 +88,7 @@ void DtlsSocket::close() {
 
 void DtlsSocket::startClient() {
   assert(mSocketType == Client);
+  boost::mutex::scoped_lock lock(handshakeMutex_);
   doHandshakeIteration();
 }
 
@@ -91,6 +103,7 @@ bool DtlsSocket::handlePacketMaybe(const unsigned char* bytes, unsigned int len)
     return false;
   }
 
+  boost::mutex::scoped_lock lock(handshakeMutex_);
   if (mSsl == nullptr) {
     return false;
   }
@@ -111,6 +124,7 @@ bool DtlsSocket::handlePacketMaybe(const unsigned char* bytes, unsigned int len)
 }
 
 void DtlsSocket::forceRetransmit() {
+  boost::mutex::scoped_lock lock(handshakeMutex_);
   (void) BIO_reset(mInBio);
   (void) BIO_reset(mOutBio);
   BIO_ctrl(mInBio, BIO_CTRL_DGRAM_SET_RECV_TIMEOUT, 0, 0);
@@ -119,14 +133,19 @@ void DtlsSocket::forceRetransmit() {
 }
 
 void DtlsSocket::doHandshakeIteration() {
-  boost::mutex::scoped_lock lock(handshakeMutex_);
   char errbuf[1024];
   int sslerr;
 
-  if (mHandshakeCompleted)
+  if (mHandshakeCompleted || mSsl == NULL)
   return;
 
+  if (!mHandshakeStarted) {
+    mHandshakeStarted = true;
+    mHandshakeStart = std::chrono::steady_clock::now();
+  }
+  uint64_t cpu_start_us = threadCpuTimeUs();
   int r = SSL_do_handshake(mSsl);
+  mHandshakeCpuUs += threadCpuTimeUs() - cpu_start_us;
   errbuf[0] = 0;
   ERR_error_string_n(ERR_peek_error(), errbuf, sizeof(errbuf));
 
@@ -142,6 +161,8 @@ void DtlsSocket::doHandshakeIteration() {
   switch (sslerr = SSL_get_error(mSsl, r)) {
     case SSL_ERROR_NONE:
       mHandshakeCompleted = true;
+      mHandshakeDurationMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - mHandshakeStart).count();
       mSocketContext->handshakeCompleted();
       break;
     case SSL_ERROR_WANT_READ:
@@ -198,29 +219,65 @@ SrtpSessionKeys* DtlsSocket::getSrtpSessionKeys() {
 
   SrtpSessionKeys* keys = new SrtpSessionKeys();
 
-  unsigned char material[SRTP_MASTER_KEY_LEN << 1];
-  if (!SSL_export_keying_material(mSsl, material, sizeof(material), "EXTRACTOR-dtls_srtp", 19, NULL, 0, 0)) {
+  // Key and salt lengths depend on the negotiated profile (RFC 5764 section 4.2)
+  srtp_profile_t profile;
+  if (!toSrtpProfile(getSrtpProfile(), &profile)) {
+    return keys;
+  }
+  int key_len = srtp_profile_get_master_key_length(profile);
+  int salt_len = srtp_profile_get_master_salt_length(profile);
+  if (key_len > SRTP_MAX_MASTER_KEY_KEY_LEN || salt_len > SRTP_MAX_MASTER_KEY_SALT_LEN) {
+    return keys;
+  }
+
+  unsigned char material[(SRTP_MAX_MASTER_KEY_KEY_LEN + SRTP_MAX_MASTER_KEY_SALT_LEN) << 1];
+  size_t material_len = (key_len + salt_len) << 1;
+  if (!SSL_export_keying_material(mSsl, material, material_len, "EXTRACTOR-dtls_srtp", 19, NULL, 0, 0)) {
     return keys;
   }
 
   size_t offset = 0;
 
-  memcpy(keys->clientMasterKey, &material[offset], SRTP_MASTER_KEY_KEY_LEN);
-  offset += SRTP_MASTER_KEY_KEY_LEN;
-  memcpy(keys->serverMasterKey, &material[offset], SRTP_MASTER_KEY_KEY_LEN);
-  offset += SRTP_MASTER_KEY_KEY_LEN;
-  memcpy(keys->clientMasterSalt, &material[offset], SRTP_MASTER_KEY_SALT_LEN);
-  offset += SRTP_MASTER_KEY_SALT_LEN;
-  memcpy(keys->serverMasterSalt, &material[offset], SRTP_MASTER_KEY_SALT_LEN);
-  offset += SRTP_MASTER_KEY_SALT_LEN;
-  keys->clientMasterKeyLen = SRTP_MASTER_KEY_KEY_LEN;
-  keys->serverMasterKeyLen = SRTP_MASTER_KEY_KEY_LEN;
-  keys->clientMasterSaltLen = SRTP_MASTER_KEY_SALT_LEN;
-  keys->serverMasterSaltLen = SRTP_MASTER_KEY_SALT_LEN;
+  memcpy(keys->clientMasterKey, &material[offset], key_len);
+  offset += key_len;
+  memcpy(keys->serverMasterKey, &material[offset], key_len);
+  offset += key_len;
+  memcpy(keys->clientMasterSalt, &material[offset], salt_len);
+  offset += salt_len;
+  memcpy(keys->serverMasterSalt, &material[offset], salt_len);
+  offset += salt_len;
+  keys->clientMasterKeyLen = key_len;
+  keys->serverMasterKeyLen = key_len;
+  keys->clientMasterSaltLen = salt_len;
+  keys->serverMasterSaltLen = salt_len;
 
   return keys;
 }
 
+bool DtlsSocket::toSrtpProfile(const SRTP_PROTECTION_PROFILE* profile, srtp_profile_t* srtp_profile) {
+  if (profile == NULL) {
+    return false;
+  }
+  switch (profile->id) {
+    case SRTP_AES128_CM_SHA1_80:
+      *srtp_profile = srtp_profile_aes128_cm_sha1_80;
+      return true;
+    case SRTP_AES128_CM_SHA1_32:
+      *srtp_profile = srtp_profile_aes128_cm_sha1_32;
+      return true;
+#ifdef SRTP_AEAD_AES_128_GCM
+    case SRTP_AEAD_AES_128_GCM:
+      *srtp_profile = srtp_profile_aead_aes_128_gcm;
+      return true;
+    case SRTP_AEAD_AES_256_GCM:
+      *srtp_profile = srtp_profile_aead_aes_256_gcm;
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
 SRTP_PROTECTION_PROFILE* DtlsSocket::getSrtpProfile() {
   // TODO(pedro): probably an exception candidate
   assert(mHandshakeCompleted);
@@ -251,6 +308,10 @@ void DtlsSocket::computeFingerprint(X509 *cert, char *fingerprint) {
 }
 
 void DtlsSocket::handleTimeout() {
+  boost::mutex::scoped_lock lock(handshakeMutex_);
+  if (mSsl == NULL || mHandshakeCompleted) {
+    return;
+  }
   (void) BIO_reset(mInBio);
   (void) BIO_reset(mOutBio);
   if (DTLSv1_handle_timeout(mSsl) > 0) {
@@ -272,18 +333,41 @@ void DtlsSocket::handleTimeout() {
   }
 }
 
-// TODO(pedro): assert(0) into exception, as elsewhere
-void DtlsSocket::createSrtpSessionPolicies(srtp_policy_t& outboundPolicy, srtp_policy_t& inboundPolicy) {
+void DtlsSocket::setSrtpProfiles(const char *str) {
+  boost::mutex::scoped_lock lock(handshakeMutex_);
+  int r = SSL_set_tlsext_use_srtp(mSsl, str);
+  assert(r == 0);
+}
+
+void DtlsSocket::setCipherSuites(const char *str) {
+  boost::mutex::scoped_lock lock(handshakeMutex_);
+  int r = SSL_set_cipher_list(mSsl, str);
+  assert(r == 1);
+}
+
+uint64_t DtlsSocket::getHandshakeCpuUs() {
+  return mHandshakeCpuUs;
+}
+
+uint64_t DtlsSocket::getHandshakeDurationMs() {
+  return mHandshakeDurationMs;
+}
+
+std::string DtlsSocket::getVersion() {
+  return mSsl ? SSL_get_version(mSsl) : "";
+}
+
+bool DtlsSocket::createSrtpSessionPolicies(srtp_policy_t& outboundPolicy, srtp_policy_t& inboundPolicy) {
   assert(mHandshakeCompleted);
 
-  /* we assume that the default profile is in effect, for now */
   srtp_profile_t profile = srtp_profile_aes128_cm_sha1_80;
+  if (!toSrtpProfile(getSrtpProfile(), &profile)) {
+    ELOG_WARN("error: unknown SRTP profile negotiated");
+    return false;
+  }
   int key_len = srtp_profile_get_master_key_length(profile);
   int salt_len = srtp_profile_get_master_salt_length(profile);
 
-  /* get keys from srtp_key and initialize the inbound and outbound sessions */
-  uint8_t *client_master_key_and_salt = new uint8_t[SRTP_MAX_KEY_LEN];
-  uint8_t *server_master_key_and_salt = new uint8_t[SRTP_MAX_KEY_LEN];
   srtp_policy_t client_policy;
   memset(&client_policy, 0, sizeof(srtp_policy_t));
   client_policy.window_size = 128;
@@ -293,53 +377,48 @@ void DtlsSocket::createSrtpSessionPolicies(srtp_policy_t& outboundPolicy, srtp_p
   server_policy.window_size = 128;
   server_policy.allow_repeat_tx = 1;
 
-  SrtpSessionKeys* srtp_key = getSrtpSessionKeys();
-  /* set client_write key */
-  client_policy.key = client_master_key_and_salt;
+  /* initialize client and server SRTP policies from profile  */
+  if (srtp_crypto_policy_set_from_profile_for_rtp(&client_policy.rtp, profile) ||
+      srtp_crypto_policy_set_from_profile_for_rtcp(&client_policy.rtcp, profile) ||
+      srtp_crypto_policy_set_from_profile_for_rtp(&server_policy.rtp, profile) ||
+      srtp_crypto_policy_set_from_profile_for_rtcp(&server_policy.rtcp, profile)) {
+    ELOG_WARN("error: could not set SRTP policy from profile");
+    return false;
+  }
+  client_policy.next = NULL;
+  server_policy.next = NULL;
+
+  std::unique_ptr<SrtpSessionKeys> srtp_key(getSrtpSessionKeys());
   if (srtp_key->clientMasterKeyLen != key_len) {
     ELOG_WARN("error: unexpected client key length");
-    assert(0);
+    return false;
   }
   if (srtp_key->clientMasterSaltLen != salt_len) {
     ELOG_WARN("error: unexpected client salt length");
-    assert(0);
+    return false;
   }
-
-  memcpy(client_master_key_and_salt, srtp_key->clientMasterKey, key_len);
-  memcpy(client_master_key_and_salt + key_len, srtp_key->clientMasterSalt, salt_len);
-
-  /* initialize client SRTP policy from profile  */
-  srtp_err_status_t err = srtp_crypto_policy_set_from_profile_for_rtp(&client_policy.rtp, profile);
-  if (err) assert(0);
-
-  err = srtp_crypto_policy_set_from_profile_for_rtcp(&client_policy.rtcp, profile);
-  if (err) assert(0);
-  client_policy.next = NULL;
-
-  /* set server_write key */
-  server_policy.key = server_master_key_and_salt;
-
   if (srtp_key->serverMasterKeyLen != key_len) {
     ELOG_WARN("error: unexpected server key length");
-    assert(0);
+    return false;
   }
   if (srtp_key->serverMasterSaltLen != salt_len) {
     ELOG_WARN("error: unexpected salt length");
-    assert(0);
+    return false;
   }
 
-  memcpy(server_master_key_and_salt, srtp_key->serverMasterKey, key_len);
-  memcpy(server_master_key_and_salt + key_len, srtp_key->serverMasterSalt, salt_len);
-
-  delete srtp_key;
+  /* get keys from srtp_key and initialize the inbound and outbound sessions */
+  uint8_t *client_master_key_and_salt = new uint8_t[SRTP_MAX_KEY_LEN];
+  uint8_t *server_master_key_and_salt = new uint8_t[SRTP_MAX_KEY_LEN];
 
-  /* initialize server SRTP policy from profile  */
-  err = srtp_crypto_policy_set_from_profile_for_rtp(&server_policy.rtp, profile);
-  if (err) assert(0);
+  /* set client_write key */
+  client_policy.key = client_master_key_and_salt;
+  memcpy(client_master_key_and_salt, srtp_key->clientMasterKey, key_len);
+  memcpy(client_master_key_and_salt + key_len, srtp_key->clientMasterSalt, salt_len);
 
-  err = srtp_crypto_policy_set_from_profile_for_rtcp(&server_policy.rtcp, profile);
-  if (err) assert(0);
-  server_policy.next = NULL;
+  /* set server_write key */
+  server_policy.key = server_master_key_and_salt;
+  memcpy(server_master_key_and_salt, srtp_key->serverMasterKey, key_len);
+  memcpy(server_master_key_and_salt + key_len, srtp_key->serverMasterSalt, salt_len);
 
   if (mSocketType == Client) {
     client_policy.ssrc.type = ssrc_any_outbound;
@@ -358,7 +437,7 @@ void DtlsSocket::createSrtpSessionPolicies(srtp_policy_t& outboundPolicy, srtp_p
   // not done...not much of a security whole imho...the lifetime of these seems odd though
   //    memset(client_master_key_and_salt, 0x00, SRTP_MAX_KEY_LEN);
   //    memset(server_master_key_and_salt, 0x00, SRTP_MAX_KEY_LEN);
-  //    memset(&srtp_key, 0x00, sizeof(srtp_key));
+  return true;
 }
 
   /* ====================================================================
@@ -14,6 +14,7 @@ extern "C" {
 #include <boost/thread/mutex.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <chrono>  // NOLINT
 #include <memory>
 #include <string>
 
@@ -21,6 +22,9 @@ extern "C" {
 
 const int SRTP_MASTER_KEY_KEY_LEN = 16;
 const int SRTP_MASTER_KEY_SALT_LEN = 14;
+// AEAD_AES_256_GCM has the longest keys and the AES_CM profiles the longest salts
+const int SRTP_MAX_MASTER_KEY_KEY_LEN = 32;
+const int SRTP_MAX_MASTER_KEY_SALT_LEN = 14;
 static const int DTLS_MTU = 1472;
 
 namespace dtls {
@@ -29,13 +33,13 @@ class DtlsSocketContext;
 class SrtpSessionKeys {
  public:
   SrtpSessionKeys() {
-    clientMasterKey = new unsigned char[SRTP_MASTER_KEY_KEY_LEN];
+    clientMasterKey = new unsigned char[SRTP_MAX_MASTER_KEY_KEY_LEN];
     clientMasterKeyLen = 0;
-    clientMasterSalt = new unsigned char[SRTP_MASTER_KEY_SALT_LEN];
+    clientMasterSalt = new unsigned char[SRTP_MAX_MASTER_KEY_SALT_LEN];
     clientMasterSaltLen = 0;
-    serverMasterKey = new unsigned char[SRTP_MASTER_KEY_KEY_LEN];
+    serverMasterKey = new unsigned char[SRTP_MAX_MASTER_KEY_KEY_LEN];
     serverMasterKeyLen = 0;
-    serverMasterSalt = new unsigned char[SRTP_MASTER_KEY_SALT_LEN];
+    serverMasterSalt = new unsigned char[SRTP_MAX_MASTER_KEY_SALT_LEN];
     serverMasterSaltLen = 0;
   }
   ~SrtpSessionKeys() {
@@ -99,18 +103,34 @@ class DtlsSocket {
   // Retrieves the DTLS negotiated SRTP profile - may return 0 if profile selection failed
   SRTP_PROTECTION_PROFILE* getSrtpProfile();
 
+  // Maps a DTLS-SRTP profile to the libsrtp one, returns false for profiles we do not know about
+  static bool toSrtpProfile(const SRTP_PROTECTION_PROFILE* profile, srtp_profile_t* srtp_profile);
+
   // Creates SRTP session policies appropriately based on socket type (client vs server) and keys
-  // extracted from the DTLS handshake process
-  void createSrtpSessionPolicies(srtp_policy_t& outboundPolicy, srtp_policy_t& inboundPolicy);  // NOLINT
+  // extracted from the DTLS handshake process, returns false if the negotiated profile or keys are not usable
+  bool createSrtpSessionPolicies(srtp_policy_t& outboundPolicy, srtp_policy_t& inboundPolicy);  // NOLINT
 
   void handleTimeout();
 
+  // Overrides the SRTP profiles and cipher suites of the shared context for this socket only
+  void setSrtpProfiles(const char *policyStr);
+  void setCipherSuites(const char *cipherSuites);
+
+  // CPU time spent in the handshake and time from its first flight to completion. These do not lock, so they are
+  // meant to be read from the handshake completed callback or once it has been called
+  uint64_t getHandshakeCpuUs();
+  uint64_t getHandshakeDurationMs();
+
+  // The negotiated protocol version, e.g. DTLSv1.2, same as above
+  std::string getVersion();
+
  private:
   // Causes an immediate handshake iteration to happen, which will retransmit the handshake
   void forceRetransmit();
 
 
   // Give CPU cyces to the handshake process - checks current state and acts appropraitely
+  // Callers must hold handshakeMutex_
   void doHandshakeIteration();
 
   // Internals
@@ -123,6 +143,11 @@ class DtlsSocket {
 
   SocketType mSocketType;
   bool mHandshakeCompleted;
+  bool mHandshakeStarted;
+  std::chrono::steady_clock::time_point mHandshakeStart;
+  uint64_t mHandshakeCpuUs;
+  uint64_t mHandshakeDurationMs;
+  // Serializes everything touching mSsl and its BIOs, so sockets never need a lock shared with others
   boost::mutex handshakeMutex_;
 };
 
@@ -153,6 +178,7 @@ class DtlsSocketContext {
   void handshakeFailed(const char *err);
   void setDtlsReceiver(DtlsReceiver *recv);
   void setDtlsSocket(DtlsSocket *sock) {mSocket = sock;}
+  // Computed once with the certificate, so this is only a copy
   std::string getFingerprint() const;
 
   void handleTimeout();
@@ -169,32 +195,47 @@ class DtlsSocketContext {
   // Returns the fingerprint of the user cert that was passed into the constructor
   void getMyCertFingerprint(char *fingerprint);
 
-  // The default SrtpProfile used at construction time (default is: SRTP_AES128_CM_SHA1_80:SRTP_AES128_CM_SHA1_32)
+  // The SRTP profiles offered at construction time, in order of preference. The AES-GCM ones go first
+  // (default is: SRTP_AEAD_AES_128_GCM:SRTP_AEAD_AES_256_GCM:SRTP_AES128_CM_SHA1_80)
   static const char* DefaultSrtpProfile;
 
-  // Changes the default SRTP profiles supported (default is: SRTP_AES128_CM_SHA1_80:SRTP_AES128_CM_SHA1_32)
+  // The profiles offered instead when libsrtp was built without AES-GCM support
+  static const char* NoAeadSrtpProfile;
+
+  // Changes the SRTP profiles supported (default is DefaultSrtpProfile), once the socket has been created
   void setSrtpProfiles(const char *policyStr);
 
-  // Changes the default DTLS Cipher Suites supported
+  // Changes the default DTLS Cipher Suites supported, once the socket has been created
   void setCipherSuites(const char *cipherSuites);
 
   SSL_CTX* getSSLContext();
 
+  // Handshake cost and outcome, see DtlsSocket
+  uint64_t getHandshakeCpuUs();
+  uint64_t getHandshakeDurationMs();
+  std::string getVersion();
+
   // Examines the first few bits of a packet to determine its type: rtp, dtls, stun or unknown
   static PacketType demuxPacket(const unsigned char *buf, unsigned int len);
 
   static X509 *mCert;
   static EVP_PKEY *privkey;
+  static char mFingerprint[100];
+  // DTLS context with the certificate, key, ciphers and SRTP profiles, shared by every socket in the process
+  static SSL_CTX *mSharedContext;
+
+  // Sets up OpenSSL and the certificate of the process. Only the first call does anything, the others wait for it,
+  // so only its cert_file and key_file are used.
+  static void Init(const std::string& cert_file = "", const std::string& key_file = "");
 
-  static void Init();
+  // Runs Init in a background thread at process start, so the first connection does not wait for the certificate.
+  // The certificate and key are loaded from cert_file and key_file, or generated and saved there for the next
+  // processes. Must be called before any context is created.
+  static void Preload(const std::string& cert_file = "", const std::string& key_file = "");
 
  protected:
   DtlsSocket *mSocket;
   DtlsReceiver *receiver;
-
- private:
-  // Creates a DTLS SSL Context and enables srtp extension, also sets the private and public key cert
-  SSL_CTX* mContext;
 };
 }  // namespace dtls
 
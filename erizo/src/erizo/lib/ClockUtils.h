@@ -16,6 +16,10 @@ class ClockUtils {
   static inline uint64_t timePointToMs(erizo::time_point time_point) {
     return std::chrono::duration_cast<std::chrono::milliseconds>(time_point.time_since_epoch()).count();
   }
+
+  static inline uint64_t timePointToUs(erizo::time_point time_point) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(time_point.time_since_epoch()).count();
+  }
 };
 
 }  // namespace erizo
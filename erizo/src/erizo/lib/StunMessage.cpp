@@ -0,0 +1,198 @@
+#include "lib/StunMessage.h"
+
+#include <arpa/inet.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+
+#include <cstring>
+#include <string>
+
+namespace erizo {
+
+constexpr uint16_t StunMessage::kBindingRequest;
+constexpr uint16_t StunMessage::kBindingSuccessResponse;
+constexpr uint32_t StunMessage::kMagicCookie;
+constexpr int StunMessage::kHeaderLength;
+
+static constexpr uint32_t kFingerprintXor = 0x5354554e;
+static constexpr int kAttributeHeaderLength = 4;
+static constexpr int kHmacLength = 20;
+
+static inline uint16_t readUint16(const char* buf) {
+  uint16_t value;
+  memcpy(&value, buf, sizeof(value));
+  return ntohs(value);
+}
+
+static inline uint32_t readUint32(const char* buf) {
+  uint32_t value;
+  memcpy(&value, buf, sizeof(value));
+  return ntohl(value);
+}
+
+static inline void writeUint16(char* buf, uint16_t value) {
+  value = htons(value);
+  memcpy(buf, &value, sizeof(value));
+}
+
+static inline void writeUint32(char* buf, uint32_t value) {
+  value = htonl(value);
+  memcpy(buf, &value, sizeof(value));
+}
+
+StunMessage::StunMessage()
+    : type_{0}, priority_{0}, use_candidate_{false}, integrity_offset_{-1}, fingerprint_offset_{-1} {
+}
+
+bool StunMessage::isStun(const char* buf, int len) {
+  if (len < kHeaderLength || (len & 0x3) != 0) {
+    return false;
+  }
+  // RFC 7983: STUN first byte is in [0..3]
+  if (static_cast<unsigned char>(buf[0]) > 3) {
+    return false;
+  }
+  return readUint32(buf + 4) == kMagicCookie && readUint16(buf + 2) + kHeaderLength == len;
+}
+
+bool StunMessage::parse(const char* buf, int len) {
+  if (!isStun(buf, len)) {
+    return false;
+  }
+  raw_.assign(buf, len);
+  type_ = readUint16(buf);
+  transaction_id_.assign(buf + 8, 12);
+  username_.clear();
+  priority_ = 0;
+  use_candidate_ = false;
+  integrity_offset_ = -1;
+  fingerprint_offset_ = -1;
+
+  int offset = kHeaderLength;
+  while (offset + kAttributeHeaderLength <= len) {
+    uint16_t attr_type = readUint16(buf + offset);
+    uint16_t attr_length = readUint16(buf + offset + 2);
+    const char* value = buf + offset + kAttributeHeaderLength;
+    if (offset + kAttributeHeaderLength + attr_length > len) {
+      return false;
+    }
+    // Only FINGERPRINT may follow MESSAGE-INTEGRITY
+    if (integrity_offset_ < 0 || attr_type == kAttrFingerprint) {
+      switch (attr_type) {
+        case kAttrUsername:
+          username_.assign(value, attr_length);
+          break;
+        case kAttrPriority:
+          if (attr_length == 4) {
+            priority_ = readUint32(value);
+          }
+          break;
+        case kAttrUseCandidate:
+          use_candidate_ = true;
+          break;
+        case kAttrMessageIntegrity:
+          if (attr_length != kHmacLength) {
+            return false;
+          }
+          integrity_offset_ = offset;
+          break;
+        case kAttrFingerprint:
+          if (attr_length != 4) {
+            return false;
+          }
+          fingerprint_offset_ = offset;
+          break;
+        default:
+          break;
+      }
+    }
+    offset += kAttributeHeaderLength + ((attr_length + 3) & ~0x3);
+  }
+  return true;
+}
+
+std::string StunMessage::getLocalUfrag() const {
+  return username_.substr(0, username_.find(':'));
+}
+
+bool StunMessage::checkIntegrity(const std::string& password) const {
+  if (integrity_offset_ < 0) {
+    return false;
+  }
+  // The HMAC covers everything before the attribute, with the header length pointing at its end
+  std::string signed_part = raw_.substr(0, integrity_offset_);
+  writeUint16(&signed_part[2], integrity_offset_ + kAttributeHeaderLength + kHmacLength - kHeaderLength);
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  unsigned int digest_length = 0;
+  HMAC(EVP_sha1(), password.data(), password.size(),
+       reinterpret_cast<const unsigned char*>(signed_part.data()), signed_part.size(), digest, &digest_length);
+  return digest_length == kHmacLength &&
+         memcmp(digest, raw_.data() + integrity_offset_ + kAttributeHeaderLength, kHmacLength) == 0;
+}
+
+bool StunMessage::checkFingerprint() const {
+  if (fingerprint_offset_ < 0) {
+    return false;
+  }
+  uint32_t crc = crc32(reinterpret_cast<const unsigned char*>(raw_.data()), fingerprint_offset_) ^ kFingerprintXor;
+  return crc == readUint32(raw_.data() + fingerprint_offset_ + kAttributeHeaderLength);
+}
+
+int StunMessage::buildBindingResponse(const sockaddr_in& mapped, const std::string& password,
+                                      char* out, int max_len) const {
+  const int xor_length = kAttributeHeaderLength + 8;
+  const int total_length = kHeaderLength + xor_length + kAttributeHeaderLength + kHmacLength +
+                           kAttributeHeaderLength + 4;
+  if (max_len < total_length || transaction_id_.size() != 12) {
+    return -1;
+  }
+  memset(out, 0, total_length);
+  writeUint16(out, kBindingSuccessResponse);
+  writeUint32(out + 4, kMagicCookie);
+  memcpy(out + 8, transaction_id_.data(), 12);
+
+  int offset = kHeaderLength;
+  writeUint16(out + offset, kAttrXorMappedAddress);
+  writeUint16(out + offset + 2, 8);
+  out[offset + 5] = 0x01;  // IPv4 family
+  writeUint16(out + offset + 6, ntohs(mapped.sin_port) ^ (kMagicCookie >> 16));
+  writeUint32(out + offset + 8, ntohl(mapped.sin_addr.s_addr) ^ kMagicCookie);
+  offset += xor_length;
+
+  writeUint16(out + 2, offset + kAttributeHeaderLength + kHmacLength - kHeaderLength);
+  unsigned int digest_length = 0;
+  HMAC(EVP_sha1(), password.data(), password.size(), reinterpret_cast<unsigned char*>(out), offset,
+       reinterpret_cast<unsigned char*>(out + offset + kAttributeHeaderLength), &digest_length);
+  writeUint16(out + offset, kAttrMessageIntegrity);
+  writeUint16(out + offset + 2, kHmacLength);
+  offset += kAttributeHeaderLength + kHmacLength;
+
+  writeUint16(out + 2, total_length - kHeaderLength);
+  uint32_t crc = crc32(reinterpret_cast<unsigned char*>(out), offset) ^ kFingerprintXor;
+  writeUint16(out + offset, kAttrFingerprint);
+  writeUint16(out + offset + 2, 4);
+  writeUint32(out + offset + kAttributeHeaderLength, crc);
+  return total_length;
+}
+
+uint32_t StunMessage::crc32(const unsigned char* buf, int len) {
+  static uint32_t table[256] = {0};
+  static bool table_ready = [] {
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t c = i;
+      for (int k = 0; k < 8; k++) {
+        c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+      }
+      table[i] = c;
+    }
+    return true;
+  }();
+  (void)table_ready;
+  uint32_t crc = 0xFFFFFFFF;
+  for (int i = 0; i < len; i++) {
+    crc = table[(crc ^ buf[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return crc ^ 0xFFFFFFFF;
+}
+
+}  // namespace erizo
@@ -0,0 +1,78 @@
+#ifndef ERIZO_SRC_ERIZO_LIB_STUNMESSAGE_H_
+#define ERIZO_SRC_ERIZO_LIB_STUNMESSAGE_H_
+
+#include <netinet/in.h>
+
+#include <string>
+
+namespace erizo {
+
+/**
+ * Minimal RFC 5389 STUN message parser/builder.
+ * It only covers what an ICE-lite agent needs: reading Binding requests (USERNAME, PRIORITY,
+ * USE-CANDIDATE, MESSAGE-INTEGRITY, FINGERPRINT) and writing signed Binding success responses.
+ */
+class StunMessage {
+ public:
+  static constexpr uint16_t kBindingRequest = 0x0001;
+  static constexpr uint16_t kBindingSuccessResponse = 0x0101;
+  static constexpr uint32_t kMagicCookie = 0x2112A442;
+  static constexpr int kHeaderLength = 20;
+
+  static constexpr uint16_t kAttrMappedAddress = 0x0001;
+  static constexpr uint16_t kAttrUsername = 0x0006;
+  static constexpr uint16_t kAttrMessageIntegrity = 0x0008;
+  static constexpr uint16_t kAttrXorMappedAddress = 0x0020;
+  static constexpr uint16_t kAttrPriority = 0x0024;
+  static constexpr uint16_t kAttrUseCandidate = 0x0025;
+  static constexpr uint16_t kAttrFingerprint = 0x8028;
+  static constexpr uint16_t kAttrIceControlled = 0x8029;
+  static constexpr uint16_t kAttrIceControlling = 0x802A;
+
+  StunMessage();
+
+  /**
+   * Cheap check used to demux STUN from DTLS/SRTP on a shared socket (RFC 7983)
+   */
+  static bool isStun(const char* buf, int len);
+
+  bool parse(const char* buf, int len);
+
+  uint16_t getType() const { return type_; }
+  const std::string& getTransactionId() const { return transaction_id_; }
+  const std::string& getUsername() const { return username_; }
+  /**
+   * The ufrag of the agent receiving the request: the part of USERNAME before ':'
+   */
+  std::string getLocalUfrag() const;
+  uint32_t getPriority() const { return priority_; }
+  bool hasUseCandidate() const { return use_candidate_; }
+  bool hasMessageIntegrity() const { return integrity_offset_ >= 0; }
+  bool hasFingerprint() const { return fingerprint_offset_ >= 0; }
+
+  bool checkIntegrity(const std::string& password) const;
+  bool checkFingerprint() const;
+
+  /**
+   * Writes a Binding success response for this request into out.
+   * @return the length of the response or -1 if it does not fit
+   */
+  int buildBindingResponse(const sockaddr_in& mapped, const std::string& password, char* out, int max_len) const;
+
+ private:
+  static uint32_t crc32(const unsigned char* buf, int len);
+
+ private:
+  std::string raw_;
+  uint16_t type_;
+  std::string transaction_id_;
+  std::string username_;
+  uint32_t priority_;
+  bool use_candidate_;
+  int integrity_offset_;
+  int fingerprint_offset_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_LIB_STUNMESSAGE_H_
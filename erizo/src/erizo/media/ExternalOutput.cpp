@@ -301,9 +301,9 @@ void ExternalOutput::maybeWriteVideoPacket(char* buf, int len) {
   }
 }
 
-void ExternalOutput::notifyUpdateToHandlers() {
-  asyncTask([] (std::shared_ptr<ExternalOutput> output) {
-    output->pipeline_->notifyUpdate();
+void ExternalOutput::notifyUpdateToHandlers(uint8_t updates) {
+  asyncTask([updates] (std::shared_ptr<ExternalOutput> output) {
+    output->pipeline_->notifyUpdate(updates);
   });
 }
 
@@ -53,7 +53,7 @@ class ExternalOutput : public MediaSink, public RawDataReceiver, public Feedback
 
   void write(PacketPtr packet);
 
-  void notifyUpdateToHandlers() override;
+  void notifyUpdateToHandlers(uint8_t updates) override;
 
   bool isRecording() { return recording_; }
 
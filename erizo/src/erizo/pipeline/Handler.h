@@ -43,6 +43,12 @@ class HandlerBase {
 class Handler : public HandlerBase<HandlerContext> {
  public:
   static const HandlerDir dir = HandlerDir::BOTH;
+  // Packets a StaticPipeline hands to read and write, the others skip the handler. A handler that only looks
+  // at some packets and forwards the rest untouched narrows them down, so the others don't pay for the call.
+  static const uint8_t read_packets = kAllPackets;
+  static const uint8_t write_packets = kAllPackets;
+  // Changes that get notifyUpdate called, a handler that only cares about some of them narrows them down
+  static const uint8_t notified_updates = kAllUpdates;
 
   typedef HandlerContext Context;
   virtual ~Handler() = default;
@@ -52,6 +58,13 @@ class Handler : public HandlerBase<HandlerContext> {
   virtual std::string getName() = 0;
 
   virtual void read(Context* ctx, PacketPtr packet) = 0;
+  // Packets that came in together. What the handler forwards while it goes through them, with fireRead or
+  // fireReadBatch, goes on as one batch once it is done. By default it reads them one by one.
+  virtual void readBatch(Context* ctx, PacketBatch packets) {
+    for (PacketPtr &packet : packets) {
+      read(ctx, std::move(packet));
+    }
+  }
   virtual void readEOF(Context* ctx) {
     ctx->fireReadEOF();
   }
@@ -63,6 +76,12 @@ class Handler : public HandlerBase<HandlerContext> {
   }
 
   virtual void write(Context* ctx, PacketPtr packet) = 0;
+  // As readBatch
+  virtual void writeBatch(Context* ctx, PacketBatch packets) {
+    for (PacketPtr &packet : packets) {
+      write(ctx, std::move(packet));
+    }
+  }
   virtual void close(Context* ctx) {
     return ctx->fireClose();
   }
@@ -75,6 +94,9 @@ class Handler : public HandlerBase<HandlerContext> {
 class InboundHandler : public HandlerBase<InboundHandlerContext> {
  public:
   static const HandlerDir dir = HandlerDir::IN;
+  static const uint8_t read_packets = kAllPackets;
+  static const uint8_t write_packets = kNoPackets;
+  static const uint8_t notified_updates = kAllUpdates;
 
   typedef InboundHandlerContext Context;
   virtual ~InboundHandler() = default;
@@ -85,6 +107,13 @@ class InboundHandler : public HandlerBase<InboundHandlerContext> {
   virtual std::string getName() = 0;
 
   virtual void read(Context* ctx, PacketPtr packet) = 0;
+  // Packets that came in together. What the handler forwards while it goes through them, with fireRead or
+  // fireReadBatch, goes on as one batch once it is done. By default it reads them one by one.
+  virtual void readBatch(Context* ctx, PacketBatch packets) {
+    for (PacketPtr &packet : packets) {
+      read(ctx, std::move(packet));
+    }
+  }
   virtual void readEOF(Context* ctx) {
     ctx->fireReadEOF();
   }
@@ -102,6 +131,9 @@ class InboundHandler : public HandlerBase<InboundHandlerContext> {
 class OutboundHandler : public HandlerBase<OutboundHandlerContext> {
  public:
   static const HandlerDir dir = HandlerDir::OUT;
+  static const uint8_t read_packets = kNoPackets;
+  static const uint8_t write_packets = kAllPackets;
+  static const uint8_t notified_updates = kAllUpdates;
 
   typedef OutboundHandlerContext Context;
   virtual ~OutboundHandler() = default;
@@ -112,6 +144,13 @@ class OutboundHandler : public HandlerBase<OutboundHandlerContext> {
   virtual std::string getName() = 0;
 
   virtual void write(Context* ctx, PacketPtr packet) = 0;
+  // Packets that came in together. What the handler forwards while it goes through them, with fireWrite or
+  // fireWriteBatch, goes on as one batch once it is done. By default it writes them one by one.
+  virtual void writeBatch(Context* ctx, PacketBatch packets) {
+    for (PacketPtr &packet : packets) {
+      write(ctx, std::move(packet));
+    }
+  }
   virtual void close(Context* ctx) {
     return ctx->fireClose();
   }
@@ -11,6 +11,7 @@
 #define ERIZO_SRC_ERIZO_PIPELINE_HANDLERCONTEXT_INL_H_
 
 #include "./MediaDefinitions.h"
+#include "stats/HandlerStats.h"
 
 namespace erizo {
 
@@ -21,7 +22,7 @@ class PipelineContext {
   virtual void attachPipeline() = 0;
   virtual void detachPipeline() = 0;
 
-  virtual void notifyUpdate() = 0;
+  virtual void notifyUpdate(uint8_t updates) = 0;
   virtual void notifyEvent(MediaEventPtr event) = 0;
   virtual std::string getName() = 0;
   virtual void enable() = 0;
@@ -40,12 +41,16 @@ class PipelineContext {
   virtual void setNextOut(PipelineContext* ctx) = 0;
 
   virtual HandlerDir getDirection() = 0;
+
+  virtual void enableStats() = 0;
+  virtual const HandlerStats* getStats() = 0;
 };
 
 class InboundLink {
  public:
   virtual ~InboundLink() = default;
   virtual void read(PacketPtr packet) = 0;
+  virtual void readBatch(PacketBatch packets) = 0;
   virtual void readEOF() = 0;
   virtual void transportActive() = 0;
   virtual void transportInactive() = 0;
@@ -55,6 +60,7 @@ class OutboundLink {
  public:
   virtual ~OutboundLink() = default;
   virtual void write(PacketPtr packet) = 0;
+  virtual void writeBatch(PacketBatch packets) = 0;
   virtual void close() = 0;
 };
 
@@ -75,8 +81,10 @@ class ContextImplBase : public PipelineContext {
     handler_ = std::move(handler);
   }
 
-  void notifyUpdate() override {
-    handler_->notifyUpdate();
+  void notifyUpdate(uint8_t updates) override {
+    if (H::notified_updates & updates) {
+      handler_->notifyUpdate();
+    }
   }
 
   void notifyEvent(MediaEventPtr event) override {
@@ -135,13 +143,67 @@ class ContextImplBase : public PipelineContext {
     return H::dir;
   }
 
+  void enableStats() override {
+    if (!stats_) {
+      stats_.reset(new HandlerStats());
+    }
+  }
+
+  const HandlerStats* getStats() override {
+    return stats_.get();
+  }
+
  protected:
+  // Runs the handler through a batch and gives back what it passed on meanwhile
+  PacketBatch handlerReadBatch(PacketBatch packets) {
+    PacketBatch forwarded;
+    forwarded.reserve(packets.size());
+    PacketBatch *previous = read_batch_;
+    read_batch_ = &forwarded;
+    if (stats_) {
+      HandlerCallTimer timer{&stats_->read, true, nextIn_ != nullptr, packets.size(), &forwarded};
+      handler_->readBatch(impl_, std::move(packets));
+    } else {
+      handler_->readBatch(impl_, std::move(packets));
+    }
+    read_batch_ = previous;
+    return forwarded;
+  }
+
+  PacketBatch handlerWriteBatch(PacketBatch packets) {
+    PacketBatch forwarded;
+    forwarded.reserve(packets.size());
+    PacketBatch *previous = write_batch_;
+    write_batch_ = &forwarded;
+    if (stats_) {
+      HandlerCallTimer timer{&stats_->write, false, nextOut_ != nullptr, packets.size(), &forwarded};
+      handler_->writeBatch(impl_, std::move(packets));
+    } else {
+      handler_->writeBatch(impl_, std::move(packets));
+    }
+    write_batch_ = previous;
+    return forwarded;
+  }
+
+  // Keeps what the handler passes on for the batch it is going through. Out of line, so fireRead stays small
+  __attribute__((noinline)) static void addToBatch(PacketBatch *batch, PacketPtr packet) {
+    batch->push_back(std::move(packet));
+  }
+
+  static void addToBatch(PacketBatch *batch, PacketBatch packets) {
+    batch->insert(batch->end(), std::make_move_iterator(packets.begin()), std::make_move_iterator(packets.end()));
+  }
+
   Context* impl_;
   std::weak_ptr<PipelineBase> pipelineWeak_;
   PipelineBase* pipelineRaw_;
   std::shared_ptr<H> handler_;
   InboundLink* nextIn_{nullptr};
   OutboundLink* nextOut_{nullptr};
+  // Only there when the pipeline measures its handlers, a null check is all it costs otherwise
+  std::unique_ptr<HandlerStats> stats_;
+  PacketBatch* read_batch_{nullptr};
+  PacketBatch* write_batch_{nullptr};
 
  private:
   bool attached_{false};
@@ -172,12 +234,25 @@ class ContextImpl
 
   // HandlerContext overrides
   void fireRead(PacketPtr packet) override {
+    if (this->read_batch_) {
+      return this->addToBatch(this->read_batch_, std::move(packet));
+    }
     auto guard = this->pipelineWeak_.lock();
     if (this->nextIn_) {
       this->nextIn_->read(std::move(packet));
     }
   }
 
+  void fireReadBatch(PacketBatch packets) override {
+    if (this->read_batch_) {
+      return this->addToBatch(this->read_batch_, std::move(packets));
+    }
+    auto guard = this->pipelineWeak_.lock();
+    if (this->nextIn_) {
+      this->nextIn_->readBatch(std::move(packets));
+    }
+  }
+
   void fireReadEOF() override {
     auto guard = this->pipelineWeak_.lock();
     if (this->nextIn_) {
@@ -200,12 +275,25 @@ class ContextImpl
   }
 
   void fireWrite(PacketPtr packet) override {
+    if (this->write_batch_) {
+      return this->addToBatch(this->write_batch_, std::move(packet));
+    }
     auto guard = this->pipelineWeak_.lock();
     if (this->nextOut_) {
       this->nextOut_->write(std::move(packet));
     }
   }
 
+  void fireWriteBatch(PacketBatch packets) override {
+    if (this->write_batch_) {
+      return this->addToBatch(this->write_batch_, std::move(packets));
+    }
+    auto guard = this->pipelineWeak_.lock();
+    if (this->nextOut_) {
+      this->nextOut_->writeBatch(std::move(packets));
+    }
+  }
+
   void fireClose() override {
     auto guard = this->pipelineWeak_.lock();
     if (this->nextOut_) {
@@ -224,9 +312,22 @@ class ContextImpl
   // InboundLink overrides
   void read(PacketPtr packet) override {
     auto guard = this->pipelineWeak_.lock();
+    if (this->stats_) {
+      HandlerCallTimer timer{&this->stats_->read, true, this->nextIn_ != nullptr};
+      this->handler_->read(this, std::move(packet));
+      return;
+    }
     this->handler_->read(this, std::move(packet));
   }
 
+  void readBatch(PacketBatch packets) override {
+    auto guard = this->pipelineWeak_.lock();
+    PacketBatch forwarded = this->handlerReadBatch(std::move(packets));
+    if (!forwarded.empty() && this->nextIn_) {
+      this->nextIn_->readBatch(std::move(forwarded));
+    }
+  }
+
   void readEOF() override {
     auto guard = this->pipelineWeak_.lock();
     this->handler_->readEOF(this);
@@ -245,9 +346,22 @@ class ContextImpl
   // OutboundLink overrides
   void write(PacketPtr packet) override {
     auto guard = this->pipelineWeak_.lock();
+    if (this->stats_) {
+      HandlerCallTimer timer{&this->stats_->write, false, this->nextOut_ != nullptr};
+      this->handler_->write(this, std::move(packet));
+      return;
+    }
     this->handler_->write(this, std::move(packet));
   }
 
+  void writeBatch(PacketBatch packets) override {
+    auto guard = this->pipelineWeak_.lock();
+    PacketBatch forwarded = this->handlerWriteBatch(std::move(packets));
+    if (!forwarded.empty() && this->nextOut_) {
+      this->nextOut_->writeBatch(std::move(forwarded));
+    }
+  }
+
   void close() override {
     auto guard = this->pipelineWeak_.lock();
     this->handler_->close(this);
@@ -278,12 +392,25 @@ class InboundContextImpl
 
   // InboundHandlerContext overrides
   void fireRead(PacketPtr packet) override {
+    if (this->read_batch_) {
+      return this->addToBatch(this->read_batch_, std::move(packet));
+    }
     auto guard = this->pipelineWeak_.lock();
     if (this->nextIn_) {
       this->nextIn_->read(std::move(packet));
     }
   }
 
+  void fireReadBatch(PacketBatch packets) override {
+    if (this->read_batch_) {
+      return this->addToBatch(this->read_batch_, std::move(packets));
+    }
+    auto guard = this->pipelineWeak_.lock();
+    if (this->nextIn_) {
+      this->nextIn_->readBatch(std::move(packets));
+    }
+  }
+
   void fireReadEOF() override {
     auto guard = this->pipelineWeak_.lock();
     if (this->nextIn_) {
@@ -316,9 +443,22 @@ class InboundContextImpl
   // InboundLink overrides
   void read(PacketPtr packet) override {
     auto guard = this->pipelineWeak_.lock();
+    if (this->stats_) {
+      HandlerCallTimer timer{&this->stats_->read, true, this->nextIn_ != nullptr};
+      this->handler_->read(this, std::move(packet));
+      return;
+    }
     this->handler_->read(this, std::move(packet));
   }
 
+  void readBatch(PacketBatch packets) override {
+    auto guard = this->pipelineWeak_.lock();
+    PacketBatch forwarded = this->handlerReadBatch(std::move(packets));
+    if (!forwarded.empty() && this->nextIn_) {
+      this->nextIn_->readBatch(std::move(forwarded));
+    }
+  }
+
   void readEOF() override {
     auto guard = this->pipelineWeak_.lock();
     this->handler_->readEOF(this);
@@ -359,12 +499,25 @@ class OutboundContextImpl
 
   // OutboundHandlerContext overrides
   void fireWrite(PacketPtr packet) override {
+    if (this->write_batch_) {
+      return this->addToBatch(this->write_batch_, std::move(packet));
+    }
     auto guard = this->pipelineWeak_.lock();
     if (this->nextOut_) {
       return this->nextOut_->write(std::move(packet));
     }
   }
 
+  void fireWriteBatch(PacketBatch packets) override {
+    if (this->write_batch_) {
+      return this->addToBatch(this->write_batch_, std::move(packets));
+    }
+    auto guard = this->pipelineWeak_.lock();
+    if (this->nextOut_) {
+      this->nextOut_->writeBatch(std::move(packets));
+    }
+  }
+
   void fireClose() override {
     auto guard = this->pipelineWeak_.lock();
     if (this->nextOut_) {
@@ -383,9 +536,22 @@ class OutboundContextImpl
   // OutboundLink overrides
   void write(PacketPtr packet) override {
     auto guard = this->pipelineWeak_.lock();
+    if (this->stats_) {
+      HandlerCallTimer timer{&this->stats_->write, false, this->nextOut_ != nullptr};
+      this->handler_->write(this, std::move(packet));
+      return;
+    }
     return this->handler_->write(this, std::move(packet));
   }
 
+  void writeBatch(PacketBatch packets) override {
+    auto guard = this->pipelineWeak_.lock();
+    PacketBatch forwarded = this->handlerWriteBatch(std::move(packets));
+    if (!forwarded.empty() && this->nextOut_) {
+      this->nextOut_->writeBatch(std::move(forwarded));
+    }
+  }
+
   void close() override {
     auto guard = this->pipelineWeak_.lock();
     return this->handler_->close(this);
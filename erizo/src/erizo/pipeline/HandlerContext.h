@@ -23,11 +23,13 @@ class HandlerContext {
   virtual ~HandlerContext() = default;
 
   virtual void fireRead(PacketPtr packet) = 0;
+  virtual void fireReadBatch(PacketBatch packets) = 0;
   virtual void fireReadEOF() = 0;
   virtual void fireTransportActive() = 0;
   virtual void fireTransportInactive() = 0;
 
   virtual void fireWrite(PacketPtr packet) = 0;
+  virtual void fireWriteBatch(PacketBatch packets) = 0;
   virtual void fireClose() = 0;
 
   virtual PipelineBase* getPipeline() = 0;
@@ -39,6 +41,7 @@ class InboundHandlerContext {
   virtual ~InboundHandlerContext() = default;
 
   virtual void fireRead(PacketPtr packet) = 0;
+  virtual void fireReadBatch(PacketBatch packets) = 0;
   virtual void fireReadEOF() = 0;
   virtual void fireTransportActive() = 0;
   virtual void fireTransportInactive() = 0;
@@ -52,6 +55,7 @@ class OutboundHandlerContext {
   virtual ~OutboundHandlerContext() = default;
 
   virtual void fireWrite(PacketPtr packet) = 0;
+  virtual void fireWriteBatch(PacketBatch packets) = 0;
   virtual void fireClose() = 0;
 
   virtual PipelineBase* getPipeline() = 0;
@@ -9,7 +9,7 @@ class HandlerManagerListener {
  public:
   virtual ~HandlerManagerListener() = default;
 
-  virtual void notifyUpdateToHandlers() = 0;
+  virtual void notifyUpdateToHandlers(uint8_t updates) = 0;
 };
 
 class HandlerManager : public Service {
@@ -17,9 +17,9 @@ class HandlerManager : public Service {
   explicit HandlerManager(std::weak_ptr<HandlerManagerListener> listener) : listener_{listener} {}
   virtual ~HandlerManager() = default;
 
-  void notifyUpdateToHandlers() {
+  void notifyUpdateToHandlers(uint8_t updates) {
     if (auto listener = listener_.lock()) {
-      listener->notifyUpdateToHandlers();
+      listener->notifyUpdateToHandlers(updates);
     }
   }
  private:
@@ -72,6 +72,13 @@ void Pipeline::read(PacketPtr packet) {
   front_->read(std::move(packet));
 }
 
+void Pipeline::readBatch(PacketBatch packets) {
+  if (!front_ || packets.empty()) {
+    return;
+  }
+  front_->readBatch(std::move(packets));
+}
+
 void Pipeline::readEOF() {
   if (!front_) {
     return;
@@ -86,6 +93,13 @@ void Pipeline::write(PacketPtr packet) {
   back_->write(std::move(packet));
 }
 
+void Pipeline::writeBatch(PacketBatch packets) {
+  if (!back_ || packets.empty()) {
+    return;
+  }
+  back_->writeBatch(std::move(packets));
+}
+
 void Pipeline::close() {
   if (!back_) {
     return;
@@ -134,9 +148,9 @@ void Pipeline::finalize() {
   notifyUpdate();
 }
 
-void Pipeline::notifyUpdate() {
+void Pipeline::notifyUpdate(uint8_t updates) {
   for (auto it = ctxs_.rbegin(); it != ctxs_.rend(); it++) {
-    (*it)->notifyUpdate();
+    (*it)->notifyUpdate(updates);
   }
 }
 
@@ -165,4 +179,20 @@ void Pipeline::disable(std::string name) {
   }
 }
 
+void Pipeline::enableHandlerStats() {
+  for (auto& ctx : ctxs_) {
+    ctx->enableStats();
+  }
+}
+
+HandlerStatsMap Pipeline::getHandlerStats() {
+  HandlerStatsMap stats;
+  for (auto& ctx : ctxs_) {
+    if (const HandlerStats *handler_stats = ctx->getStats()) {
+      stats[ctx->getName()].add(*handler_stats);
+    }
+  }
+  return stats;
+}
+
 }  // namespace erizo
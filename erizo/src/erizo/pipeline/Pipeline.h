@@ -162,6 +162,9 @@ class Pipeline : public PipelineBase {
 
   void read(PacketPtr packet);
 
+  // Packets that came in together, they go through each handler as one batch
+  void readBatch(PacketBatch packets);
+
   void readEOF();
 
   void transportActive();
@@ -170,15 +173,22 @@ class Pipeline : public PipelineBase {
 
   void write(PacketPtr packet);
 
+  void writeBatch(PacketBatch packets);
+
   void close();
 
   void finalize() override;
 
-  void notifyUpdate();
+  // Only the handlers that want to hear about one of the given changes get notifyUpdate called
+  void notifyUpdate(uint8_t updates = kAllUpdates);
   void notifyEvent(MediaEventPtr event);
   void enable(std::string name);
   void disable(std::string name);
 
+  // Starts measuring every handler, see HandlerStats. Call it once the handlers are in place.
+  void enableHandlerStats();
+  HandlerStatsMap getHandlerStats();
+
  protected:
   Pipeline();
 
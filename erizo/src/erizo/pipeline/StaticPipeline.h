@@ -0,0 +1,452 @@
+#ifndef ERIZO_SRC_ERIZO_PIPELINE_STATICPIPELINE_H_
+#define ERIZO_SRC_ERIZO_PIPELINE_STATICPIPELINE_H_
+
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "pipeline/Pipeline.h"
+#include "rtp/RtpUtils.h"
+
+namespace erizo {
+
+namespace detail {
+
+template <int... Is>
+struct Indices {};
+
+template <int N, int... Is>
+struct MakeIndices : MakeIndices<N - 1, N - 1, Is...> {};
+
+template <int... Is>
+struct MakeIndices<0, Is...> {
+  typedef Indices<Is...> type;
+};
+
+// Position of the first handler at or after I that reads any packets, or the number of handlers if there is none
+template <int I, class Handlers, bool End = (I >= static_cast<int>(std::tuple_size<Handlers>::value))>
+struct NextInbound {
+  static constexpr int value = static_cast<int>(std::tuple_size<Handlers>::value);
+};
+
+template <int I, class Handlers>
+struct NextInbound<I, Handlers, false> {
+  static constexpr int value = std::tuple_element<I, Handlers>::type::read_packets != kNoPackets ?
+                               I : NextInbound<I + 1, Handlers>::value;
+};
+
+// Position of the last handler at or before I that writes any packets, or -1 if there is none
+template <int I, class Handlers, bool End = (I < 0)>
+struct PreviousOutbound {
+  static constexpr int value = -1;
+};
+
+template <int I, class Handlers>
+struct PreviousOutbound<I, Handlers, false> {
+  static constexpr int value = std::tuple_element<I, Handlers>::type::write_packets != kNoPackets ?
+                               I : PreviousOutbound<I - 1, Handlers>::value;
+};
+
+template <int I, class Handlers>
+struct HasNextInbound {
+  static constexpr bool value =
+    NextInbound<I + 1, Handlers>::value < static_cast<int>(std::tuple_size<Handlers>::value);
+};
+
+template <int I, class Handlers>
+struct HasPreviousOutbound {
+  static constexpr bool value = PreviousOutbound<I - 1, Handlers>::value >= 0;
+};
+
+// Splits packets into runs of those a handler wants and those it doesn't, keeping their order
+inline void splitByPacketClass(PacketBatch packets, uint8_t wanted_packets,
+                               std::vector<std::pair<bool, PacketBatch>> *runs) {
+  for (PacketPtr &packet : packets) {
+    bool wanted = (wanted_packets & RtpUtils::getPacketClass(packet)) != 0;
+    if (runs->empty() || runs->back().first != wanted) {
+      runs->emplace_back(wanted, PacketBatch());
+    }
+    runs->back().second.push_back(std::move(packet));
+  }
+}
+
+}  // namespace detail
+
+/*
+ * The context of the handler at position I of a StaticPipeline. It is a regular context of the handler, so
+ * getHandler, getContext, services and events work as in Pipeline, but packets go straight to the next handler:
+ * its position is known at compile time and its read or write is called without virtual dispatch.
+ * Everything but packets (readEOF, close, transportActive...) still goes through the links set by finalize.
+ */
+template <class P, class H, int I, HandlerDir Dir = H::dir>
+class StaticContext;
+
+template <class P, class H, int I>
+class StaticContext<P, H, I, HandlerDir::BOTH> : public ContextImpl<H> {
+ public:
+  void setStaticPipeline(P* pipeline) {
+    static_pipeline_ = pipeline;
+  }
+
+  using ContextImplBase<H, typename H::Context>::handlerReadBatch;
+  using ContextImplBase<H, typename H::Context>::handlerWriteBatch;
+
+  void handlerRead(PacketPtr packet) {
+    if (this->stats_) {
+      return measuredHandlerRead(std::move(packet));
+    }
+    this->handler_->H::read(this, std::move(packet));
+  }
+
+  void handlerWrite(PacketPtr packet) {
+    if (this->stats_) {
+      return measuredHandlerWrite(std::move(packet));
+    }
+    this->handler_->H::write(this, std::move(packet));
+  }
+
+  void fireRead(PacketPtr packet) override {
+    if (this->read_batch_) {
+      return this->addToBatch(this->read_batch_, std::move(packet));
+    }
+    static_pipeline_->template readAt<detail::NextInbound<I + 1, typename P::HandlerTypes>::value>(
+      std::move(packet));
+  }
+
+  void fireReadBatch(PacketBatch packets) override {
+    if (this->read_batch_) {
+      return this->addToBatch(this->read_batch_, std::move(packets));
+    }
+    static_pipeline_->template readBatchAt<detail::NextInbound<I + 1, typename P::HandlerTypes>::value>(
+      std::move(packets));
+  }
+
+  void fireWrite(PacketPtr packet) override {
+    if (this->write_batch_) {
+      return this->addToBatch(this->write_batch_, std::move(packet));
+    }
+    static_pipeline_->template writeAt<detail::PreviousOutbound<I - 1, typename P::HandlerTypes>::value>(
+      std::move(packet));
+  }
+
+  void fireWriteBatch(PacketBatch packets) override {
+    if (this->write_batch_) {
+      return this->addToBatch(this->write_batch_, std::move(packets));
+    }
+    static_pipeline_->template writeBatchAt<detail::PreviousOutbound<I - 1, typename P::HandlerTypes>::value>(
+      std::move(packets));
+  }
+
+  void read(PacketPtr packet) override {
+    auto guard = this->pipelineWeak_.lock();
+    if (H::read_packets != kAllPackets && !(H::read_packets & RtpUtils::getPacketClass(packet))) {
+      return fireRead(std::move(packet));
+    }
+    handlerRead(std::move(packet));
+  }
+
+  void readBatch(PacketBatch packets) override {
+    auto guard = this->pipelineWeak_.lock();
+    static_pipeline_->template readBatchAt<I>(std::move(packets));
+  }
+
+  void write(PacketPtr packet) override {
+    auto guard = this->pipelineWeak_.lock();
+    if (H::write_packets != kAllPackets && !(H::write_packets & RtpUtils::getPacketClass(packet))) {
+      return fireWrite(std::move(packet));
+    }
+    handlerWrite(std::move(packet));
+  }
+
+  void writeBatch(PacketBatch packets) override {
+    auto guard = this->pipelineWeak_.lock();
+    static_pipeline_->template writeBatchAt<I>(std::move(packets));
+  }
+
+ private:
+  // Out of line, so the path without stats stays as small as it was
+  __attribute__((noinline)) void measuredHandlerRead(PacketPtr packet) {
+    HandlerCallTimer timer{&this->stats_->read, true,
+                           detail::HasNextInbound<I, typename P::HandlerTypes>::value};
+    this->handler_->H::read(this, std::move(packet));
+  }
+
+  __attribute__((noinline)) void measuredHandlerWrite(PacketPtr packet) {
+    HandlerCallTimer timer{&this->stats_->write, false,
+                           detail::HasPreviousOutbound<I, typename P::HandlerTypes>::value};
+    this->handler_->H::write(this, std::move(packet));
+  }
+
+  P* static_pipeline_{nullptr};
+};
+
+template <class P, class H, int I>
+class StaticContext<P, H, I, HandlerDir::IN> : public InboundContextImpl<H> {
+ public:
+  void setStaticPipeline(P* pipeline) {
+    static_pipeline_ = pipeline;
+  }
+
+  using ContextImplBase<H, typename H::Context>::handlerReadBatch;
+
+  void handlerRead(PacketPtr packet) {
+    if (this->stats_) {
+      return measuredHandlerRead(std::move(packet));
+    }
+    this->handler_->H::read(this, std::move(packet));
+  }
+
+  void fireRead(PacketPtr packet) override {
+    if (this->read_batch_) {
+      return this->addToBatch(this->read_batch_, std::move(packet));
+    }
+    static_pipeline_->template readAt<detail::NextInbound<I + 1, typename P::HandlerTypes>::value>(
+      std::move(packet));
+  }
+
+  void fireReadBatch(PacketBatch packets) override {
+    if (this->read_batch_) {
+      return this->addToBatch(this->read_batch_, std::move(packets));
+    }
+    static_pipeline_->template readBatchAt<detail::NextInbound<I + 1, typename P::HandlerTypes>::value>(
+      std::move(packets));
+  }
+
+  void read(PacketPtr packet) override {
+    auto guard = this->pipelineWeak_.lock();
+    if (H::read_packets != kAllPackets && !(H::read_packets & RtpUtils::getPacketClass(packet))) {
+      return fireRead(std::move(packet));
+    }
+    handlerRead(std::move(packet));
+  }
+
+  void readBatch(PacketBatch packets) override {
+    auto guard = this->pipelineWeak_.lock();
+    static_pipeline_->template readBatchAt<I>(std::move(packets));
+  }
+
+ private:
+  // Out of line, so the path without stats stays as small as it was
+  __attribute__((noinline)) void measuredHandlerRead(PacketPtr packet) {
+    HandlerCallTimer timer{&this->stats_->read, true,
+                           detail::HasNextInbound<I, typename P::HandlerTypes>::value};
+    this->handler_->H::read(this, std::move(packet));
+  }
+
+  P* static_pipeline_{nullptr};
+};
+
+template <class P, class H, int I>
+class StaticContext<P, H, I, HandlerDir::OUT> : public OutboundContextImpl<H> {
+ public:
+  void setStaticPipeline(P* pipeline) {
+    static_pipeline_ = pipeline;
+  }
+
+  using ContextImplBase<H, typename H::Context>::handlerWriteBatch;
+
+  void handlerWrite(PacketPtr packet) {
+    if (this->stats_) {
+      return measuredHandlerWrite(std::move(packet));
+    }
+    this->handler_->H::write(this, std::move(packet));
+  }
+
+  void fireWrite(PacketPtr packet) override {
+    if (this->write_batch_) {
+      return this->addToBatch(this->write_batch_, std::move(packet));
+    }
+    static_pipeline_->template writeAt<detail::PreviousOutbound<I - 1, typename P::HandlerTypes>::value>(
+      std::move(packet));
+  }
+
+  void fireWriteBatch(PacketBatch packets) override {
+    if (this->write_batch_) {
+      return this->addToBatch(this->write_batch_, std::move(packets));
+    }
+    static_pipeline_->template writeBatchAt<detail::PreviousOutbound<I - 1, typename P::HandlerTypes>::value>(
+      std::move(packets));
+  }
+
+  void write(PacketPtr packet) override {
+    auto guard = this->pipelineWeak_.lock();
+    if (H::write_packets != kAllPackets && !(H::write_packets & RtpUtils::getPacketClass(packet))) {
+      return fireWrite(std::move(packet));
+    }
+    handlerWrite(std::move(packet));
+  }
+
+  void writeBatch(PacketBatch packets) override {
+    auto guard = this->pipelineWeak_.lock();
+    static_pipeline_->template writeBatchAt<I>(std::move(packets));
+  }
+
+ private:
+  // Out of line, so the path without stats stays as small as it was
+  __attribute__((noinline)) void measuredHandlerWrite(PacketPtr packet) {
+    HandlerCallTimer timer{&this->stats_->write, false,
+                           detail::HasPreviousOutbound<I, typename P::HandlerTypes>::value};
+    this->handler_->H::write(this, std::move(packet));
+  }
+
+  P* static_pipeline_{nullptr};
+};
+
+template <class Indices, class... Handlers>
+class StaticPipelineImpl;
+
+/*
+ * A Pipeline whose handlers are fixed at compile time, in the order they would have with addBack.
+ * A packet is handed from one handler to the next through a direct call, instead of the two virtual calls and
+ * the weak_ptr lock per handler of Pipeline, and handlers that do not see a direction are skipped at compile
+ * time. Handlers that narrow down read_packets or write_packets are also skipped for the packets they don't want
+ * (Pipeline ignores them and calls every handler), which costs a look at the packet only before those handlers.
+ * Handlers are called through the type they are listed with, so a subclass must be listed as itself.
+ * Handlers can't be added or removed, use Pipeline for chains that change.
+ */
+template <int... Is, class... Handlers>
+class StaticPipelineImpl<detail::Indices<Is...>, Handlers...> : public Pipeline {
+ public:
+  typedef std::tuple<Handlers...> HandlerTypes;
+  using Ptr = std::shared_ptr<StaticPipelineImpl>;
+
+  static Ptr create(std::shared_ptr<Handlers>... handlers) {
+    Ptr pipeline{new StaticPipelineImpl()};
+    std::weak_ptr<PipelineBase> weak_pipeline = pipeline;
+    int initialized[] = {(std::get<Is>(pipeline->contexts_).initialize(weak_pipeline, std::move(handlers)),
+                          std::get<Is>(pipeline->contexts_).setStaticPipeline(pipeline.get()), 0)...};
+    // addContextFront inserts at the front, so contexts go in from the last one
+    int added[] = {(pipeline->addContextFront(&std::get<sizeof...(Is) - 1 - Is>(pipeline->contexts_)), 0)...};
+    (void)initialized;
+    (void)added;
+    return pipeline;
+  }
+
+  ~StaticPipelineImpl() {
+    // The contexts are members, they are gone by the time ~Pipeline would detach them
+    detachHandlers();
+    ctxs_.clear();
+    inCtxs_.clear();
+    outCtxs_.clear();
+  }
+
+  template <int J>
+  void readAt(PacketPtr packet) {
+    readAt<J>(std::move(packet), std::integral_constant<bool, (J < static_cast<int>(sizeof...(Is)))>());
+  }
+
+  template <int J>
+  void writeAt(PacketPtr packet) {
+    writeAt<J>(std::move(packet), std::integral_constant<bool, (J >= 0)>());
+  }
+
+  template <int J>
+  void readBatchAt(PacketBatch packets) {
+    readBatchAt<J>(std::move(packets), std::integral_constant<bool, (J < static_cast<int>(sizeof...(Is)))>());
+  }
+
+  template <int J>
+  void writeBatchAt(PacketBatch packets) {
+    writeBatchAt<J>(std::move(packets), std::integral_constant<bool, (J >= 0)>());
+  }
+
+ private:
+  StaticPipelineImpl() {}
+
+  template <int J>
+  void readAt(PacketPtr packet, std::true_type) {
+    typedef typename std::tuple_element<J, HandlerTypes>::type H;
+    if (H::read_packets != kAllPackets && !(H::read_packets & RtpUtils::getPacketClass(packet))) {
+      return readAt<detail::NextInbound<J + 1, HandlerTypes>::value>(std::move(packet));
+    }
+    std::get<J>(contexts_).handlerRead(std::move(packet));
+  }
+
+  template <int J>
+  void readAt(PacketPtr packet, std::false_type) {
+  }
+
+  template <int J>
+  void writeAt(PacketPtr packet, std::true_type) {
+    typedef typename std::tuple_element<J, HandlerTypes>::type H;
+    if (H::write_packets != kAllPackets && !(H::write_packets & RtpUtils::getPacketClass(packet))) {
+      return writeAt<detail::PreviousOutbound<J - 1, HandlerTypes>::value>(std::move(packet));
+    }
+    std::get<J>(contexts_).handlerWrite(std::move(packet));
+  }
+
+  template <int J>
+  void writeAt(PacketPtr packet, std::false_type) {
+  }
+
+  // A handler that narrows down its packets gets the runs it wants as batches, the rest skip it. Batches are
+  // handled out of line, so they don't take from what the compiler inlines along the single packet path
+  template <int J>
+  __attribute__((noinline)) void readBatchAt(PacketBatch packets, std::true_type) {
+    typedef typename std::tuple_element<J, HandlerTypes>::type H;
+    if (H::read_packets == kAllPackets) {
+      return readBatchThrough<J>(std::move(packets));
+    }
+    std::vector<std::pair<bool, PacketBatch>> runs;
+    detail::splitByPacketClass(std::move(packets), H::read_packets, &runs);
+    for (auto &run : runs) {
+      if (run.first) {
+        readBatchThrough<J>(std::move(run.second));
+      } else {
+        readBatchAt<detail::NextInbound<J + 1, HandlerTypes>::value>(std::move(run.second));
+      }
+    }
+  }
+
+  template <int J>
+  void readBatchAt(PacketBatch packets, std::false_type) {
+  }
+
+  template <int J>
+  void readBatchThrough(PacketBatch packets) {
+    PacketBatch forwarded = std::get<J>(contexts_).handlerReadBatch(std::move(packets));
+    if (!forwarded.empty()) {
+      readBatchAt<detail::NextInbound<J + 1, HandlerTypes>::value>(std::move(forwarded));
+    }
+  }
+
+  template <int J>
+  __attribute__((noinline)) void writeBatchAt(PacketBatch packets, std::true_type) {
+    typedef typename std::tuple_element<J, HandlerTypes>::type H;
+    if (H::write_packets == kAllPackets) {
+      return writeBatchThrough<J>(std::move(packets));
+    }
+    std::vector<std::pair<bool, PacketBatch>> runs;
+    detail::splitByPacketClass(std::move(packets), H::write_packets, &runs);
+    for (auto &run : runs) {
+      if (run.first) {
+        writeBatchThrough<J>(std::move(run.second));
+      } else {
+        writeBatchAt<detail::PreviousOutbound<J - 1, HandlerTypes>::value>(std::move(run.second));
+      }
+    }
+  }
+
+  template <int J>
+  void writeBatchAt(PacketBatch packets, std::false_type) {
+  }
+
+  template <int J>
+  void writeBatchThrough(PacketBatch packets) {
+    PacketBatch forwarded = std::get<J>(contexts_).handlerWriteBatch(std::move(packets));
+    if (!forwarded.empty()) {
+      writeBatchAt<detail::PreviousOutbound<J - 1, HandlerTypes>::value>(std::move(forwarded));
+    }
+  }
+
+  std::tuple<StaticContext<StaticPipelineImpl, Handlers, Is>...> contexts_;
+};
+
+template <class... Handlers>
+using StaticPipeline = StaticPipelineImpl<typename detail::MakeIndices<sizeof...(Handlers)>::type, Handlers...>;
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_PIPELINE_STATICPIPELINE_H_
@@ -37,10 +37,15 @@ std::unique_ptr<RemoteBitrateEstimator> RemoteBitrateEstimatorPicker::pickEstima
   return rbe;
 }
 
+std::unique_ptr<RemoteBitrateEstimator> RemoteBitrateEstimatorPicker::pickTransportFeedbackGenerator(
+    webrtc::Clock* const clock, RtcpTransportFeedbackGenerator::FeedbackSender send_feedback) {
+  return std::unique_ptr<RemoteBitrateEstimator>(new RtcpTransportFeedbackGenerator(clock, send_feedback));
+}
+
 BandwidthEstimationHandler::BandwidthEstimationHandler(std::shared_ptr<RemoteBitrateEstimatorPicker> picker) :
   stream_{nullptr}, clock_{webrtc::Clock::GetRealTimeClock()},
   picker_{picker},
-  using_absolute_send_time_{false}, packets_since_absolute_send_time_{0},
+  using_absolute_send_time_{false}, using_transport_feedback_{false}, packets_since_absolute_send_time_{0},
   min_bitrate_bps_{kMinBitRateAllowed},
   bitrate_{0}, last_send_bitrate_{0}, max_video_bw_{300}, last_remb_time_{0},
   running_{false}, active_{true}, initialized_{false} {
@@ -82,6 +87,8 @@ void BandwidthEstimationHandler::notifyUpdate() {
     return;
   }
   updateExtensionMaps(ext_processor.getVideoExtensionMap(), ext_processor.getAudioExtensionMap());
+  // Publishers that number their packets transport-wide estimate their bandwidth themselves from our feedback
+  using_transport_feedback_ = stream_->isPublisher() && ext_processor.hasTransportWideCC();
 
   pickEstimator();
   initialized_ = true;
@@ -89,6 +96,9 @@ void BandwidthEstimationHandler::notifyUpdate() {
 
 void BandwidthEstimationHandler::process() {
   rbe_->Process();
+  if (using_transport_feedback_) {
+    sendMaxVideoBWREMB();
+  }
   std::weak_ptr<BandwidthEstimationHandler> weak_ptr = shared_from_this();
   worker_->scheduleFromNow([weak_ptr]() {
     if (auto this_ptr = weak_ptr.lock()) {
@@ -152,20 +162,34 @@ void BandwidthEstimationHandler::read(Context *ctx, PacketPtr packet) {
     running_ = true;
   }
   RtcpHeader *chead = reinterpret_cast<RtcpHeader*> (packet->data);
-  if (!chead->isRtcp() && packet->type == VIDEO_PACKET) {
-    if (parsePacket(packet)) {
-      int64_t arrival_time_ms = packet->received_time_ms;
-      arrival_time_ms = clock_->TimeInMilliseconds() - (ClockUtils::timePointToMs(clock::now()) - arrival_time_ms);
-      size_t payload_size = packet->length;
-      pickEstimatorFromHeader();
-      rbe_->IncomingPacket(arrival_time_ms, payload_size, header_);
-    } else {
-      ELOG_DEBUG("Packet not parsed %d", packet->type);
-    }
+  if (!chead->isRtcp() && (packet->type == VIDEO_PACKET ||
+                           (using_transport_feedback_ && packet->type == AUDIO_PACKET))) {
+    updateEstimator(packet);
   }
   ctx->fireRead(std::move(packet));
 }
 
+void BandwidthEstimationHandler::readProbe(PacketPtr packet) {
+  if (!initialized_ || !running_ || packet->type != VIDEO_PACKET) {
+    return;
+  }
+  updateEstimator(packet);
+}
+
+void BandwidthEstimationHandler::updateEstimator(PacketPtr packet) {
+  if (!parsePacket(packet)) {
+    ELOG_DEBUG("Packet not parsed %d", packet->type);
+    return;
+  }
+  // Packets are stamped when they hit the socket, so time spent queued in the workers is not seen as
+  // network delay. The age is kept in microseconds to not add rounding jitter to the delay estimates.
+  int64_t age_us = ClockUtils::timePointToUs(clock::now()) - packet->received_time_us;
+  int64_t arrival_time_ms = (clock_->TimeInMicroseconds() - age_us) / 1000;
+  size_t payload_size = packet->length;
+  pickEstimatorFromHeader();
+  rbe_->IncomingPacket(arrival_time_ms, payload_size, header_);
+}
+
 bool BandwidthEstimationHandler::parsePacket(PacketPtr packet) {
   const uint8_t* buffer = reinterpret_cast<uint8_t*>(packet->data);
   size_t length = packet->length;
@@ -196,6 +220,9 @@ void BandwidthEstimationHandler::write(Context *ctx, PacketPtr packet) {
 }
 
 void BandwidthEstimationHandler::pickEstimatorFromHeader() {
+  if (using_transport_feedback_) {
+    return;
+  }
   if (header_.extension.hasAbsoluteSendTime) {
     if (!using_absolute_send_time_) {
       using_absolute_send_time_ = true;
@@ -214,7 +241,13 @@ void BandwidthEstimationHandler::pickEstimatorFromHeader() {
 }
 
 void BandwidthEstimationHandler::pickEstimator() {
-  rbe_ = picker_->pickEstimator(using_absolute_send_time_, clock_, this);
+  if (using_transport_feedback_) {
+    rbe_ = picker_->pickTransportFeedbackGenerator(clock_, [this](webrtc::rtcp::TransportFeedback *feedback) {
+      sendTransportFeedback(feedback);
+    });
+  } else {
+    rbe_ = picker_->pickEstimator(using_absolute_send_time_, clock_, this);
+  }
   rbe_->SetMinBitrate(min_bitrate_bps_);
 }
 
@@ -240,6 +273,27 @@ void BandwidthEstimationHandler::sendREMBPacket() {
   }
 }
 
+// With transport-cc the REMB only caps the publisher to the max video bandwidth
+void BandwidthEstimationHandler::sendMaxVideoBWREMB() {
+  uint64_t now = ClockUtils::timePointToMs(clock::now());
+  if (max_video_bw_ == 0 || now - last_remb_time_ < kRembSendIntervallMs) {
+    return;
+  }
+  last_remb_time_ = now;
+  bitrate_ = max_video_bw_;
+  sendREMBPacket();
+}
+
+void BandwidthEstimationHandler::sendTransportFeedback(webrtc::rtcp::TransportFeedback *feedback) {
+  feedback->SetSenderSsrc(stream_->getVideoSinkSSRC());
+  rtc::Buffer buffer = feedback->Build();
+  // It goes back on the transport of the media it reports, which is not the same one without bundle
+  packetType type = stream_->isAudioSourceSSRC(feedback->media_ssrc()) ? AUDIO_PACKET : VIDEO_PACKET;
+  if (active_) {
+    getContext()->fireWrite(std::make_shared<DataPacket>(0, buffer.data<char>(), buffer.size(), type));
+  }
+}
+
 void BandwidthEstimationHandler::OnReceiveBitrateChanged(const std::vector<uint32_t>& ssrcs,
                                      uint32_t bitrate) {
   if (last_send_bitrate_ > 0) {
@@ -9,6 +9,7 @@
 #include "./logger.h"
 #include "./Stats.h"
 #include "pipeline/Handler.h"
+#include "rtp/RtcpTransportFeedbackGenerator.h"
 #include "rtp/RtpExtensionProcessor.h"
 
 #include "thread/Worker.h"
@@ -29,6 +30,8 @@ class RemoteBitrateEstimatorPicker {
  public:
   virtual std::unique_ptr<RemoteBitrateEstimator> pickEstimator(bool using_absolute_send_time,
     webrtc::Clock* const clock, RemoteBitrateObserver *observer);
+  virtual std::unique_ptr<RemoteBitrateEstimator> pickTransportFeedbackGenerator(webrtc::Clock* const clock,
+    RtcpTransportFeedbackGenerator::FeedbackSender send_feedback);
 };
 
 class BandwidthEstimationHandler: public Handler, public RemoteBitrateObserver,
@@ -37,6 +40,7 @@ class BandwidthEstimationHandler: public Handler, public RemoteBitrateObserver,
 
  public:
   static const uint32_t kRembMinimumBitrate;
+  static const uint8_t notified_updates = kBandwidthUpdate | kSdpUpdate;
 
   explicit BandwidthEstimationHandler(
     std::shared_ptr<RemoteBitrateEstimatorPicker> picker = std::make_shared<RemoteBitrateEstimatorPicker>());
@@ -54,12 +58,20 @@ class BandwidthEstimationHandler: public Handler, public RemoteBitrateObserver,
   void read(Context *ctx, PacketPtr packet) override;
   void write(Context *ctx, PacketPtr packet) override;
   void notifyUpdate() override;
+  /**
+   * Accounts the arrival of a video packet that does not go through the pipeline, like the padding-only
+   * retransmissions browsers send to probe the bandwidth, which still carry transport-wide sequence numbers
+   */
+  void readProbe(PacketPtr packet);
 
   void updateExtensionMaps(std::array<RTPExtensions, 10> video_map, std::array<RTPExtensions, 10> audio_map);
 
  private:
   void process();
   void sendREMBPacket();
+  void sendMaxVideoBWREMB();
+  void sendTransportFeedback(webrtc::rtcp::TransportFeedback *feedback);
+  void updateEstimator(PacketPtr packet);
   bool parsePacket(PacketPtr packet);
   RtpHeaderExtensionMap getHeaderExtensionMap(PacketPtr packet) const;
   void pickEstimatorFromHeader();
@@ -74,6 +86,7 @@ class BandwidthEstimationHandler: public Handler, public RemoteBitrateObserver,
   std::shared_ptr<RemoteBitrateEstimatorPicker> picker_;
   std::unique_ptr<RemoteBitrateEstimator> rbe_;
   bool using_absolute_send_time_;
+  bool using_transport_feedback_;
   uint32_t packets_since_absolute_send_time_;
   int min_bitrate_bps_;
   webrtc::RTPHeader header_;
@@ -8,7 +8,6 @@ DEFINE_LOGGER(FecReceiverHandler, "rtp.FecReceiverHandler");
 
 FecReceiverHandler::FecReceiverHandler() :
     enabled_{false} {
-  fec_receiver_.reset(webrtc::UlpfecReceiver::Create(this));
 }
 
 void FecReceiverHandler::setFecReceiver(std::unique_ptr<webrtc::UlpfecReceiver>&& fec_receiver) {  // NOLINT
@@ -51,6 +50,10 @@ void FecReceiverHandler::write(Context *ctx, PacketPtr packet) {
       webrtc::RTPHeader hacky_header;
       hacky_header.headerLength = rtp_header->getHeaderLength();
       hacky_header.sequenceNumber = rtp_header->getSeqNumber();
+      // Most streams never get here, so the receiver is only built for the first RED packet
+      if (!fec_receiver_) {
+        fec_receiver_.reset(webrtc::UlpfecReceiver::Create(this));
+      }
       // FEC copies memory, manages its own memory, including memory passed in callbacks (in the callback,
       // be sure to memcpy out of webrtc's buffers
       if (fec_receiver_->AddReceivedRedPacket(hacky_header,
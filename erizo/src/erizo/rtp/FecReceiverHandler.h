@@ -15,9 +15,12 @@ class FecReceiverHandler: public OutboundHandler, public webrtc::RtpData {
   DECLARE_LOGGER();
 
  public:
+  static const uint8_t notified_updates = kSdpUpdate | kLayerConstraintsUpdate;
+
   FecReceiverHandler();
 
   void setFecReceiver(std::unique_ptr<webrtc::UlpfecReceiver>&& fec_receiver);  // NOLINT
+  bool hasFecReceiver() { return fec_receiver_ != nullptr; }
 
   void enable() override;
   void disable() override;
@@ -18,6 +18,9 @@ class LayerBitrateCalculationHandler: public OutboundHandler {
 
 
  public:
+  static const uint8_t write_packets = kRtpVideoPackets;
+  static const uint8_t notified_updates = kSdpUpdate;
+
   LayerBitrateCalculationHandler();
 
   void enable() override;
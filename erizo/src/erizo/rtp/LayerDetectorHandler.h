@@ -40,6 +40,9 @@ class LayerDetectorHandler: public InboundHandler, public std::enable_shared_fro
 
 
  public:
+  static const uint8_t read_packets = kRtpVideoPackets;
+  static const uint8_t notified_updates = kSdpUpdate;
+
   explicit LayerDetectorHandler(std::shared_ptr<erizo::Clock> the_clock = std::make_shared<erizo::SteadyClock>());
 
   void enable() override;
@@ -1,35 +1,128 @@
 #include "rtp/PacketBufferService.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace erizo {
 DEFINE_LOGGER(PacketBufferService, "rtp.PacketBufferService");
 
-PacketBufferService::PacketBufferService(): audio_{kServicePacketBufferSize},
-  video_{kServicePacketBufferSize} {
+static uint16_t getSeqNumber(const PacketPtr &packet) {
+  return reinterpret_cast<RtpHeader*>(packet->data)->getSeqNumber();
+}
+
+static bool isOlder(uint16_t seq_num, uint16_t other_seq_num) {
+  return static_cast<int16_t>(seq_num - other_seq_num) < 0;
+}
+
+PacketBufferService::PacketBufferService(bool has_video, std::shared_ptr<Clock> the_clock)
+  : has_video_{has_video}, clock_{the_clock}, buffer_time_{kMinPacketBufferTime},
+    buffered_bytes_{0} {
 }
 
 void PacketBufferService::insertPacket(PacketPtr packet) {
-  RtpHeader *head = reinterpret_cast<RtpHeader*> (packet->data);
+  time_point now = clock_->now();
   switch (packet->type) {
     case VIDEO_PACKET:
-      video_[getIndexInBuffer(head->getSeqNumber())] = packet;
+      if (has_video_) {
+        bufferPacket(&video_, std::move(packet), now);
+      }
       break;
     case AUDIO_PACKET:
-      audio_[getIndexInBuffer(head->getSeqNumber())] = packet;
+      bufferPacket(&audio_, std::move(packet), now);
       break;
     default:
       ELOG_INFO("message: Trying to store an unknown packet");
       break;
   }
+  removeOldPackets(now);
 }
 
 PacketPtr PacketBufferService::getVideoPacket(uint16_t seq_num) {
-  return video_[getIndexInBuffer(seq_num)];
+  return getPacket(&video_, seq_num);
 }
+
 PacketPtr PacketBufferService::getAudioPacket(uint16_t seq_num) {
-  return audio_[getIndexInBuffer(seq_num)];
+  return getPacket(&audio_, seq_num);
+}
+
+void PacketBufferService::setRoundTripTime(duration round_trip_time) {
+  buffer_time_ = std::min(std::max(kRoundTripsInPacketBuffer * round_trip_time, kMinPacketBufferTime),
+                          kMaxPacketBufferTime);
+}
+
+void PacketBufferService::bufferPacket(PacketQueue *packets, PacketPtr packet, time_point now) {
+  uint16_t seq_num = getSeqNumber(packet);
+  // Packets can be reordered or sent twice before they get here, keep them sorted and only the last copy
+  auto it = packets->end();
+  if (!packets->empty() && !isOlder(packets->back().seq_num, seq_num)) {
+    it = isOlder(seq_num, packets->front().seq_num) ? packets->begin() : findPacket(packets, seq_num);
+  }
+  if (it == packets->end() || it->seq_num != seq_num) {
+    it = packets->emplace(it);
+    it->bytes = 0;
+  }
+  BufferedPacket &buffered = *it;
+  buffered_bytes_ -= buffered.bytes;
+  buffered.time = now;
+  buffered.seq_num = seq_num;
+  buffered.rewritten = false;
+  buffered.bytes = sizeof(BufferedPacket);
+  PacketPtr source = std::move(packet->source_packet);
+  if (source && source->length == packet->length) {
+    buffered.rewritten = true;
+    buffered.comp = packet->comp;
+    buffered.length = packet->length;
+    memcpy(buffered.first_bytes, packet->data, std::min(packet->length, kRewrittenPacketBytes));
+    buffered.packet = std::move(source);
+  } else {
+    // The packet no longer points to its source, so a kept copy does not keep both alive
+    buffered.packet = std::move(packet);
+    buffered.bytes += sizeof(DataPacket);
+  }
+  buffered_bytes_ += buffered.bytes;
 }
-uint16_t PacketBufferService::getIndexInBuffer(uint16_t seq_num) {
-  return seq_num % kServicePacketBufferSize;
+
+PacketBufferService::PacketQueue::iterator PacketBufferService::findPacket(PacketQueue *packets, uint16_t seq_num) {
+  return std::lower_bound(packets->begin(), packets->end(), seq_num,
+    [](const BufferedPacket &buffered, uint16_t seq_num) {
+      return isOlder(buffered.seq_num, seq_num);
+    });
+}
+
+PacketPtr PacketBufferService::getPacket(PacketQueue *packets, uint16_t seq_num) {
+  auto it = findPacket(packets, seq_num);
+  if (it == packets->end() || it->seq_num != seq_num) {
+    return nullptr;
+  }
+  if (!it->rewritten) {
+    return it->packet;
+  }
+  PacketPtr packet = std::make_shared<DataPacket>(*it->packet);
+  memcpy(packet->data, it->first_bytes, std::min(it->length, kRewrittenPacketBytes));
+  packet->comp = it->comp;
+  return packet;
+}
+
+void PacketBufferService::removeOldPackets(time_point now) {
+  time_point oldest_time = now - buffer_time_;
+  while (!audio_.empty() && audio_.front().time < oldest_time) {
+    popOldest(&audio_);
+  }
+  while (!video_.empty() && video_.front().time < oldest_time) {
+    popOldest(&video_);
+  }
+  while (buffered_bytes_ > kMaxPacketBufferBytes) {
+    if (video_.empty() || (!audio_.empty() && audio_.front().time < video_.front().time)) {
+      popOldest(&audio_);
+    } else {
+      popOldest(&video_);
+    }
+  }
+}
+
+void PacketBufferService::popOldest(PacketQueue *packets) {
+  buffered_bytes_ -= packets->front().bytes;
+  packets->pop_front();
 }
 
 }  // namespace erizo
@@ -1,19 +1,33 @@
 #ifndef ERIZO_SRC_ERIZO_RTP_PACKETBUFFERSERVICE_H_
 #define ERIZO_SRC_ERIZO_RTP_PACKETBUFFERSERVICE_H_
 
+#include <deque>
+#include <memory>
+
 #include "./logger.h"
 #include "./MediaDefinitions.h"
+#include "lib/Clock.h"
 #include "rtp/RtpHeaders.h"
 #include "pipeline/Service.h"
 
-static constexpr uint16_t kServicePacketBufferSize = 256;
+// Packets are kept for a few round trips, so the NACKs of far away subscribers still find them, but never for less
+// than the minimum time nor more than the maximum one. Audio and video together never retain more than the max bytes.
+static constexpr erizo::duration kMinPacketBufferTime = std::chrono::milliseconds(500);
+static constexpr erizo::duration kMaxPacketBufferTime = std::chrono::seconds(5);
+static constexpr int kRoundTripsInPacketBuffer = 3;
+static constexpr size_t kMaxPacketBufferBytes = 8 * 1024 * 1024;
+// Handlers rewrite the RTP header and the start of the payload (picture ids) of the packets they send, never the rest
+// of it, so a sent packet with the length of its source only differs from it in these bytes
+static constexpr int kRewrittenPacketBytes = 64;
 
 namespace erizo {
 class PacketBufferService: public Service {
  public:
   DECLARE_LOGGER();
 
-  PacketBufferService();
+  // Streams without video don't keep video packets, getVideoPacket returns nullptr there
+  explicit PacketBufferService(bool has_video = true,
+                               std::shared_ptr<Clock> the_clock = std::make_shared<SteadyClock>());
   ~PacketBufferService() {}
 
   PacketBufferService(const PacketBufferService&& service);
@@ -23,12 +37,42 @@ class PacketBufferService: public Service {
   PacketPtr getVideoPacket(uint16_t seq_num);
   PacketPtr getAudioPacket(uint16_t seq_num);
 
+  void setRoundTripTime(duration round_trip_time);
+  duration getBufferTime() { return buffer_time_; }
+  size_t getBufferedPackets() { return audio_.size() + video_.size(); }
+  size_t getBufferedBytes() { return buffered_bytes_; }
+
  private:
-  uint16_t getIndexInBuffer(uint16_t seq_num);
+  struct BufferedPacket {
+    time_point time;
+    uint16_t seq_num;
+    // The packet as it was sent or, when it has the length of its source, the source one of the publisher, shared
+    // with the buffers of all its subscribers. Then only what was sent instead of its first bytes is kept here.
+    PacketPtr packet;
+    bool rewritten;
+    // What this entry keeps alive on its own, a shared source is not counted
+    size_t bytes;
+    int comp;
+    int length;
+    char first_bytes[kRewrittenPacketBytes];
+  };
+  typedef std::deque<BufferedPacket> PacketQueue;
+
+  void bufferPacket(PacketQueue *packets, PacketPtr packet, time_point now);
+  // First packet that is not older than seq_num
+  PacketQueue::iterator findPacket(PacketQueue *packets, uint16_t seq_num);
+  PacketPtr getPacket(PacketQueue *packets, uint16_t seq_num);
+  void removeOldPackets(time_point now);
+  void popOldest(PacketQueue *packets);
 
  private:
-  std::vector<PacketPtr> audio_;
-  std::vector<PacketPtr> video_;
+  bool has_video_;
+  std::shared_ptr<Clock> clock_;
+  duration buffer_time_;
+  size_t buffered_bytes_;
+  // Sorted by sequence number, oldest first
+  PacketQueue audio_;
+  PacketQueue video_;
 };
 
 }  // namespace erizo
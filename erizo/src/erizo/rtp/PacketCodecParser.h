@@ -13,6 +13,8 @@ class PacketCodecParser: public InboundHandler {
 
 
  public:
+  static const uint8_t notified_updates = kSdpUpdate;
+
   PacketCodecParser();
 
   void enable() override;
@@ -16,6 +16,10 @@ class PliPacerHandler: public Handler, public std::enable_shared_from_this<PliPa
   DECLARE_LOGGER();
 
  public:
+  static const uint8_t read_packets = kRtpVideoPackets;
+  static const uint8_t write_packets = kRtcpFeedbackPackets;
+  static const uint8_t notified_updates = kSdpUpdate;
+
   static constexpr duration kMinPLIPeriod = std::chrono::milliseconds(200);
   static constexpr duration kKeyframeTimeout = std::chrono::seconds(10);
 
@@ -21,6 +21,10 @@ class QualityFilterHandler: public Handler, public std::enable_shared_from_this<
 
 
  public:
+  static const uint8_t read_packets = kRtcpFeedbackPackets | kRtcpReportPackets;
+  static const uint8_t write_packets = kRtpVideoPackets;
+  static const uint8_t notified_updates = kBandwidthUpdate | kSdpUpdate;
+
   QualityFilterHandler();
 
   void enable() override;
@@ -173,7 +173,7 @@ void QualityManager::selectLayer(bool try_higher_layers) {
           below_min_layer, spatial_layer_, next_spatial_layer, slideshow_fallback_active_);
       HandlerManager *manager = getContext()->getPipelineShared()->getService<HandlerManager>().get();
       if (manager) {
-        manager->notifyUpdateToHandlers();
+        manager->notifyUpdateToHandlers(kLayerConstraintsUpdate);
       }
       if (below_min_layer && next_spatial_layer != 0) {
         ELOG_DEBUG("message: Spatial layer is below minimum desired layer %d, activating keyframe resquests",
@@ -291,7 +291,7 @@ void QualityManager::setPadding(bool enabled) {
     padding_enabled_ = enabled;
     HandlerManager *manager = getContext()->getPipelineShared()->getService<HandlerManager>().get();
     if (manager) {
-      manager->notifyUpdateToHandlers();
+      manager->notifyUpdateToHandlers(kLayerConstraintsUpdate);
     }
   }
 }
@@ -29,6 +29,8 @@ class RtcpFeedbackGenerationHandler: public Handler {
 
 
  public:
+  static const uint8_t notified_updates = kSdpUpdate;
+
   explicit RtcpFeedbackGenerationHandler(bool nacks_enabled = true,
       std::shared_ptr<Clock> the_clock = std::make_shared<SteadyClock>());
 
@@ -16,6 +16,8 @@ class RtcpProcessorHandler: public Handler {
   DECLARE_LOGGER();
 
  public:
+  static const uint8_t notified_updates = kSdpUpdate;
+
   RtcpProcessorHandler();
 
   void enable() override;
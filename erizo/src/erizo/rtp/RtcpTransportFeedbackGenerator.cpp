@@ -0,0 +1,104 @@
+#include "rtp/RtcpTransportFeedbackGenerator.h"
+
+#include <algorithm>
+
+namespace erizo {
+
+DEFINE_LOGGER(RtcpTransportFeedbackGenerator, "rtp.RtcpTransportFeedbackGenerator");
+
+const int RtcpTransportFeedbackGenerator::kBackWindowMs = 500;
+const int RtcpTransportFeedbackGenerator::kSendIntervalMs = 100;
+
+RtcpTransportFeedbackGenerator::RtcpTransportFeedbackGenerator(webrtc::Clock* const clock,
+                                                               FeedbackSender send_feedback) :
+  clock_{clock}, send_feedback_{send_feedback}, last_process_time_ms_{-1}, media_ssrc_{0}, feedback_seq_num_{0},
+  window_start_seq_num_{-1} {
+}
+
+void RtcpTransportFeedbackGenerator::IncomingPacket(int64_t arrival_time_ms, size_t payload_size,
+                                                    const webrtc::RTPHeader& header) {
+  if (!header.extension.hasTransportSequenceNumber) {
+    ELOG_DEBUG("message: Packet without transport sequence number, ssrc: %u", header.ssrc);
+    return;
+  }
+  media_ssrc_ = header.ssrc;
+  onPacketArrival(header.extension.transportSequenceNumber, arrival_time_ms);
+}
+
+bool RtcpTransportFeedbackGenerator::LatestEstimate(std::vector<uint32_t>* ssrcs, uint32_t* bitrate_bps) const {
+  return false;
+}
+
+int64_t RtcpTransportFeedbackGenerator::TimeUntilNextProcess() {
+  if (last_process_time_ms_ == -1) {
+    return 0;
+  }
+  int64_t now = clock_->TimeInMilliseconds();
+  return std::max(last_process_time_ms_ + kSendIntervalMs - now, static_cast<int64_t>(0));
+}
+
+void RtcpTransportFeedbackGenerator::Process() {
+  last_process_time_ms_ = clock_->TimeInMilliseconds();
+  bool more_to_build = true;
+  while (more_to_build) {
+    webrtc::rtcp::TransportFeedback feedback_packet;
+    more_to_build = buildFeedbackPacket(&feedback_packet);
+    if (more_to_build) {
+      send_feedback_(&feedback_packet);
+    }
+  }
+}
+
+void RtcpTransportFeedbackGenerator::onPacketArrival(uint16_t seq_num, int64_t arrival_time_ms) {
+  if (arrival_time_ms < 0) {
+    ELOG_WARN("message: Arrival time out of bounds, arrival_time: %ld", arrival_time_ms);
+    return;
+  }
+  int64_t unwrapped_seq_num = unwrapper_.Unwrap(seq_num);
+  if (window_start_seq_num_ != -1 && unwrapped_seq_num > window_start_seq_num_ + 0xFFFF / 2) {
+    ELOG_DEBUG("message: Skipping reordered packet, seq_num: %u, window_start: %ld",
+               seq_num, window_start_seq_num_);
+    return;
+  }
+
+  if (packet_arrival_times_.lower_bound(window_start_seq_num_) == packet_arrival_times_.end()) {
+    // Everything was reported, so the next feedback packet starts here and the old arrivals can go
+    for (auto it = packet_arrival_times_.begin(); it != packet_arrival_times_.end() &&
+         it->first < unwrapped_seq_num && arrival_time_ms - it->second >= kBackWindowMs;) {
+      it = packet_arrival_times_.erase(it);
+    }
+  }
+
+  if (window_start_seq_num_ == -1 || unwrapped_seq_num < window_start_seq_num_) {
+    window_start_seq_num_ = unwrapped_seq_num;
+  }
+  // Only the first arrival of a packet counts
+  packet_arrival_times_.emplace(unwrapped_seq_num, arrival_time_ms);
+}
+
+bool RtcpTransportFeedbackGenerator::buildFeedbackPacket(webrtc::rtcp::TransportFeedback *feedback_packet) {
+  auto it = packet_arrival_times_.lower_bound(window_start_seq_num_);
+  if (it == packet_arrival_times_.end()) {
+    return false;
+  }
+  const int64_t first_seq_num = it->first;
+  feedback_packet->SetMediaSsrc(media_ssrc_);
+  // The base is the first packet we expect even if it never arrived, but the time is the one of the first that did
+  feedback_packet->SetBase(static_cast<uint16_t>(window_start_seq_num_ & 0xFFFF), it->second * 1000);
+  feedback_packet->SetFeedbackSequenceNumber(feedback_seq_num_++);
+  for (; it != packet_arrival_times_.end(); ++it) {
+    if (!feedback_packet->AddReceivedPacket(static_cast<uint16_t>(it->first & 0xFFFF), it->second * 1000)) {
+      if (it->first == first_seq_num) {
+        ELOG_WARN("message: Could not add packet to transport feedback, seq_num: %ld", it->first);
+        window_start_seq_num_ = it->first + 1;
+        return false;
+      }
+      // The packet is full, the rest go in the next one
+      break;
+    }
+    window_start_seq_num_ = it->first + 1;
+  }
+  return true;
+}
+
+}  // namespace erizo
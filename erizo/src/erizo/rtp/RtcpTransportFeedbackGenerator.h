@@ -0,0 +1,58 @@
+#ifndef ERIZO_SRC_ERIZO_RTP_RTCPTRANSPORTFEEDBACKGENERATOR_H_
+#define ERIZO_SRC_ERIZO_RTP_RTCPTRANSPORTFEEDBACKGENERATOR_H_
+
+#include <functional>
+#include <map>
+#include <vector>
+
+#include "./logger.h"
+
+#include "webrtc/modules/include/module_common_types.h"
+#include "webrtc/modules/remote_bitrate_estimator/include/remote_bitrate_estimator.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+#include "webrtc/system_wrappers/include/clock.h"
+
+namespace erizo {
+
+// Reports back to a transport-cc sender when each of its packets arrived, so it can estimate the bandwidth itself.
+// It follows webrtc's RemoteEstimatorProxy, but hands the feedback to a callback instead of a PacketRouter. It
+// never estimates anything, so it has no observer.
+class RtcpTransportFeedbackGenerator : public webrtc::RemoteBitrateEstimator {
+  DECLARE_LOGGER();
+
+ public:
+  typedef std::function<void(webrtc::rtcp::TransportFeedback*)> FeedbackSender;
+
+  static const int kBackWindowMs;
+  static const int kSendIntervalMs;
+
+  RtcpTransportFeedbackGenerator(webrtc::Clock* const clock, FeedbackSender send_feedback);
+
+  void IncomingPacket(int64_t arrival_time_ms, size_t payload_size, const webrtc::RTPHeader& header) override;
+  void RemoveStream(uint32_t ssrc) override {}
+  bool LatestEstimate(std::vector<uint32_t>* ssrcs, uint32_t* bitrate_bps) const override;
+  void SetMinBitrate(int min_bitrate_bps) override {}
+  void OnRttUpdate(int64_t avg_rtt_ms, int64_t max_rtt_ms) override {}
+  int64_t TimeUntilNextProcess() override;
+  void Process() override;
+
+ private:
+  void onPacketArrival(uint16_t seq_num, int64_t arrival_time_ms);
+  bool buildFeedbackPacket(webrtc::rtcp::TransportFeedback *feedback_packet);
+
+ private:
+  webrtc::Clock* const clock_;
+  FeedbackSender send_feedback_;
+  int64_t last_process_time_ms_;
+  uint32_t media_ssrc_;
+  uint8_t feedback_seq_num_;
+  webrtc::SequenceNumberUnwrapper unwrapper_;
+  // First unwrapped sequence number of the next feedback packet
+  int64_t window_start_seq_num_;
+  // Older ones are kept for a while, in case they have to be reported again after a reordering
+  std::map<int64_t, int64_t> packet_arrival_times_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_RTP_RTCPTRANSPORTFEEDBACKGENERATOR_H_
@@ -2,6 +2,7 @@
  * RtpExtensionProcessor.cpp
  */
 #include "rtp/RtpExtensionProcessor.h"
+#include <algorithm>
 #include <map>
 #include <string>
 #include <vector>
@@ -12,7 +13,7 @@ namespace erizo {
 DEFINE_LOGGER(RtpExtensionProcessor, "rtp.RtpExtensionProcessor");
 
 RtpExtensionProcessor::RtpExtensionProcessor(const std::vector<erizo::ExtMap> ext_mappings) :
-    ext_mappings_{ext_mappings}, video_orientation_{kVideoRotation_0} {
+    ext_mappings_{ext_mappings}, video_orientation_{kVideoRotation_0}, transport_seq_num_{0} {
   translationMap_["urn:ietf:params:rtp-hdrext:ssrc-audio-level"] = SSRC_AUDIO_LEVEL;
   translationMap_["http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time"] = ABS_SEND_TIME;
   translationMap_["urn:ietf:params:rtp-hdrext:toffset"] = TOFFSET;
@@ -91,7 +92,13 @@ uint32_t RtpExtensionProcessor::processRtpExtensions(PacketPtr p) {
         extByte = (uint8_t)(*extBuffer);
         extId = extByte >> 4;
         extLength = extByte & 0x0F;
-        if (extId != 0 && extMap[extId] != 0) {
+        if (extId == 0) {
+          // Padding byte
+          extBuffer++;
+          currentPlace++;
+          continue;
+        }
+        if (extMap[extId] != 0) {
           switch (extMap[extId]) {
             case ABS_SEND_TIME:
               processAbsSendTime(extBuffer);
@@ -99,6 +106,9 @@ uint32_t RtpExtensionProcessor::processRtpExtensions(PacketPtr p) {
             case VIDEO_ORIENTATION:
               processVideoOrientation(extBuffer);
               break;
+            case TRANSPORT_CC:
+              processTransportSequenceNumber(extBuffer, extLength);
+              break;
             default:
               break;
           }
@@ -111,6 +121,10 @@ uint32_t RtpExtensionProcessor::processRtpExtensions(PacketPtr p) {
   return len;
 }
 
+bool RtpExtensionProcessor::hasTransportWideCC() {
+  return std::find(ext_map_video_.begin(), ext_map_video_.end(), TRANSPORT_CC) != ext_map_video_.end();
+}
+
 VideoRotation RtpExtensionProcessor::getVideoRotation() {
   return video_orientation_;
 }
@@ -137,6 +151,18 @@ uint32_t RtpExtensionProcessor::processAbsSendTime(char* buf) {
   return 0;
 }
 
+uint32_t RtpExtensionProcessor::processTransportSequenceNumber(char* buf, uint8_t length) {
+  // The numbers are the ones of this transport, not the ones the packet had when its publisher sent it
+  if (length != 1) {
+    return 0;
+  }
+  uint8_t *seq_num = reinterpret_cast<uint8_t*>(buf + 1);
+  seq_num[0] = transport_seq_num_ >> 8;
+  seq_num[1] = transport_seq_num_ & 0xFF;
+  transport_seq_num_++;
+  return 0;
+}
+
 uint32_t RtpExtensionProcessor::stripExtension(char* buf, int len) {
   // TODO(pedro)
   return len;
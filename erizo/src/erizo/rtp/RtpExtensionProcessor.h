@@ -33,6 +33,8 @@ class RtpExtensionProcessor{
   void setSdpInfo(std::shared_ptr<SdpInfo> theInfo);
   uint32_t processRtpExtensions(PacketPtr p);
   VideoRotation getVideoRotation();
+  // Whether the remote peer numbers the packets it sends with transport-wide sequence numbers
+  bool hasTransportWideCC();
 
   std::array<RTPExtensions, 10> getVideoExtensionMap() {
     return ext_map_video_;
@@ -50,8 +52,10 @@ class RtpExtensionProcessor{
   std::array<RTPExtensions, 10> ext_map_video_, ext_map_audio_;
   std::map<std::string, uint8_t> translationMap_;
   VideoRotation video_orientation_;
+  uint16_t transport_seq_num_;
   uint32_t processAbsSendTime(char* buf);
   uint32_t processVideoOrientation(char* buf);
+  uint32_t processTransportSequenceNumber(char* buf, uint8_t length);
   uint32_t stripExtension(char* buf, int len);
 };
 
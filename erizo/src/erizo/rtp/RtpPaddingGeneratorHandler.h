@@ -19,6 +19,10 @@ class RtpPaddingGeneratorHandler: public Handler, public std::enable_shared_from
   DECLARE_LOGGER();
 
  public:
+  static const uint8_t read_packets = kNoPackets;
+  static const uint8_t write_packets = kRtpVideoPackets;
+  static const uint8_t notified_updates = kBandwidthUpdate | kLayerConstraintsUpdate;
+
   explicit RtpPaddingGeneratorHandler(std::shared_ptr<erizo::Clock> the_clock = std::make_shared<erizo::SteadyClock>());
 
   void enable() override;
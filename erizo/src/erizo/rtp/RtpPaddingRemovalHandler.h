@@ -17,6 +17,8 @@ class RtpPaddingRemovalHandler: public Handler, public std::enable_shared_from_t
 
 
  public:
+  static const uint8_t notified_updates = kSdpUpdate;
+
   RtpPaddingRemovalHandler();
 
   void enable() override;
@@ -2,6 +2,7 @@
 #include "rtp/RtpRetransmissionHandler.h"
 
 #include <algorithm>
+#include <cstdlib>
 
 #include "rtp/RtpUtils.h"
 
@@ -16,7 +17,8 @@ RtpRetransmissionHandler::RtpRetransmissionHandler(std::shared_ptr<erizo::Clock>
     stream_{nullptr},
     initialized_{false}, enabled_{true},
     bucket_{static_cast<uint64_t>(kDefaultBitrate * kMarginRtxBitrate), kBurstSize, clock_},
-    last_bitrate_time_{clock_->now()} {}
+    last_bitrate_time_{clock_->now()},
+    rtx_seq_num_{static_cast<uint16_t>(std::rand())} {}
 
 
 void RtpRetransmissionHandler::enable() {
@@ -47,6 +49,33 @@ MovingIntervalRateStat& RtpRetransmissionHandler::getRtxBitrateStat() {
   return static_cast<erizo::MovingIntervalRateStat&>(stats_->getNode()["total"]["rtxBitrate"]);
 }
 
+void RtpRetransmissionHandler::incrStat(const std::string &stat) {
+  if (!stats_->getNode()["total"].hasChild(stat)) {
+    stats_->getNode()["total"].insertStat(stat, CumulativeStat{1});
+    return;
+  }
+  stats_->getNode()["total"][stat]++;
+}
+
+PacketPtr RtpRetransmissionHandler::getRetransmission(const PacketPtr &packet) {
+  uint32_t rtx_ssrc = stream_->getVideoSinkRtxSSRC();
+  SdpInfo *remote_sdp = stream_->getRemoteSdpInfo();
+  if (packet->type != VIDEO_PACKET || rtx_ssrc == 0 || !remote_sdp) {
+    return packet;
+  }
+  RtpHeader *head = reinterpret_cast<RtpHeader*>(packet->data);
+  unsigned int rtx_payload_type = remote_sdp->getVideoRtxPT(head->getPayloadType());
+  if (rtx_payload_type == 0) {
+    return packet;
+  }
+  PacketPtr rtx_packet = RtpUtils::makeRtxPacket(packet, rtx_ssrc, rtx_payload_type, rtx_seq_num_);
+  if (!rtx_packet) {
+    return packet;
+  }
+  rtx_seq_num_++;
+  return rtx_packet;
+}
+
 uint64_t RtpRetransmissionHandler::getBitrateCalculated() {
   if (!stats_->getNode()["total"].hasChild("bitrateCalculated")) {
     return 0;
@@ -99,11 +128,13 @@ void RtpRetransmissionHandler::read(Context *ctx, PacketPtr packet) {
             }
             RtpHeader *recovered_head = reinterpret_cast<RtpHeader*> (recovered->data);
             if (recovered_head->getSeqNumber() == seq_num) {
+              incrStat("rtxBufferHits");
               getRtxBitrateStat() += recovered->length;
-              getContext()->fireWrite(recovered);
+              getContext()->fireWrite(getRetransmission(recovered));
               continue;
             }
           }
+          incrStat("rtxBufferMisses");
           ELOG_DEBUG("Packet missed in buffer %d", seq_num);
           is_fully_recovered = false;
           }
@@ -127,4 +158,17 @@ void RtpRetransmissionHandler::write(Context *ctx, PacketPtr packet) {
   ctx->fireWrite(std::move(packet));
 }
 
+void RtpRetransmissionHandler::writeBatch(Context *ctx, PacketBatch packets) {
+  if (!initialized_) {
+    return;
+  }
+  for (const PacketPtr &packet : packets) {
+    RtcpHeader *chead = reinterpret_cast<RtcpHeader*> (packet->data);
+    if (!chead->isRtcp()) {
+      packet_buffer_->insertPacket(packet);
+    }
+  }
+  ctx->fireWriteBatch(std::move(packets));
+}
+
 }  // namespace erizo
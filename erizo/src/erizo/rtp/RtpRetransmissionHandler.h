@@ -2,6 +2,7 @@
 #define ERIZO_SRC_ERIZO_RTP_RTPRETRANSMISSIONHANDLER_H_
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "pipeline/Handler.h"
@@ -23,6 +24,8 @@ class MediaStream;
 
 class RtpRetransmissionHandler : public Handler {
  public:
+  static const uint8_t notified_updates = kSdpUpdate;
+
   DECLARE_LOGGER();
 
   explicit RtpRetransmissionHandler(std::shared_ptr<erizo::Clock> the_clock = std::make_shared<erizo::SteadyClock>());
@@ -36,10 +39,15 @@ class RtpRetransmissionHandler : public Handler {
 
   void read(Context *ctx, PacketPtr packet) override;
   void write(Context *ctx, PacketPtr packet) override;
+  void writeBatch(Context *ctx, PacketBatch packets) override;
   void notifyUpdate() override;
 
  private:
   MovingIntervalRateStat& getRtxBitrateStat();
+  // Counts the NACKed packets found (rtxBufferHits) and not found (rtxBufferMisses) in the buffer
+  void incrStat(const std::string &stat);
+  // The packet wrapped for the RTX stream when the subscriber negotiated it, the packet itself otherwise
+  PacketPtr getRetransmission(const PacketPtr &packet);
   uint64_t getBitrateCalculated();
   void calculateRtxBitrate();
 
@@ -51,6 +59,7 @@ class RtpRetransmissionHandler : public Handler {
   std::shared_ptr<PacketBufferService> packet_buffer_;
   TokenBucket bucket_;
   erizo::time_point last_bitrate_time_;
+  uint16_t rtx_seq_num_;
 };
 }  // namespace erizo
 
@@ -22,6 +22,10 @@ class RtpSlideShowHandler : public Handler {
   DECLARE_LOGGER();
 
  public:
+  static const uint8_t read_packets = kRtcpFeedbackPackets | kRtcpReportPackets;
+  static const uint8_t write_packets = kRtpVideoPackets;
+  static const uint8_t notified_updates = kLayerConstraintsUpdate;
+
   explicit RtpSlideShowHandler(std::shared_ptr<Clock> the_clock = std::make_shared<SteadyClock>());
 
   void enable() override;
@@ -26,6 +26,8 @@ class RtpTrackMuteHandler: public Handler {
   DECLARE_LOGGER();
 
  public:
+  static const uint8_t notified_updates = kMuteUpdate;
+
   RtpTrackMuteHandler();
   void muteAudio(bool active);
   void muteVideo(bool active);
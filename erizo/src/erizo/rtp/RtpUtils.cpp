@@ -7,6 +7,8 @@ namespace erizo {
 
 
 constexpr int kMaxPacketSize = 1500;
+// The original sequence number, at the start of the payload of RTX packets
+constexpr int kRtxHeaderLength = 2;
 
 bool RtpUtils::sequenceNumberLessThan(uint16_t first, uint16_t last) {
   return RtpUtils::numberLessThan(first, last, 16);
@@ -68,6 +70,33 @@ bool RtpUtils::isFIR(PacketPtr packet) {
   return is_fir;
 }
 
+uint8_t RtpUtils::getPacketClass(const PacketPtr &packet) {
+  RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(packet->data);
+  if (packet->length < 4) {
+    return kAllPackets;
+  }
+  if (!chead->isRtcp()) {
+    switch (packet->type) {
+      case AUDIO_PACKET:
+        return kRtpAudioPackets;
+      case VIDEO_PACKET:
+        return kRtpVideoPackets;
+      default:
+        return kAllPackets;
+    }
+  }
+  uint8_t packet_class = kNoPackets;
+  int offset = 0;
+  while (offset + 4 <= packet->length) {
+    chead = reinterpret_cast<RtcpHeader*>(packet->data + offset);
+    uint8_t packet_type = chead->getPacketType();
+    packet_class |= packet_type == RTCP_RTP_Feedback_PT || packet_type == RTCP_PS_Feedback_PT ?
+      kRtcpFeedbackPackets : kRtcpReportPackets;
+    offset += (ntohs(chead->length) + 1) * 4;
+  }
+  return packet_class;
+}
+
 PacketPtr RtpUtils::createPLI(uint32_t source_ssrc, uint32_t sink_ssrc) {
   RtcpHeader pli;
   pli.setPacketType(RTCP_PS_Feedback_PT);
@@ -160,4 +189,43 @@ PacketPtr RtpUtils::makePaddingPacket(PacketPtr packet, uint8_t padding_size) {
   return std::make_shared<DataPacket>(packet->comp, packet_buffer, packet_length, packet->type);
 }
 
+PacketPtr RtpUtils::makeRtxPacket(const PacketPtr &packet, uint32_t rtx_ssrc, uint8_t rtx_payload_type,
+                                  uint16_t rtx_seq_num) {
+  RtpHeader *header = reinterpret_cast<RtpHeader*>(packet->data);
+  int header_length = header->getHeaderLength();
+  if (header_length > packet->length || packet->length + kRtxHeaderLength > kMaxPlainRtpPacketLength) {
+    return nullptr;
+  }
+  auto rtx_packet = std::make_shared<DataPacket>(*packet);
+  char *payload = rtx_packet->data + header_length;
+  memmove(payload + kRtxHeaderLength, payload, packet->length - header_length);
+  uint16_t original_seq_num = htons(header->getSeqNumber());
+  memcpy(payload, &original_seq_num, kRtxHeaderLength);
+  rtx_packet->length += kRtxHeaderLength;
+
+  RtpHeader *rtx_header = reinterpret_cast<RtpHeader*>(rtx_packet->data);
+  rtx_header->setSSRC(rtx_ssrc);
+  rtx_header->setPayloadType(rtx_payload_type);
+  rtx_header->setSeqNumber(rtx_seq_num);
+  return rtx_packet;
+}
+
+bool RtpUtils::unwrapRtxPacket(const PacketPtr &packet, uint32_t ssrc, uint8_t payload_type) {
+  RtpHeader *header = reinterpret_cast<RtpHeader*>(packet->data);
+  int header_length = header->getHeaderLength();
+  if (packet->length - header_length - getPaddingLength(packet) < kRtxHeaderLength) {
+    return false;
+  }
+  char *payload = packet->data + header_length;
+  uint16_t original_seq_num;
+  memcpy(&original_seq_num, payload, kRtxHeaderLength);
+  memmove(payload, payload + kRtxHeaderLength, packet->length - header_length - kRtxHeaderLength);
+  packet->length -= kRtxHeaderLength;
+
+  header->setSSRC(ssrc);
+  header->setPayloadType(payload_type);
+  header->setSeqNumber(ntohs(original_seq_num));
+  return true;
+}
+
 }  // namespace erizo
@@ -25,6 +25,9 @@ class RtpUtils {
 
   static bool isFIR(PacketPtr packet);
 
+  // kRtpAudioPackets or kRtpVideoPackets for RTP, the classes of all its blocks for RTCP, kAllPackets if unknown
+  static uint8_t getPacketClass(const PacketPtr &packet);
+
   static void forEachNack(RtcpHeader *chead, std::function<void(uint16_t, uint16_t, RtcpHeader*)> f);
 
   static PacketPtr createPLI(uint32_t source_ssrc, uint32_t sink_ssrc);
@@ -35,6 +38,13 @@ class RtpUtils {
   static int getPaddingLength(PacketPtr packet);
 
   static PacketPtr makePaddingPacket(PacketPtr packet, uint8_t padding_size);
+
+  // A copy of the packet to retransmit it on an RTX stream (RFC 4588), nullptr if it would not fit once protected
+  static PacketPtr makeRtxPacket(const PacketPtr &packet, uint32_t rtx_ssrc, uint8_t rtx_payload_type,
+                                 uint16_t rtx_seq_num);
+
+  // Turns an RTX packet back into the one it retransmits, false if it carries none (padding only)
+  static bool unwrapRtxPacket(const PacketPtr &packet, uint32_t ssrc, uint8_t payload_type);
 };
 
 }  // namespace erizo
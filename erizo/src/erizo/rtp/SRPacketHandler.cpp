@@ -25,6 +25,10 @@ void SRPacketHandler::handleRtpPacket(PacketPtr packet) {
   auto sr_selected_info_iter = sr_info_map_.find(ssrc);
   std::shared_ptr<SRInfo> selected_info;
   if (sr_selected_info_iter == sr_info_map_.end()) {
+    // Retransmissions are not counted in the sender reports of the media they repeat, nor in their own
+    if (stream_->isRtxSSRC(ssrc)) {
+      return;
+    }
     ELOG_DEBUG("message: Inserting new SSRC in sr_info_map, ssrc: %u", ssrc);
     sr_info_map_[ssrc] = std::make_shared<SRInfo>();
   }
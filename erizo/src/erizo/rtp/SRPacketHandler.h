@@ -18,6 +18,8 @@ class SRPacketHandler: public Handler {
 
 
  public:
+  static const uint8_t notified_updates = kSdpUpdate;
+
   SRPacketHandler();
 
   void enable() override;
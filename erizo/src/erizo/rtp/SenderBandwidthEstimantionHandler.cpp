@@ -45,6 +45,7 @@ void SenderBandwidthEstimationHandler::notifyUpdate() {
   if (pipeline && !stream_) {
     stream_ = pipeline->getService<MediaStream>().get();
     processor_ = pipeline->getService<RtcpProcessor>();
+    packet_buffer_ = pipeline->getService<PacketBufferService>();
   }
   if (!stream_) {
     return;
@@ -76,10 +77,10 @@ void SenderBandwidthEstimationHandler::read(Context *ctx, PacketPtr packet) {
       switch (chead->packettype) {
         case RTCP_Receiver_PT:
           {
-            if (chead->getSourceSSRC() != stream_->getVideoSinkSSRC()) {
+            if (chead->getSourceSSRC() != getReportedSsrc()) {
               continue;
             }
-            ELOG_DEBUG("%s, Analyzing Video RR: PacketLost %u, Ratio %u, current_block %d, blocks %d"
+            ELOG_DEBUG("%s, Analyzing RR: PacketLost %u, Ratio %u, current_block %d, blocks %d"
                 ", sourceSSRC %u, ssrc %u",
                 stream_->toLog(),
                 chead->getLostPackets(),
@@ -97,16 +98,21 @@ void SenderBandwidthEstimationHandler::read(Context *ctx, PacketPtr packet) {
                 [last_sr](const std::shared_ptr<SrDelayData> sr_info) {
                 return sr_info->sr_ntp == last_sr;
                 });
-            // TODO(pedro) Implement alternative when there are no REMBs
-            if (received_remb_ && value != sr_delay_data_.end()) {
-                uint32_t delay = now_ms - (*value)->sr_send_time - delay_since_last_ms;
-                ELOG_DEBUG("%s message: Updating Estimate with RR, fraction_lost: %u, "
-                    "delay: %u, period_packets_sent_: %u",
-                    stream_->toLog(), chead->getFractionLost(), delay, period_packets_sent_);
-                sender_bwe_->UpdateReceiverBlock(chead->getFractionLost(),
-                    delay, period_packets_sent_, now_ms);
-                period_packets_sent_ = 0;
-                updateEstimate();
+            if (value != sr_delay_data_.end()) {
+              uint32_t delay = now_ms - (*value)->sr_send_time - delay_since_last_ms;
+              if (packet_buffer_) {
+                packet_buffer_->setRoundTripTime(std::chrono::milliseconds(delay));
+              }
+              // TODO(pedro) Implement alternative when there are no REMBs
+              if (received_remb_) {
+                  ELOG_DEBUG("%s message: Updating Estimate with RR, fraction_lost: %u, "
+                      "delay: %u, period_packets_sent_: %u",
+                      stream_->toLog(), chead->getFractionLost(), delay, period_packets_sent_);
+                  sender_bwe_->UpdateReceiverBlock(chead->getFractionLost(),
+                      delay, period_packets_sent_, now_ms);
+                  period_packets_sent_ = 0;
+                  updateEstimate();
+              }
             }
           }
           break;
@@ -151,12 +157,17 @@ void SenderBandwidthEstimationHandler::write(Context *ctx, PacketPtr packet) {
       last_estimate_update_ = now;
     }
   } else if (chead->getPacketType() == RTCP_Sender_PT &&
-      chead->getSSRC() == stream_->getVideoSinkSSRC()) {
+      chead->getSSRC() == getReportedSsrc()) {
     analyzeSr(chead);
   }
   ctx->fireWrite(std::move(packet));
 }
 
+uint32_t SenderBandwidthEstimationHandler::getReportedSsrc() {
+  // Streams without video still measure the round trip time for their retransmission buffer
+  return stream_->isAudioOnly() ? stream_->getAudioSinkSSRC() : stream_->getVideoSinkSSRC();
+}
+
 void SenderBandwidthEstimationHandler::analyzeSr(RtcpHeader* chead) {
   uint64_t now = ClockUtils::timePointToMs(clock_->now());
   uint32_t ntp;
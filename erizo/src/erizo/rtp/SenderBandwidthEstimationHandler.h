@@ -4,6 +4,7 @@
 #include "./logger.h"
 #include "./MediaStream.h"
 #include "./rtp/RtcpProcessor.h"
+#include "rtp/PacketBufferService.h"
 #include "lib/Clock.h"
 
 #include "webrtc/modules/bitrate_controller/send_side_bandwidth_estimation.h"
@@ -27,6 +28,7 @@ class SenderBandwidthEstimationHandler : public Handler,
   static const uint16_t kMaxSrListSize = 20;
   static const uint32_t kStartSendBitrate = 300000;
   static constexpr duration kMinUpdateEstimateInterval = std::chrono::milliseconds(25);
+  static const uint8_t notified_updates = kSdpUpdate;
 
  public:
   explicit SenderBandwidthEstimationHandler(std::shared_ptr<Clock> the_clock = std::make_shared<SteadyClock>());
@@ -53,6 +55,8 @@ class SenderBandwidthEstimationHandler : public Handler,
  private:
   MediaStream* stream_;
   std::shared_ptr<RtcpProcessor> processor_;
+  // Its retransmission buffer follows the round trip time measured here
+  std::shared_ptr<PacketBufferService> packet_buffer_;
   SenderBandwidthEstimationListener* bwe_listener_;
   std::shared_ptr<Clock> clock_;
   bool initialized_;
@@ -67,6 +71,8 @@ class SenderBandwidthEstimationHandler : public Handler,
   std::list<std::shared_ptr<SrDelayData>> sr_delay_data_;
   std::shared_ptr<Stats> stats_;
 
+  // SSRC whose sender and receiver reports give the round trip time
+  uint32_t getReportedSsrc();
   void updateEstimate();
 };
 }  // namespace erizo
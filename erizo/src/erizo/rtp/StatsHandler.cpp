@@ -33,15 +33,61 @@ void StatsCalculator::processPacket(PacketPtr packet) {
   }
 }
 
+void StatsCalculator::processPacketBatch(const PacketBatch &packets) {
+  bool in_run = false;
+  uint32_t run_ssrc = 0;
+  uint64_t run_bytes = 0;
+  for (const PacketPtr &packet : packets) {
+    RtcpHeader *chead = reinterpret_cast<RtcpHeader*> (packet->data);
+    if (chead->isRtcp()) {
+      processRtcpPacket(packet);
+      continue;
+    }
+    RtpHeader* head = reinterpret_cast<RtpHeader*>(packet->data);
+    uint32_t ssrc = head->getSSRC();
+    if (in_run && ssrc != run_ssrc) {
+      addRtpBytes(run_ssrc, run_bytes);
+      in_run = false;
+    }
+    if (!in_run) {
+      if (!isKnownRtpSSRC(ssrc, head->getPayloadType())) {
+        continue;
+      }
+      in_run = true;
+      run_ssrc = ssrc;
+      run_bytes = 0;
+    }
+    run_bytes += packet->length;
+    if (packet->type == VIDEO_PACKET && packet->is_keyframe) {
+      incrStat(ssrc, "keyFrames");
+    }
+  }
+  if (in_run) {
+    addRtpBytes(run_ssrc, run_bytes);
+  }
+}
+
 void StatsCalculator::processRtpPacket(PacketPtr packet) {
-  char* buf = packet->data;
-  int len = packet->length;
-  RtpHeader* head = reinterpret_cast<RtpHeader*>(buf);
+  RtpHeader* head = reinterpret_cast<RtpHeader*>(packet->data);
   uint32_t ssrc = head->getSSRC();
-  if (!stream_->isSinkSSRC(ssrc) && !stream_->isSourceSSRC(ssrc)) {
-    ELOG_DEBUG("message: Unknown SSRC in processRtpPacket, ssrc: %u, PT: %u", ssrc, head->getPayloadType());
+  if (!isKnownRtpSSRC(ssrc, head->getPayloadType())) {
     return;
   }
+  addRtpBytes(ssrc, packet->length);
+  if (packet->type == VIDEO_PACKET && packet->is_keyframe) {
+    incrStat(ssrc, "keyFrames");
+  }
+}
+
+bool StatsCalculator::isKnownRtpSSRC(uint32_t ssrc, uint8_t payload_type) {
+  // Retransmissions are not media bitrate, RtpRetransmissionHandler reports the ones sent in rtxBitrate
+  if (stream_->isRtxSSRC(ssrc)) {
+    return false;
+  }
+  if (!stream_->isSinkSSRC(ssrc) && !stream_->isSourceSSRC(ssrc)) {
+    ELOG_DEBUG("message: Unknown SSRC in processRtpPacket, ssrc: %u, PT: %u", ssrc, payload_type);
+    return false;
+  }
   if (!getStatsInfo()[ssrc].hasChild("bitrateCalculated")) {
     if (stream_->isVideoSourceSSRC(ssrc) || stream_->isVideoSinkSSRC(ssrc)) {
       getStatsInfo()[ssrc].insertStat("type", StringStat{"video"});
@@ -51,11 +97,12 @@ void StatsCalculator::processRtpPacket(PacketPtr packet) {
     getStatsInfo()[ssrc].insertStat("bitrateCalculated", MovingIntervalRateStat{kRateStatIntervalSize,
         kRateStatIntervals, 8.});
   }
-  getStatsInfo()[ssrc]["bitrateCalculated"] += len;
-  getStatsInfo()["total"]["bitrateCalculated"] += len;
-  if (packet->type == VIDEO_PACKET && packet->is_keyframe) {
-    incrStat(ssrc, "keyFrames");
-  }
+  return true;
+}
+
+void StatsCalculator::addRtpBytes(uint32_t ssrc, uint64_t bytes) {
+  getStatsInfo()[ssrc]["bitrateCalculated"] += bytes;
+  getStatsInfo()["total"]["bitrateCalculated"] += bytes;
 }
 
 void StatsCalculator::incrStat(uint32_t ssrc, std::string stat) {
@@ -191,6 +238,11 @@ void IncomingStatsHandler::read(Context *ctx, PacketPtr packet) {
   ctx->fireRead(std::move(packet));
 }
 
+void IncomingStatsHandler::readBatch(Context *ctx, PacketBatch packets) {
+  processPacketBatch(packets);
+  ctx->fireReadBatch(std::move(packets));
+}
+
 OutgoingStatsHandler::OutgoingStatsHandler() : stream_{nullptr} {}
 
 void OutgoingStatsHandler::enable() {}
@@ -211,4 +263,9 @@ void OutgoingStatsHandler::write(Context *ctx, PacketPtr packet) {
   ctx->fireWrite(std::move(packet));
 }
 
+void OutgoingStatsHandler::writeBatch(Context *ctx, PacketBatch packets) {
+  processPacketBatch(packets);
+  ctx->fireWriteBatch(std::move(packets));
+}
+
 }  // namespace erizo
@@ -23,6 +23,8 @@ class StatsCalculator {
 
   void update(MediaStream *connection, std::shared_ptr<Stats> stats);
   void processPacket(PacketPtr packet);
+  // Adds the bytes of each run of RTP packets of the same SSRC to its bitrate at once
+  void processPacketBatch(const PacketBatch &packets);
 
   StatNode& getStatsInfo() {
     return stats_->getNode();
@@ -34,6 +36,8 @@ class StatsCalculator {
 
  private:
   void processRtpPacket(PacketPtr packet);
+  bool isKnownRtpSSRC(uint32_t ssrc, uint8_t payload_type);
+  void addRtpBytes(uint32_t ssrc, uint64_t bytes);
   void processRtcpPacket(PacketPtr packet);
   void incrStat(uint32_t ssrc, std::string stat);
 
@@ -46,6 +50,8 @@ class IncomingStatsHandler: public InboundHandler, public StatsCalculator {
   DECLARE_LOGGER();
 
  public:
+  static const uint8_t notified_updates = kSdpUpdate;
+
   IncomingStatsHandler();
 
   void enable() override;
@@ -56,6 +62,7 @@ class IncomingStatsHandler: public InboundHandler, public StatsCalculator {
   }
 
   void read(Context *ctx, PacketPtr packet) override;
+  void readBatch(Context *ctx, PacketBatch packets) override;
   void notifyUpdate() override;
 
  private:
@@ -66,6 +73,8 @@ class OutgoingStatsHandler: public OutboundHandler, public StatsCalculator {
   DECLARE_LOGGER();
 
  public:
+  static const uint8_t notified_updates = kSdpUpdate;
+
   OutgoingStatsHandler();
 
   void enable() override;
@@ -76,6 +85,7 @@ class OutgoingStatsHandler: public OutboundHandler, public StatsCalculator {
   }
 
   void write(Context *ctx, PacketPtr packet) override;
+  void writeBatch(Context *ctx, PacketBatch packets) override;
   void notifyUpdate() override;
 
  private:
@@ -0,0 +1,200 @@
+#ifndef ERIZO_SRC_ERIZO_STATS_HANDLERSTATS_H_
+#define ERIZO_SRC_ERIZO_STATS_HANDLERSTATS_H_
+
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "./MediaDefinitions.h"
+#include "stats/StatNode.h"
+
+namespace erizo {
+
+// Power of two buckets of ns, the last one takes everything above 2^31 ns
+constexpr int kHandlerStatsBuckets = 32;
+
+/**
+ * How one handler deals with the packets of one direction: how many it got, how long it took with them, not
+ * counting the handlers it passed them on to, and how many it did not pass on.
+ * Calls with one packet and calls with a batch of them go to different histograms, since the time of a batch call
+ * says nothing about how long each of its packets took.
+ */
+struct HandlerDirectionStats {
+  uint64_t packets = 0;
+  uint64_t drops = 0;
+  uint64_t time_ns = 0;
+  uint64_t histogram[kHandlerStatsBuckets] = {};
+  uint64_t batches = 0;
+  uint64_t batch_histogram[kHandlerStatsBuckets] = {};
+
+  void record(uint64_t ns, bool dropped) {
+    packets++;
+    drops += dropped;
+    time_ns += ns;
+    addToHistogram(histogram, ns);
+  }
+
+  void recordBatch(uint64_t ns, uint64_t batch_packets, uint64_t batch_drops) {
+    if (batch_packets == 0) {
+      return;
+    }
+    packets += batch_packets;
+    drops += batch_drops;
+    time_ns += ns;
+    batches++;
+    addToHistogram(batch_histogram, ns);
+  }
+
+  // Upper bound of the bucket the percentile of the calls with one packet falls in
+  uint64_t percentileUpperBoundNs(double percentile) const {
+    return percentileUpperBound(histogram, percentile);
+  }
+
+  // Upper bound of the bucket the percentile of the calls with a batch falls in, for the whole call
+  uint64_t batchPercentileUpperBoundNs(double percentile) const {
+    return percentileUpperBound(batch_histogram, percentile);
+  }
+
+  void add(const HandlerDirectionStats &other) {
+    packets += other.packets;
+    drops += other.drops;
+    time_ns += other.time_ns;
+    batches += other.batches;
+    for (int bucket = 0; bucket < kHandlerStatsBuckets; bucket++) {
+      histogram[bucket] += other.histogram[bucket];
+      batch_histogram[bucket] += other.batch_histogram[bucket];
+    }
+  }
+
+  // Every field only grows, so this gives what happened since other was taken
+  void subtract(const HandlerDirectionStats &other) {
+    packets -= other.packets;
+    drops -= other.drops;
+    time_ns -= other.time_ns;
+    batches -= other.batches;
+    for (int bucket = 0; bucket < kHandlerStatsBuckets; bucket++) {
+      histogram[bucket] -= other.histogram[bucket];
+      batch_histogram[bucket] -= other.batch_histogram[bucket];
+    }
+  }
+
+  void fillNode(StatNode& node, const std::string &prefix) const {  // NOLINT
+    node.insertStat(prefix + "Packets", CumulativeStat{packets});
+    node.insertStat(prefix + "Drops", CumulativeStat{drops});
+    node.insertStat(prefix + "TimeNs", CumulativeStat{time_ns});
+    node.insertStat(prefix + "P99UpperBoundNs", CumulativeStat{percentileUpperBoundNs(0.99)});
+    node.insertStat(prefix + "Batches", CumulativeStat{batches});
+    node.insertStat(prefix + "BatchP99UpperBoundNs", CumulativeStat{batchPercentileUpperBoundNs(0.99)});
+  }
+
+ private:
+  static void addToHistogram(uint64_t (&buckets)[kHandlerStatsBuckets], uint64_t ns) {
+    int bucket = 63 - __builtin_clzll(ns | 1);
+    buckets[bucket < kHandlerStatsBuckets ? bucket : kHandlerStatsBuckets - 1]++;
+  }
+
+  static uint64_t percentileUpperBound(const uint64_t (&buckets)[kHandlerStatsBuckets], double percentile) {
+    uint64_t total = 0;
+    for (int bucket = 0; bucket < kHandlerStatsBuckets; bucket++) {
+      total += buckets[bucket];
+    }
+    uint64_t target = total * percentile;
+    uint64_t count = 0;
+    for (int bucket = 0; bucket < kHandlerStatsBuckets; bucket++) {
+      count += buckets[bucket];
+      if (count > target) {
+        return uint64_t{2} << bucket;
+      }
+    }
+    return 0;
+  }
+};
+
+struct HandlerStats {
+  HandlerDirectionStats read;
+  HandlerDirectionStats write;
+
+  void add(const HandlerStats &other) {
+    read.add(other.read);
+    write.add(other.write);
+  }
+
+  void subtract(const HandlerStats &other) {
+    read.subtract(other.read);
+    write.subtract(other.write);
+  }
+
+  void fillNode(StatNode& node) const {  // NOLINT
+    read.fillNode(node, "read");
+    write.fillNode(node, "write");
+  }
+};
+
+// Stats of every handler of a pipeline, or of all the pipelines of a Worker, by Handler::getName()
+typedef std::map<std::string, HandlerStats> HandlerStatsMap;
+
+inline void fillHandlerStatsNode(const HandlerStatsMap &stats, StatNode& node) {  // NOLINT
+  for (const auto &handler_stats : stats) {
+    handler_stats.second.fillNode(node[handler_stats.first]);
+  }
+}
+
+/**
+ * Measures one read or write of a handler, from the moment it gets the packet until it returns.
+ * The timers of the handlers it calls on the same thread nest inside it: what they take is not counted as its own
+ * time, and a handler with a next one that did not start any in its direction dropped the packet.
+ */
+class HandlerCallTimer {
+ public:
+  HandlerCallTimer(HandlerDirectionStats *stats, bool inbound, bool has_next)
+      : stats_{stats}, inbound_{inbound}, has_next_{has_next}, parent_{current()},
+        start_{std::chrono::steady_clock::now()} {
+    current() = this;
+  }
+
+  // For a batch of packets, those the handler passes on are collected in forwarded
+  HandlerCallTimer(HandlerDirectionStats *stats, bool inbound, bool has_next, uint64_t packets,
+                   const PacketBatch *forwarded)
+      : HandlerCallTimer(stats, inbound, has_next) {
+    packets_ = packets;
+    batch_forwarded_ = forwarded;
+  }
+
+  ~HandlerCallTimer() {
+    uint64_t elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start_).count();
+    current() = parent_;
+    uint64_t self_ns = elapsed_ns > downstream_ns_ ? elapsed_ns - downstream_ns_ : 0;
+    if (batch_forwarded_) {
+      uint64_t forwarded = batch_forwarded_->size();
+      stats_->recordBatch(self_ns, packets_, has_next_ && packets_ > forwarded ? packets_ - forwarded : 0);
+    } else {
+      stats_->record(self_ns, has_next_ && !forwarded_);
+    }
+    if (parent_) {
+      parent_->downstream_ns_ += elapsed_ns;
+      parent_->forwarded_ |= parent_->inbound_ == inbound_;
+    }
+  }
+
+ private:
+  static HandlerCallTimer*& current() {
+    static thread_local HandlerCallTimer *timer = nullptr;
+    return timer;
+  }
+
+  HandlerDirectionStats *stats_;
+  bool inbound_;
+  bool has_next_;
+  HandlerCallTimer *parent_;
+  uint64_t downstream_ns_ = 0;
+  bool forwarded_ = false;
+  uint64_t packets_ = 1;
+  const PacketBatch *batch_forwarded_ = nullptr;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_STATS_HANDLERSTATS_H_
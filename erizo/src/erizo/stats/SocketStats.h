@@ -0,0 +1,41 @@
+#ifndef ERIZO_SRC_ERIZO_STATS_SOCKETSTATS_H_
+#define ERIZO_SRC_ERIZO_STATS_SOCKETSTATS_H_
+
+#include <cstdint>
+
+#include "stats/StatNode.h"
+
+namespace erizo {
+
+/**
+ * Kernel-side view of a UDP socket, to tell drops at the socket apart from the network and the workers.
+ */
+struct SocketStats {
+  bool available = false;
+  // Datagrams the kernel dropped because the receive buffer was full (SO_RXQ_OVFL)
+  uint64_t receive_queue_drops = 0;
+  // Sends that failed with EAGAIN/EWOULDBLOCK, ENOBUFS or any other error
+  uint64_t send_would_block = 0;
+  uint64_t send_no_buffers = 0;
+  uint64_t send_errors = 0;
+  // Buffer sizes and the bytes queued in them, as reported by SO_MEMINFO
+  uint32_t receive_buffer_size = 0;
+  uint32_t send_buffer_size = 0;
+  uint32_t receive_queued_bytes = 0;
+  uint32_t send_queued_bytes = 0;
+
+  void fillNode(StatNode& node) const {  // NOLINT
+    node.insertStat("receiveQueueDrops", CumulativeStat{receive_queue_drops});
+    node.insertStat("sendWouldBlock", CumulativeStat{send_would_block});
+    node.insertStat("sendNoBuffers", CumulativeStat{send_no_buffers});
+    node.insertStat("sendErrors", CumulativeStat{send_errors});
+    node.insertStat("receiveBufferSize", CumulativeStat{receive_buffer_size});
+    node.insertStat("sendBufferSize", CumulativeStat{send_buffer_size});
+    node.insertStat("receiveQueuedBytes", CumulativeStat{receive_queued_bytes});
+    node.insertStat("sendQueuedBytes", CumulativeStat{send_queued_bytes});
+  }
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_STATS_SOCKETSTATS_H_
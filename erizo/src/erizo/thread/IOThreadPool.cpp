@@ -1,16 +1,67 @@
 #include "thread/IOThreadPool.h"
 
 #include <memory>
+#include <string>
 #include <future>  // NOLINT
 
+#include "./UdpMux.h"
+#include "stats/StatNode.h"
+#include "thread/IOUringWorker.h"
+
 using erizo::IOThreadPool;
 using erizo::IOWorker;
+using erizo::IOWorkerBackend;
+using erizo::IOUringWorker;
+using erizo::SocketStats;
+using erizo::StatNode;
+using erizo::UdpMux;
+using erizo::UdpMuxSteeringTable;
+
+DEFINE_LOGGER(IOThreadPool, "thread.IOThreadPool");
 
-IOThreadPool::IOThreadPool(unsigned int num_io_workers)
-    : io_workers_{} {
+IOThreadPool::IOThreadPool(unsigned int num_io_workers, uint16_t udp_mux_port, const std::string& network_interface,
+                           bool udp_mux_gro, IOWorkerBackend backend)
+    : io_workers_{}, udp_mux_port_{udp_mux_port}, backend_{backend} {
+  if (backend_ == IOWorkerBackend::IO_URING && !IOUringWorker::isSupported()) {
+    ELOG_WARN("message: io_uring is not supported by this kernel or build, falling back to nrappkit");
+    backend_ = IOWorkerBackend::NRAPPKIT;
+  }
+  // Only the mux sockets go through the ring, nICEr sockets would wait for the timer poll of the IOUringWorker
+  if (backend_ == IOWorkerBackend::IO_URING && udp_mux_port_ == 0) {
+    ELOG_WARN("message: io_uring is only used with udpMuxPort, falling back to nrappkit");
+    backend_ = IOWorkerBackend::NRAPPKIT;
+  }
+  // Every worker binds the same port with SO_REUSEPORT and hands misdelivered packets over to the owner
+  std::shared_ptr<UdpMuxSteeringTable> steering;
+  if (udp_mux_port_ != 0 && num_io_workers > 1) {
+    steering = std::make_shared<UdpMuxSteeringTable>();
+  }
   for (unsigned int index = 0; index < num_io_workers; index++) {
-    io_workers_.push_back(std::make_shared<IOWorker>());
+    std::shared_ptr<IOWorker> io_worker;
+    std::shared_ptr<IOUringWorker> io_uring_worker;
+    if (backend_ == IOWorkerBackend::IO_URING) {
+      io_uring_worker = std::make_shared<IOUringWorker>();
+      io_worker = io_uring_worker;
+    } else {
+      io_worker = std::make_shared<IOWorker>();
+    }
+    if (udp_mux_port_ != 0) {
+      auto mux = std::make_shared<UdpMux>(udp_mux_port_, network_interface, io_worker, steering);
+      mux->setGroEnabled(udp_mux_gro);
+      if (io_uring_worker) {
+        mux->setIoDriver(io_uring_worker.get());
+      }
+      io_worker->setUdpMux(mux);
+    }
+    io_workers_.push_back(io_worker);
+  }
+}
+
+IOWorkerBackend IOThreadPool::backendFromString(const std::string& backend) {
+  if (backend == "io_uring") {
+    return IOWorkerBackend::IO_URING;
   }
+  return IOWorkerBackend::NRAPPKIT;
 }
 
 IOThreadPool::~IOThreadPool() {
@@ -27,7 +78,7 @@ std::shared_ptr<IOWorker> IOThreadPool::getLessUsedIOWorker() {
   return chosen_io_worker;
 }
 
-void IOThreadPool::start() {
+bool IOThreadPool::start() {
   std::vector<std::shared_ptr<std::promise<void>>> promises(io_workers_.size());
   int index = 0;
   for (auto io_worker : io_workers_) {
@@ -37,9 +88,46 @@ void IOThreadPool::start() {
   for (auto promise : promises) {
     promise->get_future().wait();
   }
+  // Sockets are registered in the IO thread event loop so they have to be opened from it
+  std::vector<std::shared_ptr<std::promise<bool>>> mux_promises;
+  for (auto io_worker : io_workers_) {
+    std::shared_ptr<UdpMux> mux = io_worker->getUdpMux();
+    if (!mux) {
+      continue;
+    }
+    auto mux_promise = std::make_shared<std::promise<bool>>();
+    mux_promises.push_back(mux_promise);
+    io_worker->task([mux, mux_promise] {
+      mux_promise->set_value(mux->start());
+    });
+  }
+  bool started = true;
+  for (auto promise : mux_promises) {
+    started = promise->get_future().get() && started;
+  }
+  if (!started) {
+    ELOG_ERROR("message: Could not start UdpMux, port: %u", udp_mux_port_);
+  }
+  return started;
+}
+
+std::string IOThreadPool::getStats() {
+  StatNode root;
+  uint64_t index = 0;
+  for (auto io_worker : io_workers_) {
+    if (auto mux = io_worker->getUdpMux()) {
+      SocketStats stats = mux->getSocketStats();
+      if (stats.available) {
+        stats.fillNode(root[index]);
+      }
+    }
+    index++;
+  }
+  return root.toString();
 }
 
 void IOThreadPool::close() {
+  // Each worker closes its mux from its own thread before stopping
   for (auto io_worker : io_workers_) {
     io_worker->close();
   }
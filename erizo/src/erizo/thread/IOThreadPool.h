@@ -2,24 +2,53 @@
 #define ERIZO_SRC_ERIZO_THREAD_IOTHREADPOOL_H_
 
 #include <memory>
+#include <string>
 #include <vector>
 
+#include "./logger.h"
 #include "thread/IOWorker.h"
 #include "thread/Scheduler.h"
 
 namespace erizo {
 
+enum class IOWorkerBackend {
+  NRAPPKIT,
+  IO_URING
+};
+
 class IOThreadPool {
+  DECLARE_LOGGER();
+
  public:
-  explicit IOThreadPool(unsigned int num_workers);
+  /**
+   * @param udp_mux_port when not 0 every IOWorker gets a UdpMux listening on udp_mux_port (SO_REUSEPORT)
+   * @param udp_mux_gro enables UDP_GRO on the mux sockets when the kernel supports it
+   * @param backend IO_URING falls back to NRAPPKIT when the kernel does not support it or there is no UdpMux
+   */
+  explicit IOThreadPool(unsigned int num_workers, uint16_t udp_mux_port = 0,
+                        const std::string& network_interface = "", bool udp_mux_gro = false,
+                        IOWorkerBackend backend = IOWorkerBackend::NRAPPKIT);
   ~IOThreadPool();
 
   std::shared_ptr<IOWorker> getLessUsedIOWorker();
-  void start();
+  /**
+   * @return false when some UdpMux could not open its socket, the pool is useless for ICE in that case
+   */
+  bool start();
   void close();
+  bool hasUdpMux() { return udp_mux_port_ != 0; }
+  IOWorkerBackend getBackend() { return backend_; }
+  /**
+   * Socket stats of the UdpMux of every IOWorker, as a JSON object keyed by worker index
+   */
+  std::string getStats();
+
+  static IOWorkerBackend backendFromString(const std::string& backend);
 
  private:
   std::vector<std::shared_ptr<IOWorker>> io_workers_;
+  uint16_t udp_mux_port_;
+  IOWorkerBackend backend_;
 };
 }  // namespace erizo
 
@@ -0,0 +1,610 @@
+#include "thread/IOUringWorker.h"
+
+extern "C" {
+#include <r_errors.h>
+#include <async_wait.h>
+#include <async_timer.h>
+}
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+#endif
+
+// Multishot recvmsg and provided buffer rings need linux >= 6.0 headers
+#if defined(IORING_RECV_MULTISHOT)
+#define ERIZO_HAS_IO_URING 1
+#endif
+
+#include <errno.h>
+#include <netinet/udp.h>
+#include <signal.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace erizo {
+
+DEFINE_LOGGER(IOUringWorker, "thread.IOUringWorker");
+
+#ifdef ERIZO_HAS_IO_URING
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+
+static constexpr unsigned int kRingEntries = 1024;
+static constexpr int kWaitTimeoutMs = 10;
+static constexpr uint16_t kBufferGroup = 0;
+static constexpr unsigned int kBufferCount = 1024;
+static constexpr unsigned int kBufferSize = 2048;
+static constexpr unsigned int kGroBufferCount = 64;
+static constexpr unsigned int kGroBufferSize = 65536;
+static constexpr uint64_t kReceiveTag = 1;
+static constexpr uint64_t kWakeupTag = 2;
+static constexpr uint64_t kCancelTag = 3;
+static constexpr int kMaxDrainIterations = 10;
+
+static int io_uring_setup(unsigned entries, io_uring_params *params) {
+  return syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags, void *arg,
+                          size_t arg_size) {
+  return syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, arg, arg_size);
+}
+
+static int io_uring_register(int fd, unsigned opcode, void *arg, unsigned nr_args) {
+  return syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+static unsigned loadAcquire(unsigned *p) {
+  return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static void storeRelease(unsigned *p, unsigned value) {
+  __atomic_store_n(p, value, __ATOMIC_RELEASE);
+}
+
+IOUringWorker::IOUringWorker()
+    : ring_fd_{-1}, event_fd_{-1}, sq_entries_{0}, cq_entries_{0}, sq_ring_{nullptr}, cq_ring_{nullptr},
+      sq_ring_size_{0}, cq_ring_size_{0}, sqes_{nullptr}, cqes_{nullptr}, sq_head_{nullptr}, sq_tail_{nullptr},
+      sq_mask_{nullptr}, sq_array_{nullptr}, cq_head_{nullptr}, cq_tail_{nullptr}, cq_mask_{nullptr},
+      sq_local_tail_{0}, sq_submitted_tail_{0}, buffer_ring_{nullptr}, buffer_ring_size_{0}, buffers_{nullptr},
+      buffer_count_{0}, buffer_size_{0}, buffer_ring_tail_{0}, socket_{-1}, multishot_{true}, wakeup_value_{0},
+      wakeup_pending_{false}, sends_in_flight_{0}, submit_calls_{0}, submitted_sqes_{0} {
+  memset(&receive_msg_, 0, sizeof(receive_msg_));
+  memset(&receive_address_, 0, sizeof(receive_address_));
+}
+
+IOUringWorker::~IOUringWorker() {
+  close();
+}
+
+bool IOUringWorker::isSupported() {
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  int fd = io_uring_setup(4, &params);
+  if (fd < 0) {
+    return false;
+  }
+  bool supported = (params.features & IORING_FEAT_EXT_ARG) != 0;
+  if (supported) {
+    // Provided buffer rings are the newest feature we rely on
+    long page_size = sysconf(_SC_PAGESIZE);  // NOLINT
+    void *ring = mmap(nullptr, page_size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = reinterpret_cast<uint64_t>(ring);
+    reg.ring_entries = 1;
+    reg.bgid = kBufferGroup;
+    supported = ring != MAP_FAILED && io_uring_register(fd, IORING_REGISTER_PBUF_RING, &reg, 1) == 0;
+    if (ring != MAP_FAILED) {
+      munmap(ring, page_size);
+    }
+  }
+  ::close(fd);
+  return supported;
+}
+
+bool IOUringWorker::setupRing() {
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  params.flags = IORING_SETUP_CQSIZE;
+  params.cq_entries = kRingEntries * 4;
+  ring_fd_ = io_uring_setup(kRingEntries, &params);
+  if (ring_fd_ < 0) {
+    ELOG_ERROR("%s message: Could not create ring, errno: %d", toLog(), errno);
+    return false;
+  }
+  sq_entries_ = params.sq_entries;
+  cq_entries_ = params.cq_entries;
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+  if (single_mmap) {
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  }
+  sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                  IORING_OFF_SQ_RING);
+  if (sq_ring_ == MAP_FAILED) {
+    sq_ring_ = nullptr;
+    return false;
+  }
+  cq_ring_ = single_mmap ? sq_ring_ : mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+                                            MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+  if (cq_ring_ == MAP_FAILED) {
+    cq_ring_ = nullptr;
+    return false;
+  }
+  void *sqes = mmap(nullptr, params.sq_entries * sizeof(io_uring_sqe), PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    return false;
+  }
+  sqes_ = reinterpret_cast<io_uring_sqe*>(sqes);
+  char *sq = reinterpret_cast<char*>(sq_ring_);
+  char *cq = reinterpret_cast<char*>(cq_ring_);
+  sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  sq_mask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+  cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  cq_mask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+  sq_local_tail_ = sq_submitted_tail_ = *sq_tail_;
+
+  event_fd_ = eventfd(0, EFD_CLOEXEC);
+  return event_fd_ >= 0;
+}
+
+void IOUringWorker::teardownRing() {
+  teardownBuffers();
+  if (sqes_) {
+    munmap(sqes_, sq_entries_ * sizeof(io_uring_sqe));
+    sqes_ = nullptr;
+  }
+  if (cq_ring_ && cq_ring_ != sq_ring_) {
+    munmap(cq_ring_, cq_ring_size_);
+  }
+  if (sq_ring_) {
+    munmap(sq_ring_, sq_ring_size_);
+  }
+  sq_ring_ = cq_ring_ = nullptr;
+  if (ring_fd_ >= 0) {
+    ::close(ring_fd_);
+    ring_fd_ = -1;
+  }
+  if (event_fd_ >= 0) {
+    ::close(event_fd_);
+    event_fd_ = -1;
+  }
+}
+
+bool IOUringWorker::setupBuffers(unsigned int count, unsigned int size) {
+  long page_size = sysconf(_SC_PAGESIZE);  // NOLINT
+  buffer_ring_size_ = ((count * sizeof(io_uring_buf) + page_size - 1) / page_size) * page_size;
+  void *ring = mmap(nullptr, buffer_ring_size_, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+  if (ring == MAP_FAILED) {
+    return false;
+  }
+  buffer_ring_ = reinterpret_cast<io_uring_buf_ring*>(ring);
+  io_uring_buf_reg reg;
+  memset(&reg, 0, sizeof(reg));
+  reg.ring_addr = reinterpret_cast<uint64_t>(ring);
+  reg.ring_entries = count;
+  reg.bgid = kBufferGroup;
+  if (io_uring_register(ring_fd_, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+    ELOG_ERROR("%s message: Could not register buffer ring, errno: %d", toLog(), errno);
+    munmap(ring, buffer_ring_size_);
+    buffer_ring_ = nullptr;
+    return false;
+  }
+  buffer_count_ = count;
+  buffer_size_ = size;
+  buffers_ = new char[static_cast<size_t>(count) * size];
+  buffer_ring_tail_ = 0;
+  for (unsigned int index = 0; index < count; index++) {
+    recycleBuffer(index);
+  }
+  return true;
+}
+
+void IOUringWorker::teardownBuffers() {
+  if (!buffer_ring_) {
+    return;
+  }
+  io_uring_buf_reg reg;
+  memset(&reg, 0, sizeof(reg));
+  reg.bgid = kBufferGroup;
+  io_uring_register(ring_fd_, IORING_UNREGISTER_PBUF_RING, &reg, 1);
+  munmap(buffer_ring_, buffer_ring_size_);
+  buffer_ring_ = nullptr;
+  delete[] buffers_;
+  buffers_ = nullptr;
+}
+
+void IOUringWorker::recycleBuffer(uint16_t buffer_id) {
+  // io_uring_buf_ring::bufs is a flexible array that C++ compilers place after an empty struct, so the ring is
+  // addressed as a plain array, with the tail overlaid on the resv field of the first entry
+  io_uring_buf *bufs = reinterpret_cast<io_uring_buf*>(buffer_ring_);
+  io_uring_buf *buf = &bufs[buffer_ring_tail_ & (buffer_count_ - 1)];
+  buf->addr = reinterpret_cast<uint64_t>(buffers_ + static_cast<size_t>(buffer_id) * buffer_size_);
+  buf->len = buffer_size_;
+  buf->bid = buffer_id;
+  buffer_ring_tail_++;
+  __atomic_store_n(&bufs[0].resv, buffer_ring_tail_, __ATOMIC_RELEASE);
+}
+
+io_uring_sqe* IOUringWorker::getSqe() {
+  if (sq_local_tail_ - loadAcquire(sq_head_) >= sq_entries_) {
+    submitAndWait(0, 0);
+    if (sq_local_tail_ - loadAcquire(sq_head_) >= sq_entries_) {
+      return nullptr;
+    }
+  }
+  unsigned index = sq_local_tail_ & *sq_mask_;
+  io_uring_sqe *sqe = &sqes_[index];
+  memset(sqe, 0, sizeof(*sqe));
+  sq_array_[index] = index;
+  sq_local_tail_++;
+  return sqe;
+}
+
+int IOUringWorker::submitAndWait(unsigned int min_complete, int timeout_ms) {
+  unsigned to_submit = sq_local_tail_ - sq_submitted_tail_;
+  storeRelease(sq_tail_, sq_local_tail_);
+  unsigned flags = 0;
+  __kernel_timespec timeout;
+  io_uring_getevents_arg arg;
+  memset(&arg, 0, sizeof(arg));
+  if (min_complete > 0) {
+    flags |= IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_nsec = (timeout_ms % 1000) * 1000000LL;
+    arg.sigmask_sz = _NSIG / 8;
+    arg.ts = reinterpret_cast<uint64_t>(&timeout);
+  } else if (to_submit == 0) {
+    return 0;
+  }
+  int r = io_uring_enter(ring_fd_, to_submit, min_complete, flags, min_complete > 0 ? &arg : nullptr,
+                         min_complete > 0 ? sizeof(arg) : 0);
+  if (r >= 0) {
+    sq_submitted_tail_ += r;
+    submit_calls_++;
+    submitted_sqes_ += r;
+  } else if (errno != ETIME && errno != EINTR && errno != EBUSY) {
+    ELOG_WARN("%s message: io_uring_enter failed, errno: %d", toLog(), errno);
+  }
+  return r;
+}
+
+void IOUringWorker::processCompletions() {
+  unsigned head = *cq_head_;
+  unsigned tail = loadAcquire(cq_tail_);
+  while (head != tail) {
+    io_uring_cqe *cqe = &cqes_[head & *cq_mask_];
+    uint64_t user_data = cqe->user_data;
+    int result = cqe->res;
+    uint32_t flags = cqe->flags;
+    head++;
+    storeRelease(cq_head_, head);
+    onCompletion(user_data, result, flags);
+    tail = loadAcquire(cq_tail_);
+  }
+}
+
+void IOUringWorker::onCompletion(uint64_t user_data, int result, uint32_t flags) {
+  switch (user_data) {
+    case kReceiveTag:
+      onReceive(result, flags);
+      break;
+    case kWakeupTag:
+      wakeup_pending_ = false;
+      if (!closed_) {
+        armWakeup();
+      }
+      break;
+    case kCancelTag:
+      break;
+    default:
+      onSendCompleted(reinterpret_cast<Send*>(user_data), result);
+      break;
+  }
+}
+
+void IOUringWorker::armWakeup() {
+  io_uring_sqe *sqe = getSqe();
+  if (!sqe) {
+    return;
+  }
+  sqe->opcode = IORING_OP_READ;
+  sqe->fd = event_fd_;
+  sqe->addr = reinterpret_cast<uint64_t>(&wakeup_value_);
+  sqe->len = sizeof(wakeup_value_);
+  sqe->user_data = kWakeupTag;
+}
+
+void IOUringWorker::armReceive() {
+  if (socket_ < 0) {
+    return;
+  }
+  io_uring_sqe *sqe = getSqe();
+  if (!sqe) {
+    return;
+  }
+  sqe->opcode = IORING_OP_RECVMSG;
+  sqe->fd = 0;  // index in the registered files
+  sqe->flags = IOSQE_FIXED_FILE | IOSQE_BUFFER_SELECT;
+  sqe->addr = reinterpret_cast<uint64_t>(&receive_msg_);
+  sqe->len = 1;
+  sqe->ioprio = multishot_ ? IORING_RECV_MULTISHOT : 0;
+  sqe->buf_group = kBufferGroup;
+  sqe->user_data = kReceiveTag;
+}
+
+void IOUringWorker::onReceive(int result, uint32_t flags) {
+  bool rearm = !(flags & IORING_CQE_F_MORE);
+  if (result < 0) {
+    if (result == -EINVAL && multishot_) {
+      ELOG_WARN("%s message: Multishot recvmsg is not supported, falling back to single shot", toLog());
+      multishot_ = false;
+    } else if (result != -ENOBUFS && result != -ECANCELED) {
+      ELOG_DEBUG("%s message: recvmsg failed, error: %d", toLog(), result);
+    }
+  } else if (flags & IORING_CQE_F_BUFFER) {
+    uint16_t buffer_id = flags >> IORING_CQE_BUFFER_SHIFT;
+    char *buffer = buffers_ + static_cast<size_t>(buffer_id) * buffer_size_;
+    UdpMuxAddress remote;
+    char *payload = buffer;
+    int length = result;
+    msghdr control_msg;
+    memset(&control_msg, 0, sizeof(control_msg));
+    if (multishot_) {
+      // Multishot buffers are laid out as io_uring_recvmsg_out, name, control and payload
+      io_uring_recvmsg_out *out = reinterpret_cast<io_uring_recvmsg_out*>(buffer);
+      char *name = buffer + sizeof(io_uring_recvmsg_out);
+      control_msg.msg_control = name + receive_msg_.msg_namelen;
+      control_msg.msg_controllen = out->controllen;
+      payload = reinterpret_cast<char*>(control_msg.msg_control) + receive_msg_.msg_controllen;
+      length = out->flags & MSG_TRUNC ? -1 : static_cast<int>(out->payloadlen);
+      memcpy(&remote.addr, name, std::min<size_t>(sizeof(remote.addr), out->namelen));
+    } else {
+      control_msg.msg_control = receive_msg_.msg_control;
+      control_msg.msg_controllen = receive_msg_.msg_controllen;
+      memcpy(&remote.addr, &receive_address_, sizeof(remote.addr));
+    }
+    int segment_size = 0;
+    uint64_t received_time_us = 0;
+    if (length > 0 && udp_mux_) {
+      udp_mux_->parseControlMessages(&control_msg, &segment_size, &received_time_us);
+      udp_mux_->onReceived(remote, payload, length, segment_size, received_time_us);
+    }
+    recycleBuffer(buffer_id);
+  }
+  if (rearm) {
+    armReceive();
+  }
+}
+
+void IOUringWorker::watch(int socket) {
+  if (ring_fd_ < 0 || socket_ >= 0) {
+    return;
+  }
+  bool gro = udp_mux_ && udp_mux_->isGroEnabled();
+  bool control = gro || (udp_mux_ && udp_mux_->areTimestampsEnabled());
+  if (!setupBuffers(gro ? kGroBufferCount : kBufferCount, gro ? kGroBufferSize : kBufferSize)) {
+    return;
+  }
+  if (io_uring_register(ring_fd_, IORING_REGISTER_FILES, &socket, 1) < 0) {
+    ELOG_ERROR("%s message: Could not register socket, errno: %d", toLog(), errno);
+    teardownBuffers();
+    return;
+  }
+  socket_ = socket;
+  memset(&receive_msg_, 0, sizeof(receive_msg_));
+  receive_msg_.msg_name = &receive_address_;
+  receive_msg_.msg_namelen = sizeof(receive_address_);
+  if (control) {
+    receive_msg_.msg_control = receive_control_;
+    receive_msg_.msg_controllen = sizeof(receive_control_);
+  }
+  armReceive();
+  ELOG_INFO("%s message: watching socket, buffers: %u, buffer_size: %u", toLog(), buffer_count_, buffer_size_);
+}
+
+void IOUringWorker::unwatch(int socket) {
+  if (ring_fd_ < 0 || socket_ != socket) {
+    return;
+  }
+  io_uring_sqe *sqe = getSqe();
+  if (sqe) {
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->addr = kReceiveTag;
+    sqe->user_data = kCancelTag;
+  }
+  socket_ = -1;
+  drainSends();
+  io_uring_register(ring_fd_, IORING_UNREGISTER_FILES, nullptr, 0);
+  teardownBuffers();
+}
+
+void IOUringWorker::send(const UdpMuxAddress& remote, std::vector<PacketPtr> packets, uint16_t segment_size) {
+  if (socket_ < 0 || packets.empty()) {
+    return;
+  }
+  Send *send = new Send();
+  send->address = remote.addr;
+  send->packets = std::move(packets);
+  send->segment_size = segment_size;
+  submitSend(send);
+}
+
+void IOUringWorker::submitSend(Send *send) {
+  io_uring_sqe *sqe = getSqe();
+  if (!sqe) {
+    ELOG_DEBUG("%s message: Submission queue full, dropping packets: %lu", toLog(), send->packets.size());
+    delete send;
+    return;
+  }
+  send->iovs.resize(send->packets.size());
+  for (size_t index = 0; index < send->packets.size(); index++) {
+    send->iovs[index].iov_base = send->packets[index]->data;
+    send->iovs[index].iov_len = send->packets[index]->length;
+  }
+  memset(&send->msg, 0, sizeof(send->msg));
+  send->msg.msg_name = &send->address;
+  send->msg.msg_namelen = sizeof(send->address);
+  send->msg.msg_iov = send->iovs.data();
+  send->msg.msg_iovlen = send->iovs.size();
+  if (send->segment_size > 0) {
+    memset(send->control, 0, sizeof(send->control));
+    send->msg.msg_control = send->control;
+    send->msg.msg_controllen = sizeof(send->control);
+    cmsghdr *cmsg = CMSG_FIRSTHDR(&send->msg);
+    cmsg->cmsg_level = SOL_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+    memcpy(CMSG_DATA(cmsg), &send->segment_size, sizeof(send->segment_size));
+  }
+  sqe->opcode = IORING_OP_SENDMSG;
+  sqe->fd = 0;
+  sqe->flags = IOSQE_FIXED_FILE;
+  sqe->addr = reinterpret_cast<uint64_t>(&send->msg);
+  sqe->len = 1;
+  sqe->user_data = reinterpret_cast<uint64_t>(send);
+  sends_in_flight_++;
+}
+
+void IOUringWorker::onSendCompleted(Send *send, int result) {
+  sends_in_flight_--;
+  if (result < 0 && send->segment_size > 0 && socket_ >= 0 &&
+      (result == -EIO || result == -EINVAL || result == -EOPNOTSUPP)) {
+    ELOG_WARN("%s message: Disabling GSO, error: %d", toLog(), result);
+    if (udp_mux_) {
+      udp_mux_->disableGso();
+    }
+    for (PacketPtr &packet : send->packets) {
+      Send *single = new Send();
+      single->address = send->address;
+      single->packets.push_back(packet);
+      single->segment_size = 0;
+      submitSend(single);
+    }
+  } else if (result < 0) {
+    ELOG_DEBUG("%s message: sendmsg failed, error: %d", toLog(), result);
+    if (udp_mux_) {
+      udp_mux_->onSendError(UdpMuxAddress(send->address), -result);
+    }
+  }
+  // Packets go back to whoever owns them only now that the kernel is done with them
+  delete send;
+}
+
+void IOUringWorker::drainSends() {
+  for (int i = 0; i < kMaxDrainIterations && (sends_in_flight_ > 0 || sq_local_tail_ != sq_submitted_tail_); i++) {
+    submitAndWait(1, kWaitTimeoutMs);
+    processCompletions();
+  }
+}
+
+void IOUringWorker::task(Task f) {
+  IOWorker::task(f);
+  if (event_fd_ >= 0 && !wakeup_pending_.exchange(true)) {
+    eventfd_write(event_fd_, 1);
+  }
+}
+
+void IOUringWorker::start(std::shared_ptr<std::promise<void>> start_promise) {
+  if (started_.exchange(true)) {
+    return;
+  }
+  if (!setupRing()) {
+    teardownRing();
+    ELOG_ERROR("%s message: Could not start io_uring, falling back to nrappkit", toLog());
+    started_ = false;
+    if (udp_mux_) {
+      udp_mux_->setIoDriver(nullptr);
+    }
+    IOWorker::start(start_promise);
+    return;
+  }
+  armWakeup();
+  thread_ = std::unique_ptr<std::thread>(new std::thread([this, start_promise] {
+    start_promise->set_value();
+    while (!closed_) {
+      runTasks();
+      // nICEr/libnice sockets and nrappkit timers still need servicing, but never block on them
+      int events;
+      struct timeval no_wait = {0, 0};
+      struct timeval now;
+      NR_async_event_wait2(&events, &no_wait);
+      gettimeofday(&now, 0);
+      NR_async_timer_update_time(&now);
+      submitAndWait(1, kWaitTimeoutMs);
+      processCompletions();
+    }
+    closeUdpMux();
+  }));
+}
+
+void IOUringWorker::close() {
+  if (closed_.exchange(true)) {
+    return;
+  }
+  if (event_fd_ >= 0) {
+    eventfd_write(event_fd_, 1);
+  }
+  if (thread_ != nullptr) {
+    thread_->join();
+  }
+  drainSends();
+  teardownRing();
+  tasks_.clear();
+}
+
+#else
+
+IOUringWorker::IOUringWorker() {
+}
+
+IOUringWorker::~IOUringWorker() {
+}
+
+bool IOUringWorker::isSupported() {
+  return false;
+}
+
+void IOUringWorker::start(std::shared_ptr<std::promise<void>> start_promise) {
+  IOWorker::start(start_promise);
+}
+
+void IOUringWorker::close() {
+  IOWorker::close();
+}
+
+void IOUringWorker::task(Task f) {
+  IOWorker::task(f);
+}
+
+void IOUringWorker::watch(int socket) {
+}
+
+void IOUringWorker::unwatch(int socket) {
+}
+
+void IOUringWorker::send(const UdpMuxAddress& remote, std::vector<PacketPtr> packets, uint16_t segment_size) {
+}
+
+#endif
+
+}  // namespace erizo
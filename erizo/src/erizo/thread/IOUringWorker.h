@@ -0,0 +1,128 @@
+#ifndef ERIZO_SRC_ERIZO_THREAD_IOURINGWORKER_H_
+#define ERIZO_SRC_ERIZO_THREAD_IOURINGWORKER_H_
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#include <atomic>
+#include <memory>
+#include <future>  // NOLINT
+#include <vector>
+
+#include "./logger.h"
+#include "./UdpMux.h"
+#include "thread/IOWorker.h"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+struct io_uring_buf_ring;
+
+namespace erizo {
+
+/**
+ * An IOWorker whose loop is built on io_uring instead of nrappkit's select loop.
+ * It drives the UdpMux socket of the worker with a multishot recvmsg over a ring of provided buffers,
+ * batches queued sends into SENDMSG submissions that are issued with a single io_uring_enter per loop,
+ * and uses a registered fd for the socket. Tasks wake the loop through an eventfd.
+ * nrappkit sockets and timers (nICEr) are still polled every iteration without blocking.
+ * Received datagrams are copied from the ring buffers into new DataPackets instead of receiving into DataPackets:
+ * multishot buffers start with the recvmsg header, address and control data, GRO buffers hold many datagrams, and
+ * packets live on in the retransmission buffers for seconds, which would drain the ring if they owned its memory.
+ */
+class IOUringWorker : public IOWorker, public UdpMuxIoDriver {
+  DECLARE_LOGGER();
+
+ public:
+  IOUringWorker();
+  virtual ~IOUringWorker();
+
+  using IOWorker::start;
+  void start(std::shared_ptr<std::promise<void>> start_promise) override;
+  void close() override;
+  void task(Task f) override;
+
+  void watch(int socket) override;
+  void unwatch(int socket) override;
+  void send(const UdpMuxAddress& remote, std::vector<PacketPtr> packets, uint16_t segment_size) override;
+
+  uint64_t getSubmitCalls() const { return submit_calls_; }
+  uint64_t getSubmittedSqes() const { return submitted_sqes_; }
+
+  /**
+   * Whether this binary and the running kernel support everything the backend needs
+   */
+  static bool isSupported();
+
+  inline std::string toLog() const {
+    return "io_uring worker";
+  }
+
+ private:
+  struct Send {
+    msghdr msg;
+    sockaddr_in address;
+    std::vector<iovec> iovs;
+    char control[CMSG_SPACE(sizeof(uint16_t))];
+    std::vector<PacketPtr> packets;
+    uint16_t segment_size;
+  };
+
+  bool setupRing();
+  void teardownRing();
+  bool setupBuffers(unsigned int count, unsigned int size);
+  void teardownBuffers();
+  void recycleBuffer(uint16_t buffer_id);
+  io_uring_sqe* getSqe();
+  int submitAndWait(unsigned int min_complete, int timeout_ms);
+  void processCompletions();
+  void onCompletion(uint64_t user_data, int result, uint32_t flags);
+  void onReceive(int result, uint32_t flags);
+  void onSendCompleted(Send *send, int result);
+  void armReceive();
+  void armWakeup();
+  void submitSend(Send *send);
+  void drainSends();
+
+ private:
+  int ring_fd_;
+  int event_fd_;
+  unsigned int sq_entries_;
+  unsigned int cq_entries_;
+  void *sq_ring_;
+  void *cq_ring_;
+  size_t sq_ring_size_;
+  size_t cq_ring_size_;
+  io_uring_sqe *sqes_;
+  io_uring_cqe *cqes_;
+  unsigned *sq_head_;
+  unsigned *sq_tail_;
+  unsigned *sq_mask_;
+  unsigned *sq_array_;
+  unsigned *cq_head_;
+  unsigned *cq_tail_;
+  unsigned *cq_mask_;
+  unsigned sq_local_tail_;
+  unsigned sq_submitted_tail_;
+
+  io_uring_buf_ring *buffer_ring_;
+  size_t buffer_ring_size_;
+  char *buffers_;
+  unsigned int buffer_count_;
+  unsigned int buffer_size_;
+  uint16_t buffer_ring_tail_;
+
+  int socket_;
+  bool multishot_;
+  msghdr receive_msg_;
+  sockaddr_in receive_address_;
+  char receive_control_[UdpMux::kControlSize];
+  uint64_t wakeup_value_;
+  std::atomic<bool> wakeup_pending_;
+  size_t sends_in_flight_;
+  std::atomic<uint64_t> submit_calls_;
+  std::atomic<uint64_t> submitted_sqes_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_THREAD_IOURINGWORKER_H_
@@ -8,6 +8,8 @@ extern "C" {
 
 #include <chrono>  // NOLINT
 
+#include "./UdpMux.h"
+
 using erizo::IOWorker;
 
 IOWorker::IOWorker() : started_{false}, closed_{false} {
@@ -39,18 +41,32 @@ void IOWorker::start(std::shared_ptr<std::promise<void>> start_promise) {
       }
       gettimeofday(&tv, 0);
       NR_async_timer_update_time(&tv);
-      std::vector<Task> tasks;
-      {
-        std::unique_lock<std::mutex> lock(task_mutex_);
-        tasks.swap(tasks_);
-      }
-      for (Task &task : tasks) {
-        task();
-      }
+      runTasks();
     }
+    closeUdpMux();
   }));
 }
 
+void IOWorker::runTasks() {
+  std::vector<Task> tasks;
+  {
+    std::unique_lock<std::mutex> lock(task_mutex_);
+    tasks.swap(tasks_);
+  }
+  for (Task &task : tasks) {
+    task();
+  }
+  if (udp_mux_) {
+    udp_mux_->flush();
+  }
+}
+
+void IOWorker::closeUdpMux() {
+  if (udp_mux_) {
+    udp_mux_->close();
+  }
+}
+
 void IOWorker::task(Task f) {
   std::unique_lock<std::mutex> lock(task_mutex_);
   tasks_.push_back(f);
@@ -10,11 +10,13 @@
 
 namespace erizo {
 
+class UdpMux;
+
 class IOWorker : public std::enable_shared_from_this<IOWorker> {
  public:
   typedef std::function<void()> Task;
   IOWorker();
-  ~IOWorker();
+  virtual ~IOWorker();
 
   virtual void start();
   virtual void start(std::shared_ptr<std::promise<void>> start_promise);
@@ -22,12 +24,21 @@ class IOWorker : public std::enable_shared_from_this<IOWorker> {
 
   virtual void task(Task f);
 
- private:
+  void setUdpMux(std::shared_ptr<UdpMux> mux) { udp_mux_ = mux; }
+  std::shared_ptr<UdpMux> getUdpMux() { return udp_mux_; }
+
+ protected:
+  void runTasks();
+  // The mux can only be used from the worker thread, so the loop closes it right before exiting
+  void closeUdpMux();
+
+ protected:
   std::atomic<bool> started_;
   std::atomic<bool> closed_;
   std::unique_ptr<std::thread> thread_;
   std::vector<Task> tasks_;
   mutable std::mutex task_mutex_;
+  std::shared_ptr<UdpMux> udp_mux_;
 };
 }  // namespace erizo
 
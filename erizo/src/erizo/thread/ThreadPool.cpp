@@ -1,17 +1,25 @@
 #include "thread/ThreadPool.h"
 
 #include <memory>
+#include <string>
+
+#include "stats/StatNode.h"
 
 constexpr int kNumThreadsPerScheduler = 2;
+constexpr unsigned int kNumCryptoWorkers = 2;
 
+using erizo::StatNode;
 using erizo::ThreadPool;
 using erizo::Worker;
 
 ThreadPool::ThreadPool(unsigned int num_workers)
-    : workers_{}, scheduler_{std::make_shared<Scheduler>(kNumThreadsPerScheduler)} {
+    : workers_{}, crypto_workers_{}, scheduler_{std::make_shared<Scheduler>(kNumThreadsPerScheduler)} {
   for (unsigned int index = 0; index < num_workers; index++) {
     workers_.push_back(std::make_shared<Worker>(scheduler_));
   }
+  for (unsigned int index = 0; index < kNumCryptoWorkers; index++) {
+    crypto_workers_.push_back(std::make_shared<Worker>(scheduler_));
+  }
 }
 
 ThreadPool::~ThreadPool() {
@@ -19,8 +27,16 @@ ThreadPool::~ThreadPool() {
 }
 
 std::shared_ptr<Worker> ThreadPool::getLessUsedWorker() {
-  std::shared_ptr<Worker> chosen_worker = workers_.front();
-  for (auto worker : workers_) {
+  return getLessUsed(workers_);
+}
+
+std::shared_ptr<Worker> ThreadPool::getLessUsedCryptoWorker() {
+  return getLessUsed(crypto_workers_);
+}
+
+std::shared_ptr<Worker> ThreadPool::getLessUsed(const std::vector<std::shared_ptr<Worker>> &workers) {
+  std::shared_ptr<Worker> chosen_worker = workers.front();
+  for (auto worker : workers) {
     if (chosen_worker.use_count() > worker.use_count()) {
       chosen_worker = worker;
     }
@@ -29,12 +45,16 @@ std::shared_ptr<Worker> ThreadPool::getLessUsedWorker() {
 }
 
 void ThreadPool::start() {
-  std::vector<std::shared_ptr<std::promise<void>>> promises(workers_.size());
+  std::vector<std::shared_ptr<std::promise<void>>> promises(workers_.size() + crypto_workers_.size());
   int index = 0;
   for (auto worker : workers_) {
     promises[index] = std::make_shared<std::promise<void>>();
     worker->start(promises[index++]);
   }
+  for (auto worker : crypto_workers_) {
+    promises[index] = std::make_shared<std::promise<void>>();
+    worker->start(promises[index++]);
+  }
   for (auto promise : promises) {
     promise->get_future().wait();
   }
@@ -44,5 +64,24 @@ void ThreadPool::close() {
   for (auto worker : workers_) {
     worker->close();
   }
+  for (auto worker : crypto_workers_) {
+    worker->close();
+  }
   scheduler_->stop(true);
 }
+
+void ThreadPool::enableHandlerStats() {
+  for (auto worker : workers_) {
+    worker->enableHandlerStats();
+  }
+}
+
+std::string ThreadPool::getStats() {
+  StatNode root;
+  uint64_t index = 0;
+  for (auto worker : workers_) {
+    erizo::fillHandlerStatsNode(worker->getHandlerStats(), root[index]["handlers"]);
+    index++;
+  }
+  return root.toString();
+}
@@ -2,6 +2,7 @@
 #define ERIZO_SRC_ERIZO_THREAD_THREADPOOL_H_
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "thread/Worker.h"
@@ -15,11 +16,22 @@ class ThreadPool {
   ~ThreadPool();
 
   std::shared_ptr<Worker> getLessUsedWorker();
+  // Workers for the DTLS handshakes, kept apart so their asymmetric crypto never delays media
+  std::shared_ptr<Worker> getLessUsedCryptoWorker();
   void start();
   void close();
 
+  // Makes the MediaStreams of every worker measure their handlers from then on
+  void enableHandlerStats();
+  // The handler stats of every worker as a JSON string
+  std::string getStats();
+
+ private:
+  static std::shared_ptr<Worker> getLessUsed(const std::vector<std::shared_ptr<Worker>> &workers);
+
  private:
   std::vector<std::shared_ptr<Worker>> workers_;
+  std::vector<std::shared_ptr<Worker>> crypto_workers_;
   std::shared_ptr<Scheduler> scheduler_;
 };
 }  // namespace erizo
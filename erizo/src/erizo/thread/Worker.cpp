@@ -8,6 +8,7 @@
 
 #include "lib/ClockUtils.h"
 
+using erizo::HandlerStatsMap;
 using erizo::Worker;
 using erizo::SimulatedWorker;
 using erizo::ScheduledTaskReference;
@@ -27,7 +28,8 @@ Worker::Worker(std::weak_ptr<Scheduler> scheduler, std::shared_ptr<Clock> the_cl
       clock_{the_clock},
       service_{},
       service_worker_{new asio_worker::element_type(service_)},
-      closed_{false} {
+      closed_{false},
+      handler_stats_enabled_{false} {
 }
 
 Worker::~Worker() {
@@ -83,6 +85,26 @@ void Worker::scheduleEvery(ScheduledTask f, duration period) {
   scheduleEvery(f, period, period);
 }
 
+void Worker::enableHandlerStats() {
+  handler_stats_enabled_ = true;
+}
+
+bool Worker::isHandlerStatsEnabled() {
+  return handler_stats_enabled_;
+}
+
+void Worker::addHandlerStats(const HandlerStatsMap &stats) {
+  std::lock_guard<std::mutex> lock(handler_stats_mutex_);
+  for (const auto &handler_stats : stats) {
+    handler_stats_[handler_stats.first].add(handler_stats.second);
+  }
+}
+
+HandlerStatsMap Worker::getHandlerStats() {
+  std::lock_guard<std::mutex> lock(handler_stats_mutex_);
+  return handler_stats_;
+}
+
 void Worker::scheduleEvery(ScheduledTask f, duration period, duration next_delay) {
   time_point start = clock_->now();
   std::shared_ptr<Clock> clock = clock_;
@@ -9,9 +9,11 @@
 #include <map>
 #include <memory>
 #include <future>  // NOLINT
+#include <mutex>  // NOLINT
 #include <vector>
 
 #include "lib/Clock.h"
+#include "stats/HandlerStats.h"
 
 #include "thread/Scheduler.h"
 
@@ -47,6 +49,12 @@ class Worker : public std::enable_shared_from_this<Worker> {
 
   virtual void scheduleEvery(ScheduledTask f, duration period);
 
+  // Handler stats of every pipeline running in this worker, pipelines only measure their handlers when enabled
+  void enableHandlerStats();
+  bool isHandlerStatsEnabled();
+  void addHandlerStats(const HandlerStatsMap &stats);
+  HandlerStatsMap getHandlerStats();
+
  private:
   void scheduleEvery(ScheduledTask f, duration period, duration next_delay);
   std::function<void()> safeTask(std::function<void(std::shared_ptr<Worker>)> f);
@@ -61,6 +69,9 @@ class Worker : public std::enable_shared_from_this<Worker> {
   asio_worker service_worker_;
   boost::thread_group group_;
   std::atomic<bool> closed_;
+  std::atomic<bool> handler_stats_enabled_;
+  std::mutex handler_stats_mutex_;
+  HandlerStatsMap handler_stats_;
 };
 
 class SimulatedWorker : public Worker {
@@ -0,0 +1,245 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <DtlsTransport.h>
+#include <MediaDefinitions.h>
+#include <thread/ThreadPool.h>
+
+#include <chrono>  // NOLINT
+#include <future>  // NOLINT
+#include <memory>
+#include <mutex>  // NOLINT
+#include <set>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+using dtls::DtlsSocketContext;
+using erizo::CandidateInfo;
+using erizo::CandidatePair;
+using erizo::DataPacket;
+using erizo::DtlsTransport;
+using erizo::IceConfig;
+using erizo::IceConnection;
+using erizo::IOWorker;
+using erizo::PacketPtr;
+using erizo::ThreadPool;
+using erizo::Transport;
+using erizo::TransportListener;
+using erizo::Worker;
+
+constexpr std::chrono::seconds kHandshakeTimeout{10};
+
+class DtlsTransportUnprotectTest : public ::testing::Test {
+ protected:
+  PacketPtr createDecoratedPacket() {
+    const char payload[] = "srtp payload";
+    auto packet = std::make_shared<DataPacket>(1, payload, sizeof(payload), erizo::AUDIO_PACKET, 1234);
+    packet->setReceivedTime(1234567);
+    packet->compatible_spatial_layers = {0, 1};
+    packet->compatible_temporal_layers = {0, 1, 2};
+    packet->is_keyframe = true;
+    packet->ending_of_layer_frame = true;
+    packet->picture_id = 5;
+    packet->tl0_pic_idx = 6;
+    packet->codec = "VP8";
+    packet->clock_rate = 90000;
+    packet->source_packet = std::make_shared<DataPacket>(1, payload, sizeof(payload), erizo::VIDEO_PACKET, 1234);
+    return packet;
+  }
+
+  void expectCleanMetadata(const PacketPtr &packet) {
+    EXPECT_EQ(erizo::VIDEO_PACKET, packet->type);
+    EXPECT_TRUE(packet->compatible_spatial_layers.empty());
+    EXPECT_TRUE(packet->compatible_temporal_layers.empty());
+    EXPECT_FALSE(packet->is_keyframe);
+    EXPECT_FALSE(packet->ending_of_layer_frame);
+    EXPECT_EQ(-1, packet->picture_id);
+    EXPECT_EQ(-1, packet->tl0_pic_idx);
+    EXPECT_TRUE(packet->codec.empty());
+    EXPECT_EQ(0u, packet->clock_rate);
+    EXPECT_EQ(nullptr, packet->source_packet);
+  }
+
+  void expectSameData(const PacketPtr &expected, const PacketPtr &packet) {
+    EXPECT_EQ(expected->comp, packet->comp);
+    EXPECT_EQ(expected->length, packet->length);
+    EXPECT_EQ(0, memcmp(expected->data, packet->data, expected->length));
+    EXPECT_EQ(1234567u, packet->received_time_us);
+    EXPECT_EQ(1234u, packet->received_time_ms);
+  }
+};
+
+TEST_F(DtlsTransportUnprotectTest, shouldReuseThePacket_whenItIsNotShared) {
+  PacketPtr packet = createDecoratedPacket();
+  PacketPtr expected = std::make_shared<DataPacket>(*packet);
+  DataPacket *raw_packet = packet.get();
+
+  PacketPtr unprotect_packet = DtlsTransport::takePacketToUnprotect(std::move(packet));
+
+  EXPECT_EQ(raw_packet, unprotect_packet.get());
+  expectSameData(expected, unprotect_packet);
+  expectCleanMetadata(unprotect_packet);
+}
+
+TEST_F(DtlsTransportUnprotectTest, shouldCopyThePacket_whenItIsShared) {
+  PacketPtr packet = createDecoratedPacket();
+  PacketPtr other_owner = packet;
+
+  PacketPtr unprotect_packet = DtlsTransport::takePacketToUnprotect(packet);
+
+  EXPECT_NE(other_owner.get(), unprotect_packet.get());
+  expectSameData(other_owner, unprotect_packet);
+  expectCleanMetadata(unprotect_packet);
+  EXPECT_EQ(erizo::AUDIO_PACKET, other_owner->type);
+  EXPECT_EQ(5, other_owner->picture_id);
+  EXPECT_EQ("VP8", other_owner->codec);
+  EXPECT_NE(nullptr, other_owner->source_packet);
+}
+
+// Delivers what one transport sends to the other one, as if ICE had connected them
+class LoopbackIceConnection : public IceConnection {
+ public:
+  LoopbackIceConnection() : IceConnection(IceConfig()) {}
+
+  void start() override {}
+  bool setRemoteCandidates(const std::vector<CandidateInfo> &candidates, bool is_bundle) override { return true; }
+  void setRemoteCredentials(const std::string& username, const std::string& password) override {}
+  int sendData(unsigned int component_id, const void* buf, int len) override {
+    if (auto peer_connection = peer.lock()) {
+      if (auto listener = peer_connection->getIceListener().lock()) {
+        listener->onPacketReceived(std::make_shared<DataPacket>(component_id, reinterpret_cast<const char*>(buf),
+                                                                len, erizo::OTHER_PACKET, 0));
+      }
+    }
+    return len;
+  }
+  void onData(unsigned int component_id, char* buf, int len) override {}
+  CandidatePair getSelectedPair() override { return CandidatePair(); }
+  void setReceivedLastCandidate(bool hasReceived) override {}
+  void close() override {}
+
+  std::weak_ptr<LoopbackIceConnection> peer;
+};
+
+// Remembers the threads where its DTLS sockets call it back
+class ThreadRecordingDtlsTransport : public DtlsTransport {
+ public:
+  ThreadRecordingDtlsTransport(bool is_server, std::shared_ptr<IceConnection> ice,
+                               std::weak_ptr<TransportListener> listener, std::shared_ptr<Worker> worker,
+                               std::shared_ptr<IOWorker> io_worker, std::shared_ptr<Worker> crypto_worker)
+      : DtlsTransport(erizo::VIDEO_TYPE, "video", "test_connection", true, true, listener, IceConfig(), "", "",
+                      is_server, worker, io_worker, crypto_worker) {
+    ice_ = ice;
+  }
+
+  void onDtlsPacket(DtlsSocketContext *ctx, const unsigned char* data, unsigned int len) override {
+    recordThread();
+    DtlsTransport::onDtlsPacket(ctx, data, len);
+  }
+
+  void onHandshakeCompleted(DtlsSocketContext *ctx, std::string clientKey, std::string serverKey,
+                            std::string srtp_profile) override {
+    recordThread();
+    DtlsTransport::onHandshakeCompleted(ctx, clientKey, serverKey, srtp_profile);
+  }
+
+  std::set<std::thread::id> getThreads() {
+    std::lock_guard<std::mutex> lock(threads_mutex_);
+    return threads_;
+  }
+
+ private:
+  void recordThread() {
+    std::lock_guard<std::mutex> lock(threads_mutex_);
+    threads_.insert(std::this_thread::get_id());
+  }
+
+  std::mutex threads_mutex_;
+  std::set<std::thread::id> threads_;
+};
+
+class ReadyListener : public TransportListener {
+ public:
+  void onTransportData(PacketPtr packet, Transport *transport) override {}
+  void updateState(TransportState state, Transport *transport) override {
+    if (state == TRANSPORT_READY) {
+      std::call_once(ready_flag, [this] {
+        ready.set_value();
+      });
+    }
+  }
+  void onCandidate(const CandidateInfo& cand, Transport *transport) override {}
+
+  std::promise<void> ready;
+
+ private:
+  std::once_flag ready_flag;
+};
+
+class DtlsTransportHandshakeTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    thread_pool = std::make_shared<ThreadPool>(1);
+    thread_pool->start();
+    io_worker = std::make_shared<IOWorker>();
+    io_worker->start();
+    worker = thread_pool->getLessUsedWorker();
+    crypto_worker = thread_pool->getLessUsedCryptoWorker();
+
+    auto client_ice = std::make_shared<LoopbackIceConnection>();
+    auto server_ice = std::make_shared<LoopbackIceConnection>();
+    client_ice->peer = server_ice;
+    server_ice->peer = client_ice;
+    client_listener = std::make_shared<ReadyListener>();
+    server_listener = std::make_shared<ReadyListener>();
+    client = std::make_shared<ThreadRecordingDtlsTransport>(false, client_ice, client_listener, worker, io_worker,
+                                                            crypto_worker);
+    server = std::make_shared<ThreadRecordingDtlsTransport>(true, server_ice, server_listener, worker, io_worker,
+                                                            crypto_worker);
+    client->start();
+    server->start();
+  }
+
+  virtual void TearDown() {
+    std::promise<void> closed;
+    worker->task([this, &closed] {
+      client->close();
+      server->close();
+      closed.set_value();
+    });
+    closed.get_future().wait();
+    thread_pool->close();
+    io_worker->close();
+  }
+
+  std::thread::id getThreadId(std::shared_ptr<Worker> the_worker) {
+    std::promise<std::thread::id> thread_id;
+    the_worker->task([&thread_id] {
+      thread_id.set_value(std::this_thread::get_id());
+    });
+    return thread_id.get_future().get();
+  }
+
+  std::shared_ptr<ThreadPool> thread_pool;
+  std::shared_ptr<IOWorker> io_worker;
+  std::shared_ptr<Worker> worker;
+  std::shared_ptr<Worker> crypto_worker;
+  std::shared_ptr<ReadyListener> client_listener;
+  std::shared_ptr<ReadyListener> server_listener;
+  std::shared_ptr<ThreadRecordingDtlsTransport> client;
+  std::shared_ptr<ThreadRecordingDtlsTransport> server;
+};
+
+TEST_F(DtlsTransportHandshakeTest, shouldHandshakeInTheCryptoWorker_whenIceIsReady) {
+  client->updateIceState(erizo::IceState::READY, client->getIceConnection().get());
+
+  auto deadline = std::chrono::steady_clock::now() + kHandshakeTimeout;
+  ASSERT_EQ(std::future_status::ready, client_listener->ready.get_future().wait_until(deadline));
+  ASSERT_EQ(std::future_status::ready, server_listener->ready.get_future().wait_until(deadline));
+
+  std::set<std::thread::id> crypto_thread{getThreadId(crypto_worker)};
+  EXPECT_NE(getThreadId(worker), getThreadId(crypto_worker));
+  EXPECT_EQ(crypto_thread, client->getThreads());
+  EXPECT_EQ(crypto_thread, server->getThreads());
+}
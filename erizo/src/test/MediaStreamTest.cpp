@@ -0,0 +1,144 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <MediaDefinitions.h>
+#include <MediaStream.h>
+#include <SdpInfo.h>
+#include <WebRtcConnection.h>
+#include <rtp/FecReceiverHandler.h>
+#include <rtp/LayerBitrateCalculationHandler.h>
+#include <rtp/LayerDetectorHandler.h>
+#include <rtp/QualityFilterHandler.h>
+#include <rtp/RtpPaddingGeneratorHandler.h>
+#include <rtp/RtpRetransmissionHandler.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "utils/Mocks.h"
+
+using erizo::FecReceiverHandler;
+using erizo::IceConfig;
+using erizo::LayerBitrateCalculationHandler;
+using erizo::LayerDetectorHandler;
+using erizo::QualityFilterHandler;
+using erizo::RtpMap;
+using erizo::RtpPaddingGeneratorHandler;
+using erizo::RtpRetransmissionHandler;
+using erizo::SdpInfo;
+
+class MediaStreamTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    simulated_clock = std::make_shared<erizo::SimulatedClock>();
+    simulated_worker = std::make_shared<erizo::SimulatedWorker>(simulated_clock);
+    simulated_worker->start();
+    io_worker = std::make_shared<erizo::IOWorker>();
+    io_worker->start();
+    connection = std::make_shared<erizo::MockWebRtcConnection>(simulated_worker, io_worker, ice_config, rtp_maps);
+  }
+
+  virtual void TearDown() {
+    io_worker->close();
+  }
+
+  std::shared_ptr<erizo::MockMediaStream> createStream(bool is_publisher) {
+    return std::make_shared<erizo::MockMediaStream>(simulated_worker, connection, "stream", "label", rtp_maps,
+                                                    is_publisher);
+  }
+
+  std::shared_ptr<SdpInfo> createSdp(bool has_audio, bool has_video) {
+    auto sdp = std::make_shared<SdpInfo>(rtp_maps);
+    sdp->hasAudio = has_audio;
+    sdp->hasVideo = has_video;
+    return sdp;
+  }
+
+  IceConfig ice_config;
+  std::vector<RtpMap> rtp_maps;
+  std::shared_ptr<erizo::SimulatedClock> simulated_clock;
+  std::shared_ptr<erizo::SimulatedWorker> simulated_worker;
+  std::shared_ptr<erizo::IOWorker> io_worker;
+  std::shared_ptr<erizo::MockWebRtcConnection> connection;
+};
+
+TEST_F(MediaStreamTest, shouldLeaveSubscriberVideoHandlersOutOfPublishers) {
+  auto stream = createStream(true);
+
+  stream->setRemoteSdp(createSdp(true, true));
+
+  ASSERT_TRUE(stream->isPipelineInitialized());
+  EXPECT_NE(stream->getPipeline()->getHandler<LayerDetectorHandler>(), nullptr);
+  EXPECT_NE(stream->getPipeline()->getHandler<RtpRetransmissionHandler>(), nullptr);
+  EXPECT_EQ(stream->getPipeline()->getHandler<RtpPaddingGeneratorHandler>(), nullptr);
+  EXPECT_EQ(stream->getPipeline()->getHandler<LayerBitrateCalculationHandler>(), nullptr);
+  EXPECT_EQ(stream->getPipeline()->getHandler<FecReceiverHandler>(), nullptr);
+}
+
+TEST_F(MediaStreamTest, shouldLeavePublisherVideoHandlersOutOfSubscribers) {
+  auto stream = createStream(false);
+
+  stream->setRemoteSdp(createSdp(true, true));
+
+  ASSERT_TRUE(stream->isPipelineInitialized());
+  EXPECT_EQ(stream->getPipeline()->getHandler<LayerDetectorHandler>(), nullptr);
+  EXPECT_NE(stream->getPipeline()->getHandler<RtpRetransmissionHandler>(), nullptr);
+  EXPECT_NE(stream->getPipeline()->getHandler<RtpPaddingGeneratorHandler>(), nullptr);
+  EXPECT_NE(stream->getPipeline()->getHandler<LayerBitrateCalculationHandler>(), nullptr);
+  EXPECT_NE(stream->getPipeline()->getHandler<FecReceiverHandler>(), nullptr);
+}
+
+TEST_F(MediaStreamTest, shouldNotBuildThePipelineBeforeTheRemoteSdp) {
+  auto stream = createStream(false);
+
+  EXPECT_FALSE(stream->isPipelineInitialized());
+  EXPECT_EQ(stream->getPipeline(), nullptr);
+}
+
+TEST_F(MediaStreamTest, shouldUseTheAudioPipelineWhenTheRemoteSdpHasNoVideo) {
+  auto stream = createStream(true);
+
+  stream->setRemoteSdp(createSdp(true, false));
+
+  ASSERT_TRUE(stream->isPipelineInitialized());
+  EXPECT_TRUE(stream->isAudioOnly());
+  EXPECT_NE(stream->getPipeline()->getHandler<RtpRetransmissionHandler>(), nullptr);
+  EXPECT_EQ(stream->getPipeline()->getHandler<LayerDetectorHandler>(), nullptr);
+  EXPECT_EQ(stream->getPipeline()->getHandler<QualityFilterHandler>(), nullptr);
+}
+
+TEST_F(MediaStreamTest, shouldRebuildThePipelineWhenVideoIsAddedInARenegotiation) {
+  auto stream = createStream(false);
+  stream->setRemoteSdp(createSdp(true, false));
+  auto audio_pipeline = stream->getPipeline();
+
+  stream->setRemoteSdp(createSdp(true, true));
+
+  ASSERT_TRUE(stream->isPipelineInitialized());
+  EXPECT_FALSE(stream->isAudioOnly());
+  EXPECT_NE(stream->getPipeline(), audio_pipeline);
+  EXPECT_NE(stream->getPipeline()->getHandler<QualityFilterHandler>(), nullptr);
+  EXPECT_NE(stream->getPipeline()->getHandler<RtpPaddingGeneratorHandler>(), nullptr);
+}
+
+TEST_F(MediaStreamTest, shouldRebuildThePipelineWhenVideoIsRemovedInARenegotiation) {
+  auto stream = createStream(false);
+  stream->setRemoteSdp(createSdp(true, true));
+
+  stream->setRemoteSdp(createSdp(true, false));
+
+  ASSERT_TRUE(stream->isPipelineInitialized());
+  EXPECT_TRUE(stream->isAudioOnly());
+  EXPECT_EQ(stream->getPipeline()->getHandler<QualityFilterHandler>(), nullptr);
+}
+
+TEST_F(MediaStreamTest, shouldKeepThePipelineWhenTheMediaDoesNotChange) {
+  auto stream = createStream(true);
+  stream->setRemoteSdp(createSdp(true, true));
+  auto pipeline = stream->getPipeline();
+
+  stream->setRemoteSdp(createSdp(true, true));
+
+  EXPECT_EQ(stream->getPipeline(), pipeline);
+}
@@ -251,3 +251,33 @@ TEST_F(SdpInfoMediaTest, shouldOnlyMapRtxCorrespondingToSupportedCodecs) {
   }
   EXPECT_EQ(codec_hits_count, 1);
 }
+
+TEST_F(SdpInfoMediaTest, shouldMapRtxPayloadTypesToTheOnesTheyRetransmit) {
+  const unsigned int kVp8PtInFile = 100;
+  const unsigned int kRtxPtInFile = 96;
+
+  erizo::RtpMap vp8;
+  vp8.payload_type = 50;
+  vp8.encoding_name = "VP8";
+  vp8.clock_rate = 90000;
+  vp8.channels = 1;
+  vp8.media_type = erizo::VIDEO_TYPE;
+
+  erizo::RtpMap rtx;
+  rtx.payload_type = 105;
+  rtx.encoding_name = "rtx";
+  rtx.clock_rate = 90000;
+  rtx.channels = 1;
+  rtx.media_type = erizo::VIDEO_TYPE;
+  rtx.format_parameters["apt"] = "50";
+
+  rtp_mappings.push_back(vp8);
+  rtp_mappings.push_back(rtx);
+
+  erizo::SdpInfo sdp(rtp_mappings);
+  sdp.initWithSdp(chrome_sdp_string, "video");
+
+  EXPECT_EQ(sdp.getVideoRtxPT(kVp8PtInFile), kRtxPtInFile);
+  EXPECT_EQ(sdp.getVideoAssociatedPT(kRtxPtInFile), kVp8PtInFile);
+  EXPECT_EQ(sdp.getVideoAssociatedPT(kVp8PtInFile), 0u);
+}
@@ -0,0 +1,97 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <SrtpChannel.h>
+#include <MediaDefinitions.h>
+#include <rtp/RtpHeaders.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+using erizo::DataPacket;
+using erizo::RtcpHeader;
+using erizo::RtpHeader;
+using erizo::SrtpChannel;
+
+// Base64 of the bytes 0 to 29, and 0 to 27, master key and salt of the AES-CM and the AES-128-GCM profiles
+static const char kCmKey[] = "AAECAwQFBgcICQoLDA0ODxAREhMUFRYXGBkaGxwd";
+static const char kGcmKey[] = "AAECAwQFBgcICQoLDA0ODxAREhMUFRYXGBkaGw==";
+static constexpr int kFullSizePacketLength = 1400;
+
+class SrtpChannelTest : public ::testing::Test {
+ protected:
+  bool setProfile(const std::string &key, const std::string &profile) {
+    return sender.setRtpParams(key, key, profile) && receiver.setRtpParams(key, key, profile);
+  }
+
+  std::shared_ptr<DataPacket> rtpPacket(int length) {
+    auto packet = std::make_shared<DataPacket>();
+    memset(packet->data, 0, sizeof(packet->data));
+    RtpHeader *header = reinterpret_cast<RtpHeader*>(packet->data);
+    header->setVersion(2);
+    header->setPayloadType(96);
+    header->setSSRC(1);
+    packet->length = length;
+    return packet;
+  }
+
+  std::shared_ptr<DataPacket> rtcpPacket(int length) {
+    auto packet = std::make_shared<DataPacket>();
+    memset(packet->data, 0, sizeof(packet->data));
+    RtcpHeader *header = reinterpret_cast<RtcpHeader*>(packet->data);
+    header->setPacketType(RTCP_Receiver_PT);
+    header->setSSRC(1);
+    header->setLength(length / 4 - 1);
+    header->version = 2;
+    packet->length = length;
+    return packet;
+  }
+
+  SrtpChannel sender;
+  SrtpChannel receiver;
+};
+
+TEST_F(SrtpChannelTest, shouldProtectFullSizeRtpPackets) {
+  ASSERT_TRUE(setProfile(kCmKey, "SRTP_AES128_CM_SHA1_80"));
+  auto packet = rtpPacket(kFullSizePacketLength);
+
+  ASSERT_LE(packet->length, sender.getMaxPlainLength(false));
+  ASSERT_EQ(sender.protectRtp(packet->data, &packet->length), 0);
+  EXPECT_LE(packet->length, static_cast<int>(sizeof(packet->data)));
+  ASSERT_EQ(receiver.unprotectRtp(packet->data, &packet->length), 0);
+  EXPECT_EQ(packet->length, kFullSizePacketLength);
+}
+
+TEST_F(SrtpChannelTest, shouldProtectFullSizeRtcpPackets) {
+  ASSERT_TRUE(setProfile(kCmKey, "SRTP_AES128_CM_SHA1_80"));
+  auto packet = rtcpPacket(kFullSizePacketLength);
+
+  ASSERT_LE(packet->length, sender.getMaxPlainLength(true));
+  ASSERT_EQ(sender.protectRtcp(packet->data, &packet->length), 0);
+  EXPECT_LE(packet->length, static_cast<int>(sizeof(packet->data)));
+  ASSERT_EQ(receiver.unprotectRtcp(packet->data, &packet->length), 0);
+  EXPECT_EQ(packet->length, kFullSizePacketLength);
+}
+
+TEST_F(SrtpChannelTest, shouldProtectFullSizeRtpPackets_whenUsingGcm) {
+  if (!SrtpChannel::isAeadSupported()) {
+    return;
+  }
+  ASSERT_TRUE(setProfile(kGcmKey, "SRTP_AEAD_AES_128_GCM"));
+  auto packet = rtpPacket(kFullSizePacketLength);
+
+  ASSERT_LE(packet->length, sender.getMaxPlainLength(false));
+  ASSERT_EQ(sender.protectRtp(packet->data, &packet->length), 0);
+  EXPECT_LE(packet->length, static_cast<int>(sizeof(packet->data)));
+  ASSERT_EQ(receiver.unprotectRtp(packet->data, &packet->length), 0);
+  EXPECT_EQ(packet->length, kFullSizePacketLength);
+}
+
+TEST_F(SrtpChannelTest, shouldLeaveRoomForTheTrailer_whenPacketsAreTooBig) {
+  ASSERT_TRUE(setProfile(kCmKey, "SRTP_AES128_CM_SHA1_80"));
+
+  EXPECT_EQ(sender.getMaxPlainLength(false), static_cast<int>(sizeof(DataPacket::data)) - 10);
+  EXPECT_EQ(sender.getMaxPlainLength(true),
+            static_cast<int>(sizeof(DataPacket::data)) - 10 - SrtpChannel::kSrtcpIndexLength);
+}
@@ -0,0 +1,309 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <UdpMux.h>
+#include <lib/ClockUtils.h>
+#include <thread/IOWorker.h>
+
+#include <chrono>  // NOLINT
+#include <future>  // NOLINT
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+using erizo::UdpMux;
+using erizo::UdpMuxAddress;
+using erizo::UdpMuxSteeringTable;
+using erizo::DataPacket;
+
+class UdpMuxSteeringTableTest : public ::testing::Test {
+ public:
+  UdpMuxSteeringTableTest()
+      : steering{std::make_shared<UdpMuxSteeringTable>()},
+        mux1{std::make_shared<UdpMux>(0, "", std::weak_ptr<erizo::IOWorker>(), steering)},
+        mux2{std::make_shared<UdpMux>(0, "", std::weak_ptr<erizo::IOWorker>(), steering)} {
+  }
+
+ protected:
+  UdpMuxAddress address(const std::string& ip, uint16_t port) {
+    UdpMuxAddress result;
+    result.addr.sin_port = htons(port);
+    inet_pton(AF_INET, ip.c_str(), &result.addr.sin_addr);
+    return result;
+  }
+
+  std::shared_ptr<UdpMuxSteeringTable> steering;
+  std::shared_ptr<UdpMux> mux1;
+  std::shared_ptr<UdpMux> mux2;
+};
+
+TEST_F(UdpMuxSteeringTableTest, shouldFindOwnersByUfrag) {
+  steering->addUfrag("ufrag1", mux1);
+  steering->addUfrag("ufrag2", mux2);
+
+  EXPECT_EQ(mux1, steering->findByUfrag("ufrag1"));
+  EXPECT_EQ(mux2, steering->findByUfrag("ufrag2"));
+  EXPECT_EQ(nullptr, steering->findByUfrag("unknown"));
+}
+
+TEST_F(UdpMuxSteeringTableTest, shouldFindOwnersByRemoteAddressAndPort) {
+  steering->addRemote(address("10.0.0.1", 5000), mux1);
+  steering->addRemote(address("10.0.0.1", 5001), mux2);
+
+  EXPECT_EQ(mux1, steering->findByRemote(address("10.0.0.1", 5000)));
+  EXPECT_EQ(mux2, steering->findByRemote(address("10.0.0.1", 5001)));
+  EXPECT_EQ(nullptr, steering->findByRemote(address("10.0.0.2", 5000)));
+}
+
+TEST_F(UdpMuxSteeringTableTest, shouldForgetRemovedEntries) {
+  steering->addUfrag("ufrag1", mux1);
+  steering->addRemote(address("10.0.0.1", 5000), mux1);
+
+  steering->removeUfrag("ufrag1");
+  steering->removeRemote(address("10.0.0.1", 5000));
+
+  EXPECT_EQ(nullptr, steering->findByUfrag("ufrag1"));
+  EXPECT_EQ(nullptr, steering->findByRemote(address("10.0.0.1", 5000)));
+  EXPECT_EQ(0u, steering->size());
+}
+
+TEST_F(UdpMuxSteeringTableTest, shouldNotReturnDestroyedMuxes) {
+  steering->addUfrag("ufrag1", mux1);
+
+  mux1.reset();
+
+  EXPECT_EQ(nullptr, steering->findByUfrag("ufrag1"));
+}
+
+class UdpMuxTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    mux = std::make_shared<UdpMux>(0, "");
+    ASSERT_TRUE(mux->start());
+    receiver = socket(AF_INET, SOCK_DGRAM, 0);
+    timeval timeout = {1, 0};
+    setsockopt(receiver, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    sockaddr_in local;
+    memset(&local, 0, sizeof(local));
+    local.sin_family = AF_INET;
+    inet_pton(AF_INET, "127.0.0.1", &local.sin_addr);
+    ASSERT_EQ(0, bind(receiver, reinterpret_cast<sockaddr*>(&local), sizeof(local)));
+    socklen_t length = sizeof(receiver_address.addr);
+    getsockname(receiver, reinterpret_cast<sockaddr*>(&receiver_address.addr), &length);
+  }
+
+  virtual void TearDown() {
+    mux->close();
+    close(receiver);
+  }
+
+  void queuePacket(char first_byte, int length) {
+    auto packet = std::make_shared<DataPacket>();
+    memset(packet->data, first_byte, length);
+    packet->length = length;
+    mux->queueSend(receiver_address, packet);
+  }
+
+  std::vector<std::string> receiveAll(size_t expected) {
+    std::vector<std::string> received;
+    char buf[1500];
+    while (received.size() < expected) {
+      ssize_t length = recv(receiver, buf, sizeof(buf), 0);
+      if (length <= 0) {
+        break;
+      }
+      received.push_back(std::string(buf, length));
+    }
+    return received;
+  }
+
+  std::shared_ptr<UdpMux> mux;
+  int receiver;
+  UdpMuxAddress receiver_address;
+};
+
+TEST_F(UdpMuxTest, shouldDeliverCoalescedPacketsInOrder) {
+  for (char index = 0; index < 10; index++) {
+    queuePacket(index, 1000);
+  }
+  queuePacket(10, 500);
+
+  mux->flush();
+
+  std::vector<std::string> received = receiveAll(11);
+  ASSERT_EQ(11u, received.size());
+  for (char index = 0; index < 10; index++) {
+    EXPECT_EQ(1000u, received[index].size());
+    EXPECT_EQ(index, received[index][0]);
+  }
+  EXPECT_EQ(500u, received[10].size());
+  if (mux->isGsoEnabled()) {
+    EXPECT_EQ(1u, mux->getGsoCalls());
+    EXPECT_EQ(11u, mux->getGsoSegments());
+  }
+}
+
+TEST_F(UdpMuxTest, shouldNotCoalescePacketsBiggerThanTheFirstOne) {
+  queuePacket(0, 500);
+  queuePacket(1, 1000);
+
+  mux->flush();
+
+  std::vector<std::string> received = receiveAll(2);
+  ASSERT_EQ(2u, received.size());
+  EXPECT_EQ(500u, received[0].size());
+  EXPECT_EQ(1000u, received[1].size());
+  EXPECT_EQ(0u, mux->getGsoCalls());
+}
+
+TEST_F(UdpMuxTest, shouldCountEachPacket_whenSendingCoalescedPacketsFails) {
+  // Broadcasts need SO_BROADCAST, so both the coalesced and the single sends fail
+  UdpMuxAddress broadcast_address = receiver_address;
+  broadcast_address.addr.sin_addr.s_addr = htonl(INADDR_BROADCAST);
+  for (char index = 0; index < 3; index++) {
+    auto packet = std::make_shared<DataPacket>();
+    memset(packet->data, index, 1000);
+    packet->length = 1000;
+    mux->queueSend(broadcast_address, packet);
+  }
+
+  mux->flush();
+
+  EXPECT_EQ(3u, mux->getSocketStats().send_errors);
+  EXPECT_EQ(0u, mux->getGsoCalls());
+}
+
+TEST_F(UdpMuxTest, shouldStampPacketsWithTheTimeTheyArrivedAt) {
+  if (!mux->areTimestampsEnabled()) {
+    return;
+  }
+  UdpMuxAddress mux_address = receiver_address;
+  mux_address.addr.sin_port = htons(mux->getPort());
+  char buf[1500];
+  memset(buf, 0, sizeof(buf));
+  sendto(receiver, buf, 100, 0, reinterpret_cast<sockaddr*>(&mux_address.addr), sizeof(mux_address.addr));
+  uint64_t sent_time_us = erizo::ClockUtils::timePointToUs(erizo::clock::now());
+
+  // A busy worker gets to the socket late
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  char control[UdpMux::kControlSize];
+  iovec iov = {buf, sizeof(buf)};
+  msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  ASSERT_EQ(100, recvmsg(mux->getSocket(), &msg, 0));
+  uint64_t read_time_us = erizo::ClockUtils::timePointToUs(erizo::clock::now());
+  int segment_size = 0;
+  uint64_t received_time_us = 0;
+  mux->parseControlMessages(&msg, &segment_size, &received_time_us);
+
+  EXPECT_LT(received_time_us, sent_time_us + 20000);
+  EXPECT_GT(read_time_us - received_time_us, 40000u);
+  EXPECT_EQ(0, segment_size);
+}
+
+TEST_F(UdpMuxTest, shouldReportKernelDropsAndQueuedBytes) {
+  UdpMuxAddress mux_address = receiver_address;
+  mux_address.addr.sin_port = htons(mux->getPort());
+  char buf[1500];
+  memset(buf, 0, sizeof(buf));
+  // Nobody reads the mux socket, so the receive buffer ends up overflowing
+  for (int index = 0; index < 5000; index++) {
+    sendto(receiver, buf, 1200, 0, reinterpret_cast<sockaddr*>(&mux_address.addr), sizeof(mux_address.addr));
+  }
+
+  erizo::SocketStats stats = mux->getSocketStats();
+  EXPECT_TRUE(stats.available);
+  EXPECT_GT(stats.receive_queued_bytes, 0u);
+  EXPECT_GT(stats.receive_buffer_size, 0u);
+
+  // Datagrams carry the drop count from when they were queued, so one has to be queued after the drops
+  auto read_packet = [this, &buf] {
+    char control[UdpMux::kControlSize];
+    iovec iov = {buf, sizeof(buf)};
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    if (recvmsg(mux->getSocket(), &msg, 0) <= 0) {
+      return false;
+    }
+    int segment_size = 0;
+    uint64_t received_time_us = 0;
+    mux->parseControlMessages(&msg, &segment_size, &received_time_us);
+    return true;
+  };
+  while (read_packet()) {
+  }
+  sendto(receiver, buf, 1200, 0, reinterpret_cast<sockaddr*>(&mux_address.addr), sizeof(mux_address.addr));
+  ASSERT_TRUE(read_packet());
+
+  EXPECT_GT(mux->getSocketStats().receive_queue_drops, 0u);
+}
+
+class SendErrorListener : public erizo::UdpMuxListener {
+ public:
+  void onMuxPacket(const UdpMuxAddress& remote, erizo::PacketPtr packet) override {}
+  void onMuxSendError(const UdpMuxAddress& remote, int error) override {
+    errors.push_back(error);
+  }
+
+  std::vector<int> errors;
+};
+
+TEST_F(UdpMuxTest, shouldCountSendErrorsAndTellTheConnection) {
+  auto listener = std::make_shared<SendErrorListener>();
+  mux->bindRemote(receiver_address, listener);
+
+  mux->onSendError(receiver_address, EAGAIN);
+  mux->onSendError(receiver_address, ENOBUFS);
+  mux->onSendError(receiver_address, ENOBUFS);
+  mux->onSendError(receiver_address, EPERM);
+
+  erizo::SocketStats stats = mux->getSocketStats();
+  EXPECT_EQ(1u, stats.send_would_block);
+  EXPECT_EQ(2u, stats.send_no_buffers);
+  EXPECT_EQ(1u, stats.send_errors);
+  EXPECT_EQ(4u, listener->errors.size());
+}
+
+class ClosingThreadUdpMux : public UdpMux {
+ public:
+  explicit ClosingThreadUdpMux(std::shared_ptr<erizo::IOWorker> io_worker) : UdpMux(0, "", io_worker) {}
+
+  void close() override {
+    closing_thread = std::this_thread::get_id();
+    UdpMux::close();
+  }
+
+  std::thread::id closing_thread;
+};
+
+TEST(UdpMuxWorkerTest, shouldBeClosedFromItsWorker_whenTheWorkerCloses) {
+  auto worker = std::make_shared<erizo::IOWorker>();
+  auto mux = std::make_shared<ClosingThreadUdpMux>(worker);
+  worker->setUdpMux(mux);
+  worker->start();
+  auto started = std::make_shared<std::promise<std::thread::id>>();
+  worker->task([mux, started] {
+    mux->start();
+    started->set_value(std::this_thread::get_id());
+  });
+  std::thread::id worker_thread = started->get_future().get();
+
+  worker->close();
+
+  EXPECT_EQ(worker_thread, mux->closing_thread);
+  EXPECT_LT(mux->getSocket(), 0);
+}
@@ -42,7 +42,7 @@ class WebRtcConnectionTest :
     simulated_worker->start();
     io_worker = std::make_shared<erizo::IOWorker>();
     io_worker->start();
-    connection = std::make_shared<WebRtcConnection>(simulated_worker, io_worker,
+    connection = std::make_shared<WebRtcConnection>(simulated_worker, io_worker, simulated_worker,
       "test_connection", ice_config, rtp_maps, ext_maps, nullptr);
     transport = std::make_shared<erizo::MockTransport>("test_connection", true, ice_config,
                                                        simulated_worker, io_worker);
@@ -0,0 +1,200 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <dtls/DtlsSocket.h>
+#include <lib/ClockUtils.h>
+#include <thread/ThreadPool.h>
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <future>  // NOLINT
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <vector>
+
+using dtls::DtlsReceiver;
+using dtls::DtlsSocket;
+using dtls::DtlsSocketContext;
+using erizo::ThreadPool;
+using erizo::Worker;
+
+constexpr int kSimultaneousHandshakes = 1000;
+constexpr int kNumWorkers = 4;
+constexpr std::chrono::seconds kHandshakeTimeout{60};
+
+// One side of a handshake, DTLS packets are delivered to the other side through its worker as the transports do
+class HandshakePeer : public DtlsReceiver {
+ public:
+  HandshakePeer(std::shared_ptr<Worker> the_worker, bool is_server)
+      : worker{the_worker}, context{new DtlsSocketContext()}, peer{nullptr}, finished{false}, failed{false}, cpu_us{0} {
+    if (is_server) {
+      context->createServer();
+    } else {
+      context->createClient();
+    }
+    context->setDtlsReceiver(this);
+  }
+
+  void start() {
+    worker->task([this] {
+      context->start();
+    });
+  }
+
+  // Retransmits flights as DtlsTransport's TimeoutChecker does, handshakes stall without it when workers lag behind
+  void checkTimeouts() {
+    worker->scheduleEvery([this] {
+      if (finished) {
+        return false;
+      }
+      context->handleTimeout();
+      return true;
+    }, std::chrono::seconds(1));
+  }
+
+  void onDtlsPacket(DtlsSocketContext *ctx, const unsigned char* data, unsigned int len) override {
+    auto packet = std::make_shared<std::string>(reinterpret_cast<const char*>(data), len);
+    HandshakePeer *receiver = peer;
+    receiver->worker->task([receiver, packet] {
+      receiver->context->read(reinterpret_cast<const unsigned char*>(packet->data()), packet->size());
+    });
+  }
+
+  void onHandshakeCompleted(DtlsSocketContext *ctx, std::string clientKey, std::string serverKey,
+                            std::string srtp_profile) override {
+    client_key = clientKey;
+    server_key = serverKey;
+    profile = srtp_profile;
+    version = ctx->getVersion();
+    cpu_us = ctx->getHandshakeCpuUs();
+    completed_time = erizo::clock::now();
+    finish();
+  }
+
+  void onHandshakeFailed(DtlsSocketContext *ctx, const std::string& error) override {
+    failed = true;
+    finish();
+  }
+
+  std::shared_ptr<Worker> worker;
+  std::unique_ptr<DtlsSocketContext> context;
+  HandshakePeer *peer;
+  bool finished;
+  bool failed;
+  std::string client_key;
+  std::string server_key;
+  std::string profile;
+  std::string version;
+  uint64_t cpu_us;
+  erizo::time_point completed_time;
+  std::promise<void> done;
+
+ private:
+  // A socket can report a failure after completing, or fail more than once, but the promise is only set once
+  void finish() {
+    finished = true;
+    std::call_once(done_flag, [this] {
+      done.set_value();
+    });
+  }
+
+  std::once_flag done_flag;
+};
+
+class DtlsSocketContextTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    thread_pool = std::make_shared<ThreadPool>(kNumWorkers);
+    thread_pool->start();
+  }
+
+  virtual void TearDown() {
+    thread_pool->close();
+    clients.clear();
+    servers.clear();
+  }
+
+  void createHandshakes(int count) {
+    for (int index = 0; index < count; index++) {
+      clients.push_back(std::unique_ptr<HandshakePeer>(new HandshakePeer(thread_pool->getLessUsedWorker(), false)));
+      servers.push_back(std::unique_ptr<HandshakePeer>(new HandshakePeer(thread_pool->getLessUsedWorker(), true)));
+      clients.back()->peer = servers.back().get();
+      servers.back()->peer = clients.back().get();
+      clients.back()->checkTimeouts();
+      servers.back()->checkTimeouts();
+    }
+  }
+
+  bool waitForHandshakes() {
+    auto deadline = std::chrono::steady_clock::now() + kHandshakeTimeout;
+    for (auto peers : {&clients, &servers}) {
+      for (auto &peer : *peers) {
+        if (peer->done.get_future().wait_until(deadline) != std::future_status::ready) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  std::shared_ptr<ThreadPool> thread_pool;
+  std::vector<std::unique_ptr<HandshakePeer>> clients;
+  std::vector<std::unique_ptr<HandshakePeer>> servers;
+};
+
+TEST_F(DtlsSocketContextTest, shouldNegotiateTheSameKeysOnBothSides) {
+  createHandshakes(1);
+
+  clients[0]->start();
+
+  ASSERT_TRUE(waitForHandshakes());
+  EXPECT_FALSE(clients[0]->failed);
+  EXPECT_FALSE(servers[0]->failed);
+  EXPECT_FALSE(clients[0]->client_key.empty());
+  EXPECT_EQ(clients[0]->client_key, servers[0]->client_key);
+  EXPECT_EQ(clients[0]->server_key, servers[0]->server_key);
+  EXPECT_FALSE(clients[0]->profile.empty());
+  EXPECT_EQ(clients[0]->profile, servers[0]->profile);
+  EXPECT_EQ(clients[0]->version, "DTLSv1.2");
+  EXPECT_EQ(servers[0]->version, "DTLSv1.2");
+  EXPECT_GT(clients[0]->cpu_us, 0u);
+  EXPECT_GT(servers[0]->cpu_us, 0u);
+}
+
+TEST_F(DtlsSocketContextTest, shouldUseTheCachedFingerprintOfTheCertificate) {
+  createHandshakes(1);
+  char fingerprint[100] = {};
+
+  DtlsSocket::computeFingerprint(DtlsSocketContext::mCert, fingerprint);
+
+  EXPECT_EQ(clients[0]->context->getFingerprint(), std::string(fingerprint));
+  EXPECT_EQ(servers[0]->context->getFingerprint(), std::string(fingerprint));
+}
+
+TEST_F(DtlsSocketContextTest, shouldCompleteSimultaneousHandshakesInParallel) {
+  createHandshakes(kSimultaneousHandshakes);
+
+  erizo::time_point start = erizo::clock::now();
+  for (auto &client : clients) {
+    client->start();
+  }
+
+  ASSERT_TRUE(waitForHandshakes());
+  std::vector<int> connected_ms;
+  uint64_t cpu_us = 0;
+  for (int index = 0; index < kSimultaneousHandshakes; index++) {
+    EXPECT_FALSE(clients[index]->failed);
+    EXPECT_FALSE(servers[index]->failed);
+    EXPECT_EQ(clients[index]->client_key, servers[index]->client_key);
+    cpu_us += clients[index]->cpu_us + servers[index]->cpu_us;
+    erizo::time_point connected = std::max(clients[index]->completed_time, servers[index]->completed_time);
+    connected_ms.push_back(static_cast<int>(erizo::ClockUtils::durationToMs(connected - start)));
+  }
+  std::sort(connected_ms.begin(), connected_ms.end());
+  RecordProperty("handshakes", kSimultaneousHandshakes);
+  RecordProperty("timeToConnectedP50Ms", connected_ms[connected_ms.size() / 2]);
+  RecordProperty("timeToConnectedP99Ms", connected_ms[connected_ms.size() * 99 / 100]);
+  RecordProperty("timeToConnectedMaxMs", connected_ms.back());
+  RecordProperty("handshakeCpuUsPerPeer", static_cast<int>(cpu_us / (2 * kSimultaneousHandshakes)));
+}
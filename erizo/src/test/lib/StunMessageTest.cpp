@@ -0,0 +1,93 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+
+#include <lib/StunMessage.h>
+
+#include <string>
+
+using erizo::StunMessage;
+
+// RFC 5769 2.1 Sample Request
+static const unsigned char kSampleRequest[] = {
+  0x00, 0x01, 0x00, 0x58, 0x21, 0x12, 0xa4, 0x42, 0xb7, 0xe7, 0xa7, 0x01, 0xbc, 0x34, 0xd6, 0x86,
+  0xfa, 0x87, 0xdf, 0xae, 0x80, 0x22, 0x00, 0x10, 0x53, 0x54, 0x55, 0x4e, 0x20, 0x74, 0x65, 0x73,
+  0x74, 0x20, 0x63, 0x6c, 0x69, 0x65, 0x6e, 0x74, 0x00, 0x24, 0x00, 0x04, 0x6e, 0x00, 0x01, 0xff,
+  0x80, 0x29, 0x00, 0x08, 0x93, 0x2f, 0xf9, 0xb1, 0x51, 0x26, 0x3b, 0x36, 0x00, 0x06, 0x00, 0x09,
+  0x65, 0x76, 0x74, 0x6a, 0x3a, 0x68, 0x36, 0x76, 0x59, 0x20, 0x20, 0x20, 0x00, 0x08, 0x00, 0x14,
+  0x9a, 0xea, 0xa7, 0x0c, 0xbf, 0xd8, 0xcb, 0x56, 0x78, 0x1e, 0xf2, 0xb5, 0xb2, 0xd3, 0xf2, 0x49,
+  0xc1, 0xb5, 0x71, 0xa2, 0x80, 0x28, 0x00, 0x04, 0xe5, 0x7a, 0x3b, 0xcf
+};
+static const char kSamplePassword[] = "VOkJxbRl1RmTxUk/WvJxBt";
+
+class StunMessageTest : public ::testing::Test {
+ protected:
+  const char* sample() { return reinterpret_cast<const char*>(kSampleRequest); }
+  int sampleLength() { return sizeof(kSampleRequest); }
+};
+
+TEST_F(StunMessageTest, shouldDetectStunPackets) {
+  char rtp[] = {static_cast<char>(0x80), 0x60, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+  EXPECT_TRUE(StunMessage::isStun(sample(), sampleLength()));
+  EXPECT_FALSE(StunMessage::isStun(rtp, sizeof(rtp)));
+  EXPECT_FALSE(StunMessage::isStun(sample(), sampleLength() - 4));
+}
+
+TEST_F(StunMessageTest, shouldParseBindingRequestAttributes) {
+  StunMessage message;
+
+  ASSERT_TRUE(message.parse(sample(), sampleLength()));
+
+  EXPECT_EQ(StunMessage::kBindingRequest, message.getType());
+  EXPECT_EQ("evtj:h6vY", message.getUsername());
+  EXPECT_EQ("evtj", message.getLocalUfrag());
+  EXPECT_EQ(0x6e0001ffu, message.getPriority());
+  EXPECT_FALSE(message.hasUseCandidate());
+}
+
+TEST_F(StunMessageTest, shouldValidateIntegrityAndFingerprint) {
+  StunMessage message;
+
+  ASSERT_TRUE(message.parse(sample(), sampleLength()));
+
+  EXPECT_TRUE(message.checkIntegrity(kSamplePassword));
+  EXPECT_FALSE(message.checkIntegrity("wrong password"));
+  EXPECT_TRUE(message.checkFingerprint());
+}
+
+TEST_F(StunMessageTest, shouldBuildSignedBindingResponses) {
+  StunMessage request;
+  ASSERT_TRUE(request.parse(sample(), sampleLength()));
+  sockaddr_in mapped;
+  memset(&mapped, 0, sizeof(mapped));
+  mapped.sin_family = AF_INET;
+  mapped.sin_port = htons(32853);
+  inet_pton(AF_INET, "192.0.2.1", &mapped.sin_addr);
+  char out[128];
+
+  int length = request.buildBindingResponse(mapped, kSamplePassword, out, sizeof(out));
+
+  ASSERT_GT(length, 0);
+  StunMessage response;
+  ASSERT_TRUE(response.parse(out, length));
+  EXPECT_EQ(StunMessage::kBindingSuccessResponse, response.getType());
+  EXPECT_EQ(request.getTransactionId(), response.getTransactionId());
+  EXPECT_TRUE(response.checkIntegrity(kSamplePassword));
+  EXPECT_TRUE(response.checkFingerprint());
+  // XOR-MAPPED-ADDRESS from RFC 5769 2.2
+  const unsigned char kXorMappedAddress[] = {0x00, 0x20, 0x00, 0x08, 0x00, 0x01, 0xa1, 0x47, 0xe1, 0x12, 0xa6, 0x43};
+  EXPECT_EQ(0, memcmp(out + StunMessage::kHeaderLength, kXorMappedAddress, sizeof(kXorMappedAddress)));
+}
+
+TEST_F(StunMessageTest, shouldNotBuildResponsesIntoSmallBuffers) {
+  StunMessage request;
+  ASSERT_TRUE(request.parse(sample(), sampleLength()));
+  sockaddr_in mapped;
+  memset(&mapped, 0, sizeof(mapped));
+  char out[32];
+
+  EXPECT_EQ(-1, request.buildBindingResponse(mapped, kSamplePassword, out, sizeof(out)));
+}
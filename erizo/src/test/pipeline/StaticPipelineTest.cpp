@@ -0,0 +1,450 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <pipeline/Handler.h>
+#include <pipeline/StaticPipeline.h>
+#include <rtp/RtpHeaders.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+using erizo::DataPacket;
+using erizo::Handler;
+using erizo::InboundHandler;
+using erizo::OutboundHandler;
+using erizo::PacketBatch;
+using erizo::PacketPtr;
+using erizo::Pipeline;
+using erizo::RtcpHeader;
+using erizo::RtpHeader;
+using erizo::StaticPipeline;
+
+// Every handler leaves its name in the packet, so the path a packet took can be checked at the end
+static void stamp(PacketPtr packet, char name) {
+  packet->data[packet->length++] = name;
+}
+
+template <char kName, uint8_t kRead = erizo::kAllPackets, uint8_t kWrite = erizo::kAllPackets>
+class BothHandler : public Handler {
+ public:
+  static const uint8_t read_packets = kRead;
+  static const uint8_t write_packets = kWrite;
+
+  void enable() override { enabled = true; }
+  void disable() override { enabled = false; }
+  std::string getName() override { return std::string(1, kName); }
+  void read(Context *ctx, PacketPtr packet) override {
+    stamp(packet, kName);
+    ctx->fireRead(std::move(packet));
+  }
+  void write(Context *ctx, PacketPtr packet) override {
+    stamp(packet, kName);
+    ctx->fireWrite(std::move(packet));
+  }
+  void notifyUpdate() override { updates++; }
+
+  bool enabled = true;
+  int updates = 0;
+};
+
+template <char kName>
+class InHandler : public InboundHandler {
+ public:
+  void enable() override {}
+  void disable() override {}
+  std::string getName() override { return std::string(1, kName); }
+  void read(Context *ctx, PacketPtr packet) override {
+    stamp(packet, kName);
+    ctx->fireRead(std::move(packet));
+  }
+  void notifyUpdate() override {}
+};
+
+template <char kName>
+class OutHandler : public OutboundHandler {
+ public:
+  void enable() override {}
+  void disable() override {}
+  std::string getName() override { return std::string(1, kName); }
+  void write(Context *ctx, PacketPtr packet) override {
+    stamp(packet, kName);
+    ctx->fireWrite(std::move(packet));
+  }
+  void notifyUpdate() override {}
+};
+
+class Sink : public InboundHandler {
+ public:
+  void enable() override {}
+  void disable() override {}
+  std::string getName() override { return "sink"; }
+  void read(Context *ctx, PacketPtr packet) override {
+    packets.push_back(std::string(packet->data, packet->length));
+  }
+  void readBatch(Context *ctx, PacketBatch batch) override {
+    batches.push_back(batch.size());
+    InboundHandler::readBatch(ctx, std::move(batch));
+  }
+  void notifyUpdate() override {}
+
+  std::vector<std::string> packets;
+  std::vector<size_t> batches;
+};
+
+class Source : public OutboundHandler {
+ public:
+  void enable() override {}
+  void disable() override {}
+  std::string getName() override { return "source"; }
+  void write(Context *ctx, PacketPtr packet) override {
+    packets.push_back(std::string(packet->data, packet->length));
+  }
+  void writeBatch(Context *ctx, PacketBatch batch) override {
+    batches.push_back(batch.size());
+    OutboundHandler::writeBatch(ctx, std::move(batch));
+  }
+  void notifyUpdate() override {}
+
+  std::vector<std::string> packets;
+  std::vector<size_t> batches;
+};
+
+// Lets every other packet through
+class Dropper : public InboundHandler {
+ public:
+  void enable() override {}
+  void disable() override {}
+  std::string getName() override { return "dropper"; }
+  void read(Context *ctx, PacketPtr packet) override {
+    if (packets++ % 2 == 0) {
+      ctx->fireRead(std::move(packet));
+    }
+  }
+  void notifyUpdate() override {}
+
+  int packets = 0;
+};
+
+// Logs which packet it handles, so the order of the calls of every handler can be checked
+template <char kName>
+class OrderRecorder : public Handler {
+ public:
+  explicit OrderRecorder(std::vector<std::string> *calls) : calls_{calls} {}
+
+  void enable() override {}
+  void disable() override {}
+  std::string getName() override { return std::string(1, kName); }
+  void read(Context *ctx, PacketPtr packet) override {
+    calls_->push_back(std::string(1, kName) + packet->data[0]);
+    ctx->fireRead(std::move(packet));
+  }
+  void write(Context *ctx, PacketPtr packet) override {
+    calls_->push_back(std::string(1, kName) + packet->data[0]);
+    ctx->fireWrite(std::move(packet));
+  }
+  void notifyUpdate() override {}
+
+ private:
+  std::vector<std::string> *calls_;
+};
+
+// Only wants to hear about mute changes
+class MuteListener : public InboundHandler {
+ public:
+  static const uint8_t notified_updates = erizo::kMuteUpdate;
+
+  void enable() override {}
+  void disable() override {}
+  std::string getName() override { return "mute"; }
+  void read(Context *ctx, PacketPtr packet) override { ctx->fireRead(std::move(packet)); }
+  void notifyUpdate() override { updates++; }
+
+  int updates = 0;
+};
+
+typedef StaticPipeline<Source, BothHandler<'a'>, OutHandler<'b'>, InHandler<'c'>, BothHandler<'d'>, Sink>
+    TestPipeline;
+
+class StaticPipelineTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    source = std::make_shared<Source>();
+    sink = std::make_shared<Sink>();
+    handler_a = std::make_shared<BothHandler<'a'>>();
+    handler_d = std::make_shared<BothHandler<'d'>>();
+    pipeline = TestPipeline::create(source, handler_a, std::make_shared<OutHandler<'b'>>(),
+                                    std::make_shared<InHandler<'c'>>(), handler_d, sink);
+    pipeline->finalize();
+
+    dynamic_sink = std::make_shared<Sink>();
+    dynamic_source = std::make_shared<Source>();
+    dynamic_pipeline = Pipeline::create();
+    dynamic_pipeline->addBack(dynamic_source);
+    dynamic_pipeline->addBack(std::make_shared<BothHandler<'a'>>());
+    dynamic_pipeline->addBack(std::make_shared<OutHandler<'b'>>());
+    dynamic_pipeline->addBack(std::make_shared<InHandler<'c'>>());
+    dynamic_pipeline->addBack(std::make_shared<BothHandler<'d'>>());
+    dynamic_pipeline->addBack(dynamic_sink);
+    dynamic_pipeline->finalize();
+  }
+
+  static PacketPtr emptyPacket() {
+    auto packet = std::make_shared<DataPacket>();
+    packet->length = 0;
+    return packet;
+  }
+
+  static PacketBatch emptyPackets(int count) {
+    PacketBatch packets;
+    for (int index = 0; index < count; index++) {
+      packets.push_back(emptyPacket());
+    }
+    return packets;
+  }
+
+  static PacketPtr rtpPacket(erizo::packetType type) {
+    PacketPtr packet = emptyPacket();
+    RtpHeader header;
+    header.setPayloadType(type == erizo::AUDIO_PACKET ? 111 : 96);
+    memcpy(packet->data, &header, header.getHeaderLength());
+    packet->length = header.getHeaderLength();
+    packet->type = type;
+    return packet;
+  }
+
+  static PacketPtr rtcpPacket(uint8_t packet_type) {
+    PacketPtr packet = emptyPacket();
+    RtcpHeader header;
+    header.setPacketType(packet_type);
+    header.setLength(1);
+    memcpy(packet->data, &header, 8);
+    packet->length = 8;
+    return packet;
+  }
+
+  std::shared_ptr<Source> source;
+  std::shared_ptr<Sink> sink;
+  std::shared_ptr<BothHandler<'a'>> handler_a;
+  std::shared_ptr<BothHandler<'d'>> handler_d;
+  TestPipeline::Ptr pipeline;
+
+  std::shared_ptr<Source> dynamic_source;
+  std::shared_ptr<Sink> dynamic_sink;
+  Pipeline::Ptr dynamic_pipeline;
+};
+
+TEST_F(StaticPipelineTest, shouldReadThroughInboundHandlersInOrder) {
+  pipeline->read(emptyPacket());
+  dynamic_pipeline->read(emptyPacket());
+
+  ASSERT_EQ(sink->packets.size(), 1u);
+  EXPECT_EQ(sink->packets[0], "acd");
+  EXPECT_EQ(sink->packets, dynamic_sink->packets);
+}
+
+TEST_F(StaticPipelineTest, shouldWriteThroughOutboundHandlersInReverseOrder) {
+  pipeline->write(emptyPacket());
+  dynamic_pipeline->write(emptyPacket());
+
+  ASSERT_EQ(source->packets.size(), 1u);
+  EXPECT_EQ(source->packets[0], "dba");
+  EXPECT_EQ(source->packets, dynamic_source->packets);
+}
+
+TEST_F(StaticPipelineTest, shouldFindHandlersAndForwardNotifications) {
+  EXPECT_EQ(pipeline->getHandler<BothHandler<'a'>>(), handler_a.get());
+  EXPECT_EQ(pipeline->getHandler<Sink>(), sink.get());
+  EXPECT_EQ(handler_a->getContext(), pipeline->getContext<BothHandler<'a'>>());
+
+  int updates = handler_d->updates;
+  pipeline->notifyUpdate();
+  pipeline->disable("d");
+
+  EXPECT_EQ(handler_d->updates, updates + 1);
+  EXPECT_FALSE(handler_d->enabled);
+  EXPECT_TRUE(handler_a->enabled);
+}
+
+TEST_F(StaticPipelineTest, shouldOnlyNotifyHandlersOfTheUpdatesTheyWant) {
+  auto listener = std::make_shared<MuteListener>();
+  auto dynamic_listener = std::make_shared<MuteListener>();
+  auto static_pipeline = StaticPipeline<Source, MuteListener, Sink>::create(std::make_shared<Source>(), listener,
+                                                                           std::make_shared<Sink>());
+  dynamic_pipeline->addFront(dynamic_listener);
+  static_pipeline->finalize();
+  dynamic_pipeline->finalize();
+  int updates = handler_d->updates;
+
+  static_pipeline->notifyUpdate(erizo::kBandwidthUpdate | erizo::kSdpUpdate);
+  dynamic_pipeline->notifyUpdate(erizo::kBandwidthUpdate | erizo::kSdpUpdate);
+  pipeline->notifyUpdate(erizo::kBandwidthUpdate);
+
+  EXPECT_EQ(listener->updates, 1);
+  EXPECT_EQ(dynamic_listener->updates, 1);
+  EXPECT_EQ(handler_d->updates, updates + 1);
+
+  static_pipeline->notifyUpdate(erizo::kMuteUpdate);
+  dynamic_pipeline->notifyUpdate(erizo::kMuteUpdate);
+
+  EXPECT_EQ(listener->updates, 2);
+  EXPECT_EQ(dynamic_listener->updates, 2);
+}
+
+TEST_F(StaticPipelineTest, shouldNotMeasureHandlersByDefault) {
+  pipeline->read(emptyPacket());
+
+  EXPECT_TRUE(pipeline->getHandlerStats().empty());
+}
+
+TEST_F(StaticPipelineTest, shouldMeasureEveryHandlerOnceEnabled) {
+  pipeline->enableHandlerStats();
+  dynamic_pipeline->enableHandlerStats();
+
+  for (Pipeline::Ptr each_pipeline : {Pipeline::Ptr(pipeline), dynamic_pipeline}) {
+    each_pipeline->read(emptyPacket());
+    each_pipeline->read(emptyPacket());
+    each_pipeline->write(emptyPacket());
+
+    erizo::HandlerStatsMap stats = each_pipeline->getHandlerStats();
+    EXPECT_EQ(stats.size(), 6u);
+    EXPECT_EQ(stats["a"].read.packets, 2u);
+    EXPECT_EQ(stats["a"].write.packets, 1u);
+    EXPECT_EQ(stats["b"].read.packets, 0u);
+    EXPECT_EQ(stats["b"].write.packets, 1u);
+    EXPECT_EQ(stats["c"].read.packets, 2u);
+    EXPECT_EQ(stats["sink"].read.packets, 2u);
+    EXPECT_EQ(stats["source"].write.packets, 1u);
+    // The ends of the chain have no next handler, they don't drop what they keep
+    EXPECT_EQ(stats["a"].read.drops, 0u);
+    EXPECT_EQ(stats["sink"].read.drops, 0u);
+    EXPECT_EQ(stats["source"].write.drops, 0u);
+    EXPECT_GT(stats["a"].read.percentileUpperBoundNs(0.99), 0u);
+  }
+}
+
+TEST_F(StaticPipelineTest, shouldCountPacketsHandlersDoNotForward) {
+  auto dropping_sink = std::make_shared<Sink>();
+  auto dropping_pipeline = StaticPipeline<BothHandler<'a'>, Dropper, Sink>::create(
+    std::make_shared<BothHandler<'a'>>(), std::make_shared<Dropper>(), dropping_sink);
+  dropping_pipeline->finalize();
+  dropping_pipeline->enableHandlerStats();
+
+  for (int index = 0; index < 4; index++) {
+    dropping_pipeline->read(emptyPacket());
+  }
+
+  erizo::HandlerStatsMap stats = dropping_pipeline->getHandlerStats();
+  EXPECT_EQ(dropping_sink->packets.size(), 2u);
+  EXPECT_EQ(stats["dropper"].read.packets, 4u);
+  EXPECT_EQ(stats["dropper"].read.drops, 2u);
+  EXPECT_EQ(stats["a"].read.drops, 0u);
+}
+
+TEST_F(StaticPipelineTest, shouldSkipHandlersForPacketsTheyDoNotWant) {
+  auto masked_source = std::make_shared<Source>();
+  auto masked_sink = std::make_shared<Sink>();
+  auto masked_pipeline = StaticPipeline<Source, BothHandler<'v', erizo::kRtpVideoPackets, erizo::kRtpVideoPackets>,
+                                        BothHandler<'f', erizo::kRtcpFeedbackPackets, erizo::kNoPackets>,
+                                        InHandler<'c'>, Sink>::create(masked_source,
+    std::make_shared<BothHandler<'v', erizo::kRtpVideoPackets, erizo::kRtpVideoPackets>>(),
+    std::make_shared<BothHandler<'f', erizo::kRtcpFeedbackPackets, erizo::kNoPackets>>(),
+    std::make_shared<InHandler<'c'>>(), masked_sink);
+  masked_pipeline->finalize();
+
+  masked_pipeline->read(rtpPacket(erizo::AUDIO_PACKET));
+  masked_pipeline->read(rtpPacket(erizo::VIDEO_PACKET));
+  masked_pipeline->read(rtcpPacket(RTCP_PS_Feedback_PT));
+  masked_pipeline->read(rtcpPacket(RTCP_Receiver_PT));
+  masked_pipeline->write(rtpPacket(erizo::AUDIO_PACKET));
+  masked_pipeline->write(rtpPacket(erizo::VIDEO_PACKET));
+
+  ASSERT_EQ(masked_sink->packets.size(), 4u);
+  EXPECT_EQ(masked_sink->packets[0].substr(12), "c");
+  EXPECT_EQ(masked_sink->packets[1].substr(12), "vc");
+  EXPECT_EQ(masked_sink->packets[2].substr(8), "fc");
+  EXPECT_EQ(masked_sink->packets[3].substr(8), "c");
+  ASSERT_EQ(masked_source->packets.size(), 2u);
+  EXPECT_EQ(masked_source->packets[0].substr(12), "");
+  EXPECT_EQ(masked_source->packets[1].substr(12), "v");
+}
+
+TEST_F(StaticPipelineTest, shouldReadAndWriteBatchesInOrderAndTogether) {
+  for (Pipeline::Ptr each_pipeline : {Pipeline::Ptr(pipeline), dynamic_pipeline}) {
+    PacketBatch packets = emptyPackets(3);
+    packets[1]->data[0] = '1';
+    packets[1]->length = 1;
+    each_pipeline->readBatch(std::move(packets));
+    each_pipeline->writeBatch(emptyPackets(2));
+  }
+
+  EXPECT_EQ(sink->packets, std::vector<std::string>({"acd", "1acd", "acd"}));
+  EXPECT_EQ(source->packets, std::vector<std::string>({"dba", "dba"}));
+  EXPECT_EQ(sink->packets, dynamic_sink->packets);
+  EXPECT_EQ(source->packets, dynamic_source->packets);
+  // The handlers in between read them one by one, what they pass on still goes on as one batch
+  EXPECT_EQ(sink->batches, std::vector<size_t>({3}));
+  EXPECT_EQ(source->batches, std::vector<size_t>({2}));
+  EXPECT_EQ(sink->batches, dynamic_sink->batches);
+  EXPECT_EQ(source->batches, dynamic_source->batches);
+}
+
+TEST_F(StaticPipelineTest, shouldKeepThePacketOrderInEveryHandler_whenHandlingBatches) {
+  std::vector<std::string> calls;
+  auto recording_source = std::make_shared<Source>();
+  auto recording_sink = std::make_shared<Sink>();
+  auto recording_pipeline = StaticPipeline<Source, OrderRecorder<'x'>, OrderRecorder<'y'>, Sink>::create(
+    recording_source, std::make_shared<OrderRecorder<'x'>>(&calls), std::make_shared<OrderRecorder<'y'>>(&calls),
+    recording_sink);
+  recording_pipeline->finalize();
+  PacketBatch packets = emptyPackets(3);
+  for (int index = 0; index < 3; index++) {
+    stamp(packets[index], '0' + index);
+  }
+
+  recording_pipeline->readBatch(packets);
+  recording_pipeline->writeBatch(packets);
+
+  // Every handler goes through the whole batch, in order, before the next handler gets any of it
+  EXPECT_EQ(calls, std::vector<std::string>({"x0", "x1", "x2", "y0", "y1", "y2",
+                                             "y0", "y1", "y2", "x0", "x1", "x2"}));
+  EXPECT_EQ(recording_sink->packets, std::vector<std::string>({"0", "1", "2"}));
+  EXPECT_EQ(recording_source->packets, std::vector<std::string>({"0", "1", "2"}));
+}
+
+TEST_F(StaticPipelineTest, shouldCountPacketsHandlersDoNotForwardFromBatches) {
+  auto dropping_sink = std::make_shared<Sink>();
+  auto dropping_pipeline = StaticPipeline<Dropper, Sink>::create(std::make_shared<Dropper>(), dropping_sink);
+  dropping_pipeline->finalize();
+  dropping_pipeline->enableHandlerStats();
+
+  dropping_pipeline->readBatch(emptyPackets(4));
+
+  erizo::HandlerStatsMap stats = dropping_pipeline->getHandlerStats();
+  EXPECT_EQ(dropping_sink->batches, std::vector<size_t>({2}));
+  EXPECT_EQ(stats["dropper"].read.packets, 4u);
+  EXPECT_EQ(stats["dropper"].read.drops, 2u);
+  EXPECT_EQ(stats["sink"].read.packets, 2u);
+}
+
+TEST_F(StaticPipelineTest, shouldSplitBatchesInRunsOfPacketsHandlersWant) {
+  auto masked_sink = std::make_shared<Sink>();
+  auto masked_pipeline = StaticPipeline<BothHandler<'v', erizo::kRtpVideoPackets, erizo::kRtpVideoPackets>,
+                                        InHandler<'c'>, Sink>::create(
+    std::make_shared<BothHandler<'v', erizo::kRtpVideoPackets, erizo::kRtpVideoPackets>>(),
+    std::make_shared<InHandler<'c'>>(), masked_sink);
+  masked_pipeline->finalize();
+  masked_pipeline->enableHandlerStats();
+
+  masked_pipeline->readBatch({rtpPacket(erizo::AUDIO_PACKET), rtpPacket(erizo::VIDEO_PACKET),
+                              rtpPacket(erizo::VIDEO_PACKET), rtcpPacket(RTCP_Receiver_PT)});
+
+  ASSERT_EQ(masked_sink->packets.size(), 4u);
+  EXPECT_EQ(masked_sink->packets[0].substr(12), "c");
+  EXPECT_EQ(masked_sink->packets[1].substr(12), "vc");
+  EXPECT_EQ(masked_sink->packets[2].substr(12), "vc");
+  EXPECT_EQ(masked_sink->packets[3].substr(8), "c");
+  EXPECT_EQ(masked_sink->batches, std::vector<size_t>({1, 2, 1}));
+  EXPECT_EQ(masked_pipeline->getHandlerStats()["v"].read.packets, 2u);
+}
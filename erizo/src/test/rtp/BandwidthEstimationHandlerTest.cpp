@@ -20,6 +20,7 @@ using ::testing::_;
 using ::testing::IsNull;
 using ::testing::Args;
 using ::testing::Return;
+using ::testing::Invoke;
 using erizo::DataPacket;
 using erizo::packetType;
 using erizo::AUDIO_PACKET;
@@ -111,3 +112,41 @@ TEST_F(BandwidthEstimationHandlerTest, shouldSendRembPacketWithCappedBitrate) {
 
   picker->observer_->OnReceiveBitrateChanged(std::vector<uint32_t>(), kArbitraryBitrate);
 }
+
+TEST_F(BandwidthEstimationHandlerTest, shouldKeepArrivalSpacingOfPacketsReadLate) {
+  const uint64_t kArrivalSpacingUs = 20000;
+  const int kPackets = 10;
+  std::vector<int64_t> arrival_times;
+  EXPECT_CALL(estimator, Process());
+  EXPECT_CALL(estimator, TimeUntilNextProcess()).WillRepeatedly(Return(1000));
+  EXPECT_CALL(estimator, IncomingPacket(_, _, _)).Times(kPackets).WillRepeatedly(
+    Invoke([&arrival_times](int64_t arrival_time_ms, size_t payload_size, const webrtc::RTPHeader& header) {
+      arrival_times.push_back(arrival_time_ms);
+    }));
+  EXPECT_CALL(*reader.get(), read(_, _)).Times(kPackets);
+
+  // Packets arrived at the socket every 20ms but the worker was busy and reads them in a burst
+  uint64_t now_us = erizo::ClockUtils::timePointToUs(erizo::clock::now());
+  for (int index = 0; index < kPackets; index++) {
+    auto packet = erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber + index, VIDEO_PACKET);
+    packet->setReceivedTime(now_us - (kPackets - index) * kArrivalSpacingUs);
+    pipeline->read(packet);
+  }
+
+  ASSERT_EQ(static_cast<size_t>(kPackets), arrival_times.size());
+  for (int index = 1; index < kPackets; index++) {
+    EXPECT_NEAR(kArrivalSpacingUs / 1000, arrival_times[index] - arrival_times[index - 1], 1);
+  }
+}
+
+TEST_F(BandwidthEstimationHandlerTest, shouldFeedProbesToTheEstimatorWithoutReadingThem) {
+  auto packet = erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber, VIDEO_PACKET);
+  auto probe = erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber + 1, VIDEO_PACKET);
+  EXPECT_CALL(estimator, Process());
+  EXPECT_CALL(estimator, TimeUntilNextProcess()).WillRepeatedly(Return(1000));
+  EXPECT_CALL(estimator, IncomingPacket(_, _, _)).Times(2);
+  EXPECT_CALL(*reader.get(), read(_, _)).Times(1);
+
+  pipeline->read(packet);
+  bwe_handler->readProbe(probe);
+}
@@ -97,3 +97,42 @@ TEST_F(FecReceiverHandlerTest, shouldWritePacketsWhenCalledFromFecReceiver) {
 
     fec_receiver_handler->OnRecoveredPacket(reinterpret_cast<const uint8_t*>(packet->data), packet->length);
 }
+
+class FecReceiverHandlerLazyTest : public erizo::HandlerTest {
+ public:
+  FecReceiverHandlerLazyTest() {}
+
+ protected:
+  void setHandler() {
+    fec_receiver_handler = std::make_shared<FecReceiverHandler>();
+    pipeline->addBack(fec_receiver_handler);
+  }
+
+  std::shared_ptr<FecReceiverHandler> fec_receiver_handler;
+};
+
+TEST_F(FecReceiverHandlerLazyTest, shouldNotBuildFecReceiverWithoutREDpackets) {
+    auto packet = erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber, VIDEO_PACKET);
+
+    fec_receiver_handler->enable();
+
+    EXPECT_CALL(*writer.get(), write(_, _)).Times(1);
+
+    pipeline->write(packet);
+
+    EXPECT_FALSE(fec_receiver_handler->hasFecReceiver());
+}
+
+TEST_F(FecReceiverHandlerLazyTest, shouldBuildFecReceiverOnFirstREDpacketWhenEnabled) {
+    auto packet = erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber, VIDEO_PACKET);
+    RtpHeader *rtp_header = reinterpret_cast<RtpHeader*>(packet->data);
+    rtp_header->setPayloadType(RED_90000_PT);
+
+    fec_receiver_handler->enable();
+
+    EXPECT_CALL(*writer.get(), write(_, _)).Times(testing::AtLeast(1));
+
+    pipeline->write(packet);
+
+    EXPECT_TRUE(fec_receiver_handler->hasFecReceiver());
+}
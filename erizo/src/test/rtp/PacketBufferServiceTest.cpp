@@ -0,0 +1,184 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <rtp/PacketBufferService.h>
+#include <rtp/RtpHeaders.h>
+#include <lib/Clock.h>
+#include <MediaDefinitions.h>
+
+#include <cstring>
+#include <memory>
+
+using erizo::DataPacket;
+using erizo::PacketBufferService;
+using erizo::PacketPtr;
+using erizo::RtpHeader;
+using erizo::SimulatedClock;
+
+static PacketPtr createPacket(uint16_t seq_number, erizo::packetType type) {
+  RtpHeader header;
+  header.setSeqNumber(seq_number);
+  return std::make_shared<DataPacket>(0, reinterpret_cast<char*>(&header), header.getHeaderLength(), type);
+}
+
+TEST(PacketBufferServiceTest, shouldKeepAudioAndVideoPackets) {
+  PacketBufferService buffer;
+  PacketPtr audio_packet = createPacket(100, erizo::AUDIO_PACKET);
+  PacketPtr video_packet = createPacket(100, erizo::VIDEO_PACKET);
+
+  buffer.insertPacket(audio_packet);
+  buffer.insertPacket(video_packet);
+
+  EXPECT_EQ(buffer.getAudioPacket(100), audio_packet);
+  EXPECT_EQ(buffer.getVideoPacket(100), video_packet);
+}
+
+TEST(PacketBufferServiceTest, shouldOnlyKeepAudioPackets_whenItHasNoVideo) {
+  PacketBufferService buffer{false};
+  PacketPtr audio_packet = createPacket(100, erizo::AUDIO_PACKET);
+
+  buffer.insertPacket(audio_packet);
+  buffer.insertPacket(createPacket(100, erizo::VIDEO_PACKET));
+
+  EXPECT_EQ(buffer.getAudioPacket(100), audio_packet);
+  EXPECT_EQ(buffer.getVideoPacket(100), nullptr);
+}
+
+TEST(PacketBufferServiceTest, shouldDropPackets_whenTheyAreOlderThanTheBufferTime) {
+  auto clock = std::make_shared<SimulatedClock>();
+  PacketBufferService buffer{true, clock};
+
+  buffer.insertPacket(createPacket(100, erizo::VIDEO_PACKET));
+  clock->advanceTime(kMinPacketBufferTime + std::chrono::milliseconds(1));
+  buffer.insertPacket(createPacket(101, erizo::VIDEO_PACKET));
+
+  EXPECT_EQ(buffer.getVideoPacket(100), nullptr);
+  EXPECT_NE(buffer.getVideoPacket(101), nullptr);
+}
+
+TEST(PacketBufferServiceTest, shouldKeepPacketsForSomeRoundTrips_whenTheRoundTripTimeIsHigh) {
+  auto clock = std::make_shared<SimulatedClock>();
+  PacketBufferService buffer{true, clock};
+
+  buffer.setRoundTripTime(std::chrono::milliseconds(800));
+  buffer.insertPacket(createPacket(100, erizo::VIDEO_PACKET));
+  clock->advanceTime(std::chrono::seconds(2));
+  buffer.insertPacket(createPacket(101, erizo::VIDEO_PACKET));
+
+  EXPECT_EQ(buffer.getBufferTime(), kRoundTripsInPacketBuffer * std::chrono::milliseconds(800));
+  EXPECT_NE(buffer.getVideoPacket(100), nullptr);
+}
+
+TEST(PacketBufferServiceTest, shouldFindPackets_whenSequenceNumbersHaveGapsAndRollOver) {
+  PacketBufferService buffer;
+  for (uint16_t seq_number : {65533, 65535, 1, 2}) {
+    buffer.insertPacket(createPacket(seq_number, erizo::VIDEO_PACKET));
+  }
+
+  EXPECT_NE(buffer.getVideoPacket(65533), nullptr);
+  EXPECT_NE(buffer.getVideoPacket(65535), nullptr);
+  EXPECT_NE(buffer.getVideoPacket(1), nullptr);
+  EXPECT_EQ(buffer.getVideoPacket(0), nullptr);
+  EXPECT_EQ(buffer.getVideoPacket(3), nullptr);
+  EXPECT_EQ(buffer.getVideoPacket(65532), nullptr);
+}
+
+TEST(PacketBufferServiceTest, shouldFindPackets_whenTheyWereInsertedOutOfOrder) {
+  PacketBufferService buffer;
+  for (uint16_t seq_number : {65534, 1, 65535, 3, 0, 2, 65533}) {
+    buffer.insertPacket(createPacket(seq_number, erizo::VIDEO_PACKET));
+  }
+
+  for (uint16_t seq_number : {65533, 65534, 65535, 0, 1, 2, 3}) {
+    EXPECT_NE(buffer.getVideoPacket(seq_number), nullptr) << "seq_number: " << seq_number;
+  }
+  EXPECT_EQ(buffer.getVideoPacket(4), nullptr);
+  EXPECT_EQ(buffer.getVideoPacket(65532), nullptr);
+}
+
+TEST(PacketBufferServiceTest, shouldKeepTheLastCopy_whenAPacketIsInsertedTwice) {
+  PacketBufferService buffer;
+  PacketPtr retransmitted_packet = createPacket(100, erizo::VIDEO_PACKET);
+
+  buffer.insertPacket(createPacket(100, erizo::VIDEO_PACKET));
+  buffer.insertPacket(createPacket(101, erizo::VIDEO_PACKET));
+  buffer.insertPacket(retransmitted_packet);
+
+  EXPECT_EQ(buffer.getBufferedPackets(), 2u);
+  EXPECT_EQ(buffer.getVideoPacket(100), retransmitted_packet);
+}
+
+TEST(PacketBufferServiceTest, shouldDropTheOldestPackets_whenTheyTakeMoreThanTheMaxBytes) {
+  PacketBufferService buffer;
+  buffer.insertPacket(createPacket(0, erizo::AUDIO_PACKET));
+  size_t max_packets = kMaxPacketBufferBytes / buffer.getBufferedBytes();
+  for (size_t index = 1; index <= max_packets; index++) {
+    buffer.insertPacket(createPacket(index, erizo::AUDIO_PACKET));
+  }
+
+  EXPECT_EQ(buffer.getBufferedPackets(), max_packets);
+  EXPECT_LE(buffer.getBufferedBytes(), kMaxPacketBufferBytes);
+  EXPECT_EQ(buffer.getAudioPacket(0), nullptr);
+  EXPECT_NE(buffer.getAudioPacket(max_packets), nullptr);
+}
+
+TEST(PacketBufferServiceTest, shouldKeepMorePackets_whenTheyShareTheSourceOnes) {
+  PacketBufferService buffer;
+  PacketPtr source_packet = createPacket(0, erizo::VIDEO_PACKET);
+  size_t max_own_packets = kMaxPacketBufferBytes / sizeof(DataPacket);
+  for (size_t index = 0; index <= max_own_packets; index++) {
+    PacketPtr sent_packet = createPacket(index, erizo::VIDEO_PACKET);
+    sent_packet->source_packet = source_packet;
+    buffer.insertPacket(sent_packet);
+  }
+
+  EXPECT_EQ(buffer.getBufferedPackets(), max_own_packets + 1);
+  EXPECT_NE(buffer.getVideoPacket(0), nullptr);
+}
+
+TEST(PacketBufferServiceTest, shouldNotCountReplacedPackets_whenAPacketIsInsertedTwice) {
+  PacketBufferService buffer;
+  buffer.insertPacket(createPacket(100, erizo::VIDEO_PACKET));
+  size_t buffered_bytes = buffer.getBufferedBytes();
+
+  buffer.insertPacket(createPacket(100, erizo::VIDEO_PACKET));
+
+  EXPECT_EQ(buffer.getBufferedBytes(), buffered_bytes);
+}
+
+TEST(PacketBufferServiceTest, shouldKeepTheSourcePacket_whenOnlyItsFirstBytesWereRewritten) {
+  PacketBufferService buffer;
+  PacketPtr source_packet = createPacket(100, erizo::VIDEO_PACKET);
+  source_packet->length = 1000;
+  PacketPtr sent_packet = std::make_shared<DataPacket>(*source_packet);
+  sent_packet->source_packet = source_packet;
+  reinterpret_cast<RtpHeader*>(sent_packet->data)->setSeqNumber(200);
+  reinterpret_cast<RtpHeader*>(sent_packet->data)->setSSRC(1234);
+
+  buffer.insertPacket(sent_packet);
+  std::weak_ptr<DataPacket> sent = sent_packet;
+  PacketPtr expected_packet = std::make_shared<DataPacket>(*sent_packet);
+  sent_packet.reset();
+  PacketPtr recovered_packet = buffer.getVideoPacket(200);
+
+  EXPECT_TRUE(sent.expired());
+  ASSERT_NE(recovered_packet, nullptr);
+  EXPECT_EQ(recovered_packet->length, expected_packet->length);
+  EXPECT_EQ(memcmp(recovered_packet->data, expected_packet->data, expected_packet->length), 0);
+}
+
+TEST(PacketBufferServiceTest, shouldKeepTheSentPacketWithoutItsSource_whenItsLengthWasChanged) {
+  PacketBufferService buffer;
+  PacketPtr source_packet = createPacket(100, erizo::VIDEO_PACKET);
+  source_packet->length = 1000;
+  PacketPtr sent_packet = std::make_shared<DataPacket>(*source_packet);
+  sent_packet->source_packet = source_packet;
+  sent_packet->length = 900;
+
+  buffer.insertPacket(sent_packet);
+  std::weak_ptr<DataPacket> source = source_packet;
+  source_packet.reset();
+
+  EXPECT_EQ(buffer.getVideoPacket(100), sent_packet);
+  EXPECT_TRUE(source.expired());
+}
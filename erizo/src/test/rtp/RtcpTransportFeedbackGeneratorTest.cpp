@@ -0,0 +1,104 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <rtp/RtcpTransportFeedbackGenerator.h>
+
+#include <memory>
+#include <vector>
+
+using erizo::RtcpTransportFeedbackGenerator;
+using webrtc::rtcp::TransportFeedback;
+
+static constexpr uint32_t kMediaSsrc = 1111;
+static constexpr int64_t kArrivalTimeMs = 10000;
+
+class RtcpTransportFeedbackGeneratorTest : public ::testing::Test {
+ public:
+  RtcpTransportFeedbackGeneratorTest() : clock{kArrivalTimeMs * 1000},
+    generator{&clock, [this](TransportFeedback *feedback) {
+      rtc::Buffer buffer = feedback->Build();
+      std::unique_ptr<TransportFeedback> sent = TransportFeedback::ParseFrom(buffer.data(), buffer.size());
+      ASSERT_NE(sent, nullptr);
+      base_seq_nums.push_back(sent->GetBaseSequence());
+      media_ssrcs.push_back(sent->media_ssrc());
+      statuses.push_back(sent->GetStatusVector());
+    }} {}
+
+ protected:
+  void receivePacket(uint16_t transport_seq_num, int64_t arrival_time_ms, bool has_transport_seq_num = true) {
+    webrtc::RTPHeader header;
+    header.ssrc = kMediaSsrc;
+    header.extension.hasTransportSequenceNumber = has_transport_seq_num;
+    header.extension.transportSequenceNumber = transport_seq_num;
+    generator.IncomingPacket(arrival_time_ms, 1000, header);
+  }
+
+  webrtc::SimulatedClock clock;
+  RtcpTransportFeedbackGenerator generator;
+  std::vector<uint16_t> base_seq_nums;
+  std::vector<uint32_t> media_ssrcs;
+  std::vector<std::vector<TransportFeedback::StatusSymbol>> statuses;
+};
+
+TEST_F(RtcpTransportFeedbackGeneratorTest, shouldNotSendFeedback_whenNoPacketArrived) {
+  generator.Process();
+
+  EXPECT_TRUE(base_seq_nums.empty());
+  EXPECT_FALSE(generator.LatestEstimate(nullptr, nullptr));
+}
+
+TEST_F(RtcpTransportFeedbackGeneratorTest, shouldIgnorePackets_whenTheyHaveNoTransportSequenceNumber) {
+  receivePacket(10, kArrivalTimeMs, false);
+
+  generator.Process();
+
+  EXPECT_TRUE(base_seq_nums.empty());
+}
+
+TEST_F(RtcpTransportFeedbackGeneratorTest, shouldReportReceivedAndLostPackets) {
+  receivePacket(10, kArrivalTimeMs);
+  receivePacket(12, kArrivalTimeMs + 5);
+
+  generator.Process();
+
+  ASSERT_EQ(base_seq_nums.size(), 1u);
+  EXPECT_EQ(base_seq_nums[0], 10);
+  EXPECT_EQ(media_ssrcs[0], kMediaSsrc);
+  ASSERT_EQ(statuses[0].size(), 3u);
+  EXPECT_NE(statuses[0][0], TransportFeedback::StatusSymbol::kNotReceived);
+  EXPECT_EQ(statuses[0][1], TransportFeedback::StatusSymbol::kNotReceived);
+  EXPECT_NE(statuses[0][2], TransportFeedback::StatusSymbol::kNotReceived);
+}
+
+TEST_F(RtcpTransportFeedbackGeneratorTest, shouldOnlyReportNewPackets_whenTheOldOnesWereReported) {
+  receivePacket(10, kArrivalTimeMs);
+  generator.Process();
+  receivePacket(11, kArrivalTimeMs + 5);
+  receivePacket(12, kArrivalTimeMs + 10);
+
+  generator.Process();
+
+  ASSERT_EQ(base_seq_nums.size(), 2u);
+  EXPECT_EQ(base_seq_nums[1], 11);
+  EXPECT_EQ(statuses[1].size(), 2u);
+}
+
+TEST_F(RtcpTransportFeedbackGeneratorTest, shouldReportPacketsInOrder_whenTheSequenceNumberRollsOver) {
+  receivePacket(65535, kArrivalTimeMs);
+  receivePacket(0, kArrivalTimeMs + 5);
+
+  generator.Process();
+
+  ASSERT_EQ(base_seq_nums.size(), 1u);
+  EXPECT_EQ(base_seq_nums[0], 65535);
+  EXPECT_EQ(statuses[0].size(), 2u);
+}
+
+TEST_F(RtcpTransportFeedbackGeneratorTest, shouldWaitTheSendInterval_afterSendingFeedback) {
+  EXPECT_EQ(generator.TimeUntilNextProcess(), 0);
+
+  generator.Process();
+  clock.AdvanceTimeMilliseconds(30);
+
+  EXPECT_EQ(generator.TimeUntilNextProcess(), RtcpTransportFeedbackGenerator::kSendIntervalMs - 30);
+}
@@ -2,9 +2,11 @@
 #include <gtest/gtest.h>
 
 #include <rtp/RtpExtensionProcessor.h>
+#include <rtp/RtpHeaders.h>
 
 #include <atomic>
 #include <chrono>  // NOLINT
+#include <cstring>
 #include <string>
 #include <vector>
 #include <thread>  // NOLINT
@@ -17,7 +19,18 @@ class RtpExtensionProcessorTest : public ::testing::Test {
  public:
   virtual void SetUp() {
     ext_mappings.push_back({1, "urn:ietf:params:rtp-hdrext:ssrc-audio-level"});
+    ext_mappings.push_back({3, kTransportWideCCUri});
   }
+
+  std::shared_ptr<erizo::SdpInfo> sdpWithVideoExtension(unsigned int id, std::string uri) {
+    auto sdp = std::make_shared<erizo::SdpInfo>(std::vector<erizo::RtpMap>());
+    erizo::ExtMap ext_map(id, uri);
+    ext_map.mediaType = erizo::VIDEO_TYPE;
+    sdp->extMapVector.push_back(ext_map);
+    return sdp;
+  }
+
+  const std::string kTransportWideCCUri = "http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01";
   virtual void TearDown() {
   }
 
@@ -47,3 +60,43 @@ TEST_F(RtpExtensionProcessorTest, extensionShouldBeInvalidWhenWeDoNotKnowIt) {
 
   EXPECT_THAT(is_valid, Eq(false));
 }
+
+TEST_F(RtpExtensionProcessorTest, shouldHaveTransportWideCC_whenItIsNegotiated) {
+  erizo::RtpExtensionProcessor processor(ext_mappings);
+
+  processor.setSdpInfo(sdpWithVideoExtension(3, kTransportWideCCUri));
+
+  EXPECT_THAT(processor.hasTransportWideCC(), Eq(true));
+}
+
+TEST_F(RtpExtensionProcessorTest, shouldNotHaveTransportWideCC_whenItIsNotNegotiated) {
+  erizo::RtpExtensionProcessor processor(ext_mappings);
+
+  processor.setSdpInfo(sdpWithVideoExtension(1, "urn:ietf:params:rtp-hdrext:ssrc-audio-level"));
+
+  EXPECT_THAT(processor.hasTransportWideCC(), Eq(false));
+}
+
+TEST_F(RtpExtensionProcessorTest, shouldNumberSentPacketsWithItsOwnTransportSequenceNumbers) {
+  erizo::RtpExtensionProcessor processor(ext_mappings);
+  processor.setSdpInfo(sdpWithVideoExtension(3, kTransportWideCCUri));
+  erizo::RtpHeader header;
+  header.setExtension(1);
+  header.setExtId(0xBEDE);
+  header.setExtLength(1);
+  auto packet = std::make_shared<erizo::DataPacket>(0, reinterpret_cast<char*>(&header), header.getHeaderLength(),
+                                                    erizo::VIDEO_PACKET);
+  erizo::RtpHeader *sent_header = reinterpret_cast<erizo::RtpHeader*>(packet->data);
+  char *extensions = reinterpret_cast<char*>(&sent_header->extensions);
+  const char kTransportSeqNumExtension[] = {0x31, 0x12, 0x34, 0x00};
+  memcpy(extensions, kTransportSeqNumExtension, sizeof(kTransportSeqNumExtension));
+
+  processor.processRtpExtensions(packet);
+  const char kFirstSeqNumExtension[] = {0x31, 0x00, 0x00, 0x00};
+  EXPECT_THAT(memcmp(extensions, kFirstSeqNumExtension, sizeof(kFirstSeqNumExtension)), Eq(0));
+
+  memcpy(extensions, kTransportSeqNumExtension, sizeof(kTransportSeqNumExtension));
+  processor.processRtpExtensions(packet);
+  const char kSecondSeqNumExtension[] = {0x31, 0x00, 0x01, 0x00};
+  EXPECT_THAT(memcmp(extensions, kSecondSeqNumExtension, sizeof(kSecondSeqNumExtension)), Eq(0));
+}
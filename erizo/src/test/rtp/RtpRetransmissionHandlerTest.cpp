@@ -4,10 +4,12 @@
 #include <thread/Scheduler.h>
 #include <rtp/RtpRetransmissionHandler.h>
 #include <rtp/RtpHeaders.h>
+#include <rtp/RtpUtils.h>
 #include <stats/StatNode.h>
 #include <MediaDefinitions.h>
 #include <WebRtcConnection.h>
 
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -19,6 +21,7 @@ using ::testing::_;
 using ::testing::IsNull;
 using ::testing::Args;
 using ::testing::Return;
+using ::testing::SaveArg;
 using erizo::DataPacket;
 using erizo::packetType;
 using erizo::AUDIO_PACKET;
@@ -26,6 +29,7 @@ using erizo::VIDEO_PACKET;
 using erizo::IceConfig;
 using erizo::RtpMap;
 using erizo::RtpRetransmissionHandler;
+using erizo::RtpUtils;
 using erizo::WebRtcConnection;
 using erizo::Pipeline;
 using erizo::InboundHandler;
@@ -77,6 +81,24 @@ TEST_F(RtpRetransmissionHandlerTest, shouldRetransmitPackets_whenReceivingNacksW
     pipeline->read(nack_packet);
 }
 
+TEST_F(RtpRetransmissionHandlerTest, shouldRetransmitPackets_whenTheyWereWrittenInABatch) {
+    auto rtp_packet = erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber, VIDEO_PACKET);
+    auto next_rtp_packet = erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber + 1, VIDEO_PACKET);
+    uint ssrc = media_stream->getVideoSourceSSRC();
+    uint source_ssrc = media_stream->getVideoSinkSSRC();
+    auto nack_packet = erizo::PacketTools::createNack(ssrc, source_ssrc, erizo::kArbitrarySeqNumber + 1,
+                                                      VIDEO_PACKET);
+
+    EXPECT_CALL(*writer.get(), write(_, _)).
+      With(Args<1>(erizo::RtpHasSequenceNumber(erizo::kArbitrarySeqNumber))).Times(1);
+    EXPECT_CALL(*writer.get(), write(_, _)).
+      With(Args<1>(erizo::RtpHasSequenceNumber(erizo::kArbitrarySeqNumber + 1))).Times(2);
+    pipeline->writeBatch({rtp_packet, next_rtp_packet});
+
+    EXPECT_CALL(*reader.get(), read(_, _)).Times(0);
+    pipeline->read(nack_packet);
+}
+
 TEST_F(RtpRetransmissionHandlerTest, shouldNotRetransmitPackets_whenReceivingNacksWithBadSeqNum) {
     auto rtp_packet = erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber, VIDEO_PACKET);
     uint ssrc = media_stream->getVideoSourceSSRC();
@@ -154,3 +176,94 @@ TEST_F(RtpRetransmissionHandlerTest, shouldRetransmitPackets_whenReceivingNackWi
     EXPECT_CALL(*reader.get(), read(_, _)).Times(0);
     pipeline->read(nack_packet);
 }
+
+TEST_F(RtpRetransmissionHandlerTest, shouldCountBufferHitsAndMisses_whenReceivingNacks) {
+    uint ssrc = media_stream->getVideoSourceSSRC();
+    uint source_ssrc = media_stream->getVideoSinkSSRC();
+    auto nack_packet = erizo::PacketTools::createNack(ssrc, source_ssrc, erizo::kArbitrarySeqNumber, VIDEO_PACKET, 1);
+
+    pipeline->write(erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber, VIDEO_PACKET));
+    pipeline->read(nack_packet);
+
+    EXPECT_EQ(stats->getNode()["total"]["rtxBufferHits"].value(), 1u);
+    EXPECT_EQ(stats->getNode()["total"]["rtxBufferMisses"].value(), 1u);
+}
+
+TEST_F(RtpRetransmissionHandlerTest, shouldRetransmitOnTheRtxStream_whenRtxWasNegotiated) {
+    const uint32_t kRtxSsrc = 1234;
+    const unsigned int kPayloadType = 100;
+    const unsigned int kRtxPayloadType = 96;
+    uint ssrc = media_stream->getVideoSourceSSRC();
+    uint source_ssrc = media_stream->getVideoSinkSSRC();
+    auto nack_packet = erizo::PacketTools::createNack(ssrc, source_ssrc, erizo::kArbitrarySeqNumber, VIDEO_PACKET);
+    auto rtp_packet = erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber, VIDEO_PACKET);
+    reinterpret_cast<erizo::RtpHeader*>(rtp_packet->data)->setPayloadType(kPayloadType);
+    media_stream->setVideoSinkRtxSSRC(kRtxSsrc);
+    media_stream->getRemoteSdpInfo()->rtxPTMap[kPayloadType] = kRtxPayloadType;
+    erizo::PacketPtr rtx_packet;
+
+    EXPECT_CALL(*writer.get(), write(_, _)).With(Args<1>(erizo::RtpHasSsrcFromPacket(erizo::kVideoSsrc))).Times(1);
+    EXPECT_CALL(*writer.get(), write(_, _)).With(Args<1>(erizo::RtpHasSsrcFromPacket(kRtxSsrc))).
+      WillOnce(SaveArg<1>(&rtx_packet));
+    pipeline->write(rtp_packet);
+    pipeline->read(nack_packet);
+
+    ASSERT_NE(rtx_packet, nullptr);
+    EXPECT_EQ(reinterpret_cast<erizo::RtpHeader*>(rtx_packet->data)->getPayloadType(), kRtxPayloadType);
+    EXPECT_TRUE(RtpUtils::unwrapRtxPacket(rtx_packet, erizo::kVideoSsrc, kPayloadType));
+    EXPECT_EQ(rtx_packet->length, rtp_packet->length);
+    EXPECT_EQ(memcmp(rtx_packet->data, rtp_packet->data, rtp_packet->length), 0);
+}
+
+TEST_F(RtpRetransmissionHandlerTest, shouldNumberRtxPacketsConsecutively_whenRetransmittingSeveralTimes) {
+    const uint32_t kRtxSsrc = 1234;
+    const unsigned int kPayloadType = 100;
+    uint ssrc = media_stream->getVideoSourceSSRC();
+    uint source_ssrc = media_stream->getVideoSinkSSRC();
+    auto rtp_packet = erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber, VIDEO_PACKET);
+    reinterpret_cast<erizo::RtpHeader*>(rtp_packet->data)->setPayloadType(kPayloadType);
+    media_stream->setVideoSinkRtxSSRC(kRtxSsrc);
+    media_stream->getRemoteSdpInfo()->rtxPTMap[kPayloadType] = 96;
+    erizo::PacketPtr first_rtx_packet;
+    erizo::PacketPtr second_rtx_packet;
+
+    EXPECT_CALL(*writer.get(), write(_, _)).With(Args<1>(erizo::RtpHasSsrcFromPacket(erizo::kVideoSsrc))).Times(1);
+    EXPECT_CALL(*writer.get(), write(_, _)).With(Args<1>(erizo::RtpHasSsrcFromPacket(kRtxSsrc))).
+      WillOnce(SaveArg<1>(&first_rtx_packet)).WillOnce(SaveArg<1>(&second_rtx_packet));
+    pipeline->write(rtp_packet);
+    pipeline->read(erizo::PacketTools::createNack(ssrc, source_ssrc, erizo::kArbitrarySeqNumber, VIDEO_PACKET));
+    pipeline->read(erizo::PacketTools::createNack(ssrc, source_ssrc, erizo::kArbitrarySeqNumber, VIDEO_PACKET));
+
+    ASSERT_NE(first_rtx_packet, nullptr);
+    ASSERT_NE(second_rtx_packet, nullptr);
+    uint16_t first_seq_num = reinterpret_cast<erizo::RtpHeader*>(first_rtx_packet->data)->getSeqNumber();
+    uint16_t second_seq_num = reinterpret_cast<erizo::RtpHeader*>(second_rtx_packet->data)->getSeqNumber();
+    EXPECT_EQ(second_seq_num, static_cast<uint16_t>(first_seq_num + 1));
+}
+
+TEST_F(RtpRetransmissionHandlerTest, shouldRetransmitOnTheOriginalStream_whenRtxWasNotNegotiatedForThePayloadType) {
+    uint ssrc = media_stream->getVideoSourceSSRC();
+    uint source_ssrc = media_stream->getVideoSinkSSRC();
+    auto nack_packet = erizo::PacketTools::createNack(ssrc, source_ssrc, erizo::kArbitrarySeqNumber, VIDEO_PACKET);
+    media_stream->setVideoSinkRtxSSRC(1234);
+
+    EXPECT_CALL(*writer.get(), write(_, _)).With(Args<1>(erizo::RtpHasSsrcFromPacket(erizo::kVideoSsrc))).Times(2);
+    pipeline->write(erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber, VIDEO_PACKET));
+    pipeline->read(nack_packet);
+}
+
+TEST_F(RtpRetransmissionHandlerTest, shouldRetransmitOnTheOriginalStream_whenTheRtxPacketWouldNotFit) {
+    const unsigned int kPayloadType = 100;
+    uint ssrc = media_stream->getVideoSourceSSRC();
+    uint source_ssrc = media_stream->getVideoSinkSSRC();
+    auto nack_packet = erizo::PacketTools::createNack(ssrc, source_ssrc, erizo::kArbitrarySeqNumber, VIDEO_PACKET);
+    auto rtp_packet = erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber, VIDEO_PACKET);
+    reinterpret_cast<erizo::RtpHeader*>(rtp_packet->data)->setPayloadType(kPayloadType);
+    rtp_packet->length = erizo::kMaxPlainRtpPacketLength;
+    media_stream->setVideoSinkRtxSSRC(1234);
+    media_stream->getRemoteSdpInfo()->rtxPTMap[kPayloadType] = 96;
+
+    EXPECT_CALL(*writer.get(), write(_, _)).With(Args<1>(erizo::RtpHasSsrcFromPacket(erizo::kVideoSsrc))).Times(2);
+    pipeline->write(rtp_packet);
+    pipeline->read(nack_packet);
+}
@@ -92,3 +92,21 @@ TEST_F(SRPacketHandlerTest, shouldRewriteOctetsSent) {
   pipeline->write(packet);
   pipeline->write(sr_packet);
 }
+
+TEST_F(SRPacketHandlerTest, shouldNotCountRetransmissions_whenTheyAreSentOnTheRtxStream) {
+  const uint32_t kRtxSsrc = 1234;
+  int kArbitraryPacketsSent = 500;
+  uint32_t kArbitraryOctetsSent = 1000;
+  media_stream->setVideoSinkRtxSSRC(kRtxSsrc);
+  auto rtx_packet = erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber, VIDEO_PACKET);
+  reinterpret_cast<erizo::RtpHeader*>(rtx_packet->data)->setSSRC(kRtxSsrc);
+  auto sr_packet = erizo::PacketTools::createSenderReport(kRtxSsrc, VIDEO_PACKET, kArbitraryPacketsSent,
+      kArbitraryOctetsSent);
+  EXPECT_CALL(*writer.get(), write(_, _)).
+    With(Args<1>(erizo::RtpHasSequenceNumber(erizo::kArbitrarySeqNumber))).Times(1);
+  EXPECT_CALL(*writer.get(), write(_, _)).
+    With(Args<1>(erizo::SenderReportHasPacketsSentValue(kArbitraryPacketsSent))).Times(1);
+
+  pipeline->write(rtx_packet);
+  pipeline->write(sr_packet);
+}
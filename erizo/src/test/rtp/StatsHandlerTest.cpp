@@ -65,3 +65,15 @@ TEST_F(StatsHandlerTest, basicBehaviourShouldWritePackets) {
       With(Args<1>(erizo::RtpHasSequenceNumber(erizo::kArbitrarySeqNumber))).Times(1);
     pipeline->write(packet);
 }
+
+TEST_F(StatsHandlerTest, shouldNotReportRtxStreams) {
+    const uint32_t kRtxSsrc = 1234;
+    auto packet = erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber, VIDEO_PACKET);
+    reinterpret_cast<erizo::RtpHeader*>(packet->data)->setSSRC(kRtxSsrc);
+    media_stream->setVideoSourceRtxSSRCMap({{erizo::kVideoSsrc, kRtxSsrc}});
+
+    EXPECT_CALL(*reader.get(), read(_, _)).Times(1);
+    pipeline->read(packet);
+
+    EXPECT_FALSE(stats->getNode().hasChild(kRtxSsrc));
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include <stats/HandlerStats.h>
+
+using erizo::HandlerDirectionStats;
+using erizo::HandlerStats;
+
+TEST(HandlerStatsTest, shouldReportTheBucketOfThePercentile) {
+  HandlerDirectionStats stats;
+  for (int index = 0; index < 98; index++) {
+    stats.record(100, false);
+  }
+  stats.record(5000, false);
+  stats.record(5000, true);
+
+  EXPECT_EQ(stats.packets, 100u);
+  EXPECT_EQ(stats.drops, 1u);
+  EXPECT_EQ(stats.time_ns, 98u * 100 + 2 * 5000);
+  EXPECT_EQ(stats.percentileUpperBoundNs(0.5), 128u);
+  EXPECT_EQ(stats.percentileUpperBoundNs(0.99), 8192u);
+}
+
+TEST(HandlerStatsTest, shouldSubtractWhatWasAlreadyReported) {
+  HandlerStats stats;
+  stats.read.record(100, false);
+  HandlerStats reported = stats;
+  stats.read.record(3000, true);
+  stats.write.record(10, false);
+
+  stats.subtract(reported);
+
+  EXPECT_EQ(stats.read.packets, 1u);
+  EXPECT_EQ(stats.read.drops, 1u);
+  EXPECT_EQ(stats.read.time_ns, 3000u);
+  EXPECT_EQ(stats.read.percentileUpperBoundNs(0.99), 4096u);
+  EXPECT_EQ(stats.write.packets, 1u);
+}
+
+TEST(HandlerStatsTest, shouldReportBatchCallsApartFromSinglePackets) {
+  HandlerDirectionStats stats;
+  for (int index = 0; index < 100; index++) {
+    stats.record(100, false);
+  }
+  stats.recordBatch(20000, 10, 1);
+
+  EXPECT_EQ(stats.packets, 110u);
+  EXPECT_EQ(stats.drops, 1u);
+  EXPECT_EQ(stats.time_ns, 100u * 100 + 20000);
+  EXPECT_EQ(stats.batches, 1u);
+  // The batch took 2000 ns per packet on average, but that is not mixed with what single packets took
+  EXPECT_EQ(stats.percentileUpperBoundNs(0.99), 128u);
+  EXPECT_EQ(stats.batchPercentileUpperBoundNs(0.99), 32768u);
+}
@@ -0,0 +1,163 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <UdpMux.h>
+#include <lib/ClockUtils.h>
+#include <thread/IOUringWorker.h>
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <future>  // NOLINT
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+using erizo::PacketPtr;
+using erizo::IOUringWorker;
+using erizo::UdpMux;
+using erizo::UdpMuxAddress;
+using erizo::UdpMuxListener;
+
+class EchoListener : public UdpMuxListener {
+ public:
+  explicit EchoListener(std::shared_ptr<UdpMux> mux) : mux_{mux}, received{0}, queued_time_us{0} {}
+
+  void onMuxPacket(const UdpMuxAddress& remote, PacketPtr packet) override {
+    received++;
+    queued_time_us = erizo::ClockUtils::timePointToUs(erizo::clock::now()) - packet->received_time_us;
+    mux_->queueSend(remote, packet);
+  }
+
+  std::shared_ptr<UdpMux> mux_;
+  std::atomic<int> received;
+  std::atomic<uint64_t> queued_time_us;
+};
+
+class IOUringWorkerTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    if (!IOUringWorker::isSupported()) {
+      return;
+    }
+    worker = std::make_shared<IOUringWorker>();
+    mux = std::make_shared<UdpMux>(0, "", worker);
+    mux->setIoDriver(worker.get());
+    worker->setUdpMux(mux);
+    worker->start();
+
+    client = socket(AF_INET, SOCK_DGRAM, 0);
+    timeval timeout = {1, 0};
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    sockaddr_in local;
+    memset(&local, 0, sizeof(local));
+    local.sin_family = AF_INET;
+    inet_pton(AF_INET, "127.0.0.1", &local.sin_addr);
+    ASSERT_EQ(0, bind(client, reinterpret_cast<sockaddr*>(&local), sizeof(local)));
+    socklen_t length = sizeof(client_address.addr);
+    getsockname(client, reinterpret_cast<sockaddr*>(&client_address.addr), &length);
+
+    listener = std::make_shared<EchoListener>(mux);
+    runInWorker([this] {
+      mux->start();
+      mux->bindRemote(client_address, listener);
+    });
+    mux_address = client_address;
+    mux_address.addr.sin_port = htons(mux->getPort());
+  }
+
+  virtual void TearDown() {
+    if (worker) {
+      worker->close();
+      close(client);
+    }
+  }
+
+  void runInWorker(std::function<void()> f) {
+    auto done = std::make_shared<std::promise<void>>();
+    worker->task([f, done] {
+      f();
+      done->set_value();
+    });
+    done->get_future().wait();
+  }
+
+  std::shared_ptr<IOUringWorker> worker;
+  std::shared_ptr<UdpMux> mux;
+  std::shared_ptr<EchoListener> listener;
+  int client;
+  UdpMuxAddress client_address;
+  UdpMuxAddress mux_address;
+};
+
+TEST_F(IOUringWorkerTest, shouldRunTasks) {
+  if (!worker) {
+    return;
+  }
+  std::atomic<int> counter{0};
+  for (int index = 0; index < 100; index++) {
+    worker->task([&counter] { counter++; });
+  }
+
+  runInWorker([] {});
+
+  EXPECT_EQ(100, counter);
+}
+
+TEST_F(IOUringWorkerTest, shouldReceiveAndSendThroughTheRing) {
+  if (!worker) {
+    return;
+  }
+  char buf[1500];
+  for (char index = 0; index < 10; index++) {
+    memset(buf, index, 500);
+    sendto(client, buf, 500, 0, reinterpret_cast<sockaddr*>(&mux_address.addr), sizeof(mux_address.addr));
+  }
+
+  std::vector<std::string> echoed;
+  while (echoed.size() < 10) {
+    ssize_t length = recv(client, buf, sizeof(buf), 0);
+    if (length < 0 && errno == EINTR) {
+      continue;
+    }
+    if (length <= 0) {
+      break;
+    }
+    echoed.push_back(std::string(buf, length));
+  }
+
+  ASSERT_EQ(10u, echoed.size());
+  EXPECT_EQ(10, listener->received);
+  for (char index = 0; index < 10; index++) {
+    EXPECT_EQ(500u, echoed[index].size());
+    EXPECT_EQ(index, echoed[index][0]);
+  }
+  EXPECT_GT(worker->getSubmittedSqes(), 0u);
+}
+
+TEST_F(IOUringWorkerTest, shouldStampPacketsWithTheTimeTheyArrivedAt) {
+  if (!worker || !mux->areTimestampsEnabled()) {
+    return;
+  }
+  char buf[1500];
+  memset(buf, 0, sizeof(buf));
+  auto busy = std::make_shared<std::promise<void>>();
+  worker->task([busy] {
+    busy->set_value();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  });
+  busy->get_future().wait();
+  sendto(client, buf, 100, 0, reinterpret_cast<sockaddr*>(&mux_address.addr), sizeof(mux_address.addr));
+
+  ssize_t length;
+  do {
+    length = recv(client, buf, sizeof(buf), 0);
+  } while (length < 0 && errno == EINTR);
+
+  ASSERT_EQ(100, length);
+  EXPECT_GT(listener->queued_time_us, 20000u);
+}
@@ -15,6 +15,10 @@ MATCHER_P(RtpHasSsrc, ssrc, "") {
   return (reinterpret_cast<erizo::RtpHeader*>(std::get<0>(arg)))->getSSRC() == ssrc;
 }
 
+MATCHER_P(RtpHasSsrcFromPacket, ssrc, "") {
+  return (reinterpret_cast<erizo::RtpHeader*>(std::get<0>(arg)->data))->getSSRC() == ssrc;
+}
+
 MATCHER_P(RtpHasSequenceNumberFromBuffer, seq_num, "") {
   return (reinterpret_cast<erizo::RtpHeader*>(std::get<0>(arg)))->getSeqNumber() == seq_num;
 }
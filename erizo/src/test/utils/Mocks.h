@@ -77,7 +77,7 @@ class MockTransport: public Transport {
   }
   void onCandidate(const CandidateInfo &candidate, IceConnection *conn) override {
   }
-  void write(char* data, int len) override {
+  void write(PacketPtr packet) override {
   }
   void processLocalSdp(SdpInfo *localSdp_) override {
   }
@@ -91,7 +91,8 @@ class MockWebRtcConnection: public WebRtcConnection {
  public:
   MockWebRtcConnection(std::shared_ptr<Worker> worker, std::shared_ptr<IOWorker> io_worker, const IceConfig &ice_config,
                        const std::vector<RtpMap> rtp_mappings) :
-    WebRtcConnection(worker, io_worker, "", ice_config, rtp_mappings, std::vector<erizo::ExtMap>(), nullptr) {}
+    WebRtcConnection(worker, io_worker, worker, "", ice_config, rtp_mappings, std::vector<erizo::ExtMap>(),
+                     nullptr) {}
 
   virtual ~MockWebRtcConnection() {
   }
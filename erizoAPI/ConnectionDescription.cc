@@ -70,6 +70,8 @@ NAN_MODULE_INIT(ConnectionDescription::Init) {
   Nan::SetPrototypeMethod(tpl, "getAudioSsrcMap", getAudioSsrcMap);
   Nan::SetPrototypeMethod(tpl, "setVideoSsrcList", setVideoSsrcList);
   Nan::SetPrototypeMethod(tpl, "getVideoSsrcMap", getVideoSsrcMap);
+  Nan::SetPrototypeMethod(tpl, "setVideoRtxSsrc", setVideoRtxSsrc);
+  Nan::SetPrototypeMethod(tpl, "getVideoRtxSsrcMap", getVideoRtxSsrcMap);
 
   Nan::SetPrototypeMethod(tpl, "setVideoDirection", setVideoDirection);
   Nan::SetPrototypeMethod(tpl, "setAudioDirection", setAudioDirection);
@@ -326,6 +328,27 @@ NAN_METHOD(ConnectionDescription::getVideoSsrcMap) {
   info.GetReturnValue().Set(video_ssrc_map);
 }
 
+NAN_METHOD(ConnectionDescription::setVideoRtxSsrc) {
+  GET_SDP();
+  std::string stream_id = getString(info[0]);
+  unsigned int ssrc = info[1]->IntegerValue();
+  unsigned int rtx_ssrc = info[2]->IntegerValue();
+  sdp->video_rtx_ssrc_map[stream_id][ssrc] = rtx_ssrc;
+}
+
+NAN_METHOD(ConnectionDescription::getVideoRtxSsrcMap) {
+  GET_SDP();
+  Local<v8::Object> video_rtx_ssrc_map = Nan::New<v8::Object>();
+  for (auto const& video_rtx_ssrcs : sdp->video_rtx_ssrc_map) {
+    Local<v8::Object> rtx_ssrcs = Nan::New<v8::Object>();
+    for (auto const& rtx_ssrc : video_rtx_ssrcs.second) {
+      Nan::Set(rtx_ssrcs, Nan::New(rtx_ssrc.first), Nan::New(rtx_ssrc.second));
+    }
+    video_rtx_ssrc_map->Set(Nan::New(video_rtx_ssrcs.first.c_str()).ToLocalChecked(), rtx_ssrcs);
+  }
+  info.GetReturnValue().Set(video_rtx_ssrc_map);
+}
+
 NAN_METHOD(ConnectionDescription::setVideoDirection) {
   GET_SDP();
   std::string direction = getString(info[0]);
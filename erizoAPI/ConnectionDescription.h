@@ -48,6 +48,8 @@ class ConnectionDescription : public Nan::ObjectWrap {
     static NAN_METHOD(setVideoSsrcList);
     static NAN_METHOD(getAudioSsrcMap);
     static NAN_METHOD(getVideoSsrcMap);
+    static NAN_METHOD(setVideoRtxSsrc);
+    static NAN_METHOD(getVideoRtxSsrcMap);
 
     static NAN_METHOD(setVideoDirection);
     static NAN_METHOD(setAudioDirection);
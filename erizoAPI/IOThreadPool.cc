@@ -28,6 +28,7 @@ NAN_MODULE_INIT(IOThreadPool::Init) {
   // Prototype
   Nan::SetPrototypeMethod(tpl, "close", close);
   Nan::SetPrototypeMethod(tpl, "start", start);
+  Nan::SetPrototypeMethod(tpl, "getStats", getStats);
 
   constructor.Reset(tpl->GetFunction());
   Nan::Set(target, Nan::New("IOThreadPool").ToLocalChecked(), Nan::GetFunction(tpl).ToLocalChecked());
@@ -39,9 +40,28 @@ NAN_METHOD(IOThreadPool::New) {
   }
 
   unsigned int num_workers = info[0]->IntegerValue();
+  uint16_t udp_mux_port = 0;
+  std::string network_interface = "";
+  bool udp_mux_gro = false;
+  erizo::IOWorkerBackend backend = erizo::IOWorkerBackend::NRAPPKIT;
+  if (info.Length() > 1) {
+    udp_mux_port = info[1]->IntegerValue();
+  }
+  if (info.Length() > 2) {
+    v8::String::Utf8Value param(Nan::To<v8::String>(info[2]).ToLocalChecked());
+    network_interface = std::string(*param);
+  }
+  if (info.Length() > 3) {
+    udp_mux_gro = info[3]->BooleanValue();
+  }
+  if (info.Length() > 4) {
+    v8::String::Utf8Value param(Nan::To<v8::String>(info[4]).ToLocalChecked());
+    backend = erizo::IOThreadPool::backendFromString(std::string(*param));
+  }
 
   IOThreadPool* obj = new IOThreadPool();
-  obj->me.reset(new erizo::IOThreadPool(num_workers));
+  obj->me.reset(new erizo::IOThreadPool(num_workers, udp_mux_port, network_interface, udp_mux_gro,
+                                                 backend));
 
   obj->Wrap(info.This());
   info.GetReturnValue().Set(info.This());
@@ -56,5 +76,13 @@ NAN_METHOD(IOThreadPool::close) {
 NAN_METHOD(IOThreadPool::start) {
   IOThreadPool* obj = Nan::ObjectWrap::Unwrap<IOThreadPool>(info.Holder());
 
-  obj->me->start();
+  bool started = obj->me->start();
+  info.GetReturnValue().Set(Nan::New(started));
+}
+
+NAN_METHOD(IOThreadPool::getStats) {
+  IOThreadPool* obj = Nan::ObjectWrap::Unwrap<IOThreadPool>(info.Holder());
+
+  std::string stats = obj->me->getStats();
+  info.GetReturnValue().Set(Nan::New(stats.c_str()).ToLocalChecked());
 }
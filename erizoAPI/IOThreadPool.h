@@ -34,6 +34,10 @@ class IOThreadPool : public Nan::ObjectWrap {
      * Starts all workers in the IOThreadPool
      */
     static NAN_METHOD(start);
+    /*
+     * Gets the socket stats of every IOWorker as a JSON string
+     */
+    static NAN_METHOD(getStats);
 
     static Nan::Persistent<v8::Function> constructor;
 };
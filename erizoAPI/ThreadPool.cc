@@ -28,6 +28,8 @@ NAN_MODULE_INIT(ThreadPool::Init) {
   // Prototype
   Nan::SetPrototypeMethod(tpl, "close", close);
   Nan::SetPrototypeMethod(tpl, "start", start);
+  Nan::SetPrototypeMethod(tpl, "enableHandlerStats", enableHandlerStats);
+  Nan::SetPrototypeMethod(tpl, "getStats", getStats);
 
   constructor.Reset(tpl->GetFunction());
   Nan::Set(target, Nan::New("ThreadPool").ToLocalChecked(), Nan::GetFunction(tpl).ToLocalChecked());
@@ -58,3 +60,16 @@ NAN_METHOD(ThreadPool::start) {
 
   obj->me->start();
 }
+
+NAN_METHOD(ThreadPool::enableHandlerStats) {
+  ThreadPool* obj = Nan::ObjectWrap::Unwrap<ThreadPool>(info.Holder());
+
+  obj->me->enableHandlerStats();
+}
+
+NAN_METHOD(ThreadPool::getStats) {
+  ThreadPool* obj = Nan::ObjectWrap::Unwrap<ThreadPool>(info.Holder());
+
+  std::string stats = obj->me->getStats();
+  info.GetReturnValue().Set(Nan::New(stats.c_str()).ToLocalChecked());
+}
@@ -34,6 +34,14 @@ class ThreadPool : public Nan::ObjectWrap {
      * Starts all workers in the ThreadPool
      */
     static NAN_METHOD(start);
+    /*
+     * Makes the MediaStreams of every worker measure their handlers
+     */
+    static NAN_METHOD(enableHandlerStats);
+    /*
+     * Gets the handler stats of every worker as a JSON string
+     */
+    static NAN_METHOD(getStats);
 
     static Nan::Persistent<v8::Function> constructor;
 };
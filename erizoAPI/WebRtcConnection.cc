@@ -204,10 +204,12 @@ NAN_METHOD(WebRtcConnection::New) {
 
     std::shared_ptr<erizo::Worker> worker = thread_pool->me->getLessUsedWorker();
     std::shared_ptr<erizo::IOWorker> io_worker = io_thread_pool->me->getLessUsedIOWorker();
+    std::shared_ptr<erizo::Worker> crypto_worker = thread_pool->me->getLessUsedCryptoWorker();
+    iceConfig.use_udp_mux = io_worker->getUdpMux() != nullptr;
 
     WebRtcConnection* obj = new WebRtcConnection();
     obj->id_ = wrtcId;
-    obj->me = std::make_shared<erizo::WebRtcConnection>(worker, io_worker, wrtcId, iceConfig,
+    obj->me = std::make_shared<erizo::WebRtcConnection>(worker, io_worker, crypto_worker, wrtcId, iceConfig,
                                                         rtp_mappings, ext_mappings, obj);
     obj->Wrap(info.This());
     ELOG_DEBUG("%s, message: Created", obj->toLog());
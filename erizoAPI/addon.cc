@@ -12,6 +12,22 @@
 #include "ConnectionDescription.h"
 #include "ThreadPool.h"
 #include "IOThreadPool.h"
+#include "dtls/DtlsSocket.h"
+
+#include <string>
+
+// Prepares the DTLS certificate in the background: preloadDtlsIdentity([certificateFile, keyFile])
+NAN_METHOD(PreloadDtlsIdentity) {
+  std::string cert_file = "";
+  std::string key_file = "";
+  if (info.Length() > 1) {
+    v8::String::Utf8Value cert_param(Nan::To<v8::String>(info[0]).ToLocalChecked());
+    v8::String::Utf8Value key_param(Nan::To<v8::String>(info[1]).ToLocalChecked());
+    cert_file = std::string(*cert_param);
+    key_file = std::string(*key_param);
+  }
+  dtls::DtlsSocketContext::Preload(cert_file, key_file);
+}
 
 NAN_MODULE_INIT(InitAll) {
   WebRtcConnection::Init(target);
@@ -23,6 +39,7 @@ NAN_MODULE_INIT(InitAll) {
   ThreadPool::Init(target);
   IOThreadPool::Init(target);
   ConnectionDescription::Init(target);
+  Nan::SetMethod(target, "preloadDtlsIdentity", PreloadDtlsIdentity);
 }
 
 NODE_MODULE(addon, InitAll)
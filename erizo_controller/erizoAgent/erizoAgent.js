@@ -129,6 +129,10 @@ launchErizoJS = function(erizo) {
     if (global.config.erizoAgent.launchDebugErizoJS) {
       erizoLaunchOptions.push('-d');
     }
+    // Every ErizoJS has its own steering table, so they cannot share the mux port
+    if (global.config.erizo && global.config.erizo.udpMuxPort) {
+      erizoLaunchOptions.push('-u', global.config.erizo.udpMuxPort + erizo.position);
+    }
 
     if (global.config.erizoAgent.useIndividualLogFiles){
         out = fs.openSync(global.config.erizoAgent.instanceLogDir + '/erizo-' + id + '.log', 'a');
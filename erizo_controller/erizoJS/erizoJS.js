@@ -10,6 +10,9 @@ global.config.erizo = global.config.erizo || {};
 global.config.erizo.numWorkers = global.config.erizo.numWorkers || 24;
 global.config.erizo.numIOWorkers = global.config.erizo.numIOWorkers || 1;
 global.config.erizo.useNicer = global.config.erizo.useNicer || false;
+global.config.erizo.udpMuxPort = global.config.erizo.udpMuxPort || 0;
+global.config.erizo.udpMuxGro = global.config.erizo.udpMuxGro || false;
+global.config.erizo.ioWorkerBackend = global.config.erizo.ioWorkerBackend || 'nrappkit';
 global.config.erizo.stunserver = global.config.erizo.stunserver || '';
 global.config.erizo.stunport = global.config.erizo.stunport || 0;
 global.config.erizo.minport = global.config.erizo.minport || 0;
@@ -19,6 +22,9 @@ global.config.erizo.turnport = global.config.erizo.turnport || 0;
 global.config.erizo.turnusername = global.config.erizo.turnusername || '';
 global.config.erizo.turnpass = global.config.erizo.turnpass || '';
 global.config.erizo.networkinterface = global.config.erizo.networkinterface || '';
+global.config.erizo.dtlsCertificateFile = global.config.erizo.dtlsCertificateFile || '';
+global.config.erizo.dtlsKeyFile = global.config.erizo.dtlsKeyFile || '';
+global.config.erizo.handlerStats = global.config.erizo.handlerStats || false;
 global.mediaConfig = mediaConfig || {};
 // Parse command line arguments
 var getopt = new Getopt([
@@ -34,6 +40,7 @@ var getopt = new Getopt([
   ['T' , 'turnport=ARG'               , 'TURN server PORT'],
   ['c' , 'turnusername=ARG'           , 'TURN username'],
   ['C' , 'turnpass=ARG'               , 'TURN password'],
+  ['u' , 'udp-mux-port=ARG'           , 'UDP mux port'],
   ['d', 'debug'                   , 'Run Debug erizoAPI addon'],
   ['h' , 'help'                       , 'display this help']
 ]);
@@ -64,6 +71,9 @@ for (var prop in opt.options) {
                 global.config.logger = global.config.logger || {};
                 global.config.logger.configFile = value;
                 break;
+            case 'udp-mux-port':
+                global.config.erizo.udpMuxPort = parseInt(value, 10);
+                break;
             case 'debug':
                 console.log('Loading debug version');
                 addon = require('./../../erizoAPI/build/Release/addonDebug');
@@ -87,16 +97,29 @@ var controller = require('./erizoJSController');
 // Logger
 var log = logger.getLogger('ErizoJS');
 
+addon.preloadDtlsIdentity(global.config.erizo.dtlsCertificateFile, global.config.erizo.dtlsKeyFile);
+
 var threadPool = new addon.ThreadPool(global.config.erizo.numWorkers);
+if (global.config.erizo.handlerStats) {
+  threadPool.enableHandlerStats();
+}
 threadPool.start();
 
-var ioThreadPool = new addon.IOThreadPool(global.config.erizo.numIOWorkers);
+var ioThreadPool = new addon.IOThreadPool(global.config.erizo.numIOWorkers,
+  global.config.erizo.udpMuxPort, global.config.erizo.networkinterface, global.config.erizo.udpMuxGro,
+  global.config.erizo.ioWorkerBackend);
 
-if (global.config.erizo.useNicer) {
+if (global.config.erizo.useNicer || global.config.erizo.udpMuxPort) {
   log.info('Starting ioThreadPool');
-  ioThreadPool.start();
+  if (!ioThreadPool.start()) {
+    log.error('message: Could not start ioThreadPool, udpMuxPort: ' + global.config.erizo.udpMuxPort);
+    process.exit(1);
+  }
 }
 
+// Same period as the MediaStreams add their handler stats to their worker
+var WORKER_STATS_INTERVAL = 30000;
+
 var ejsController = controller.ErizoJSController(threadPool, ioThreadPool);
 
 ejsController.keepAlive = function(callback) {
@@ -119,6 +142,17 @@ amqper.connect(function () {
             log.debug('message: bound to amqp queue, queueId: ErizoJS_' + rpcID );
 
         });
+
+        // Handler stats of the workers and socket stats of the IO workers, next to the stream ones
+        if (global.config.erizoController.report.rtcp_stats) {  // jshint ignore:line
+            setInterval(function () {
+                ejsController.getWorkerStats(function (type, stats) {
+                    amqper.broadcast('stats', {erizoJS: rpcID,
+                                               stats: stats,
+                                               timestamp: new Date().getTime()});
+                });
+            }, WORKER_STATS_INTERVAL);
+        }
     } catch (err) {
         log.error('message: AMQP connection error, ' + logger.objectToLog(err));
     }
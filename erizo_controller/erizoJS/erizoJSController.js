@@ -309,6 +309,17 @@ exports.ErizoJSController = function (threadPool, ioThreadPool) {
         }
     };
 
+    that.getWorkerStats = function (callbackRpc) {
+        var stats = {};
+        if (threadPool) {
+            stats.workers = JSON.parse(threadPool.getStats());
+        }
+        if (io) {
+            stats.ioWorkers = JSON.parse(io.getStats());
+        }
+        callbackRpc('callback', stats);
+    };
+
     that.subscribeToStats = function (streamId, timeout, interval, callbackRpc) {
         var publisher;
         log.debug('message: Requested subscription to stream stats, streamId: ' + streamId);
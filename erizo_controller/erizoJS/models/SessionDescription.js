@@ -8,6 +8,7 @@ var ICEInfo = require('./../../common/semanticSdp/ICEInfo');
 var DTLSInfo = require('./../../common/semanticSdp/DTLSInfo');
 var CodecInfo = require('./../../common/semanticSdp/CodecInfo');
 var SourceInfo = require('./../../common/semanticSdp/SourceInfo');
+var SourceGroupInfo = require('./../../common/semanticSdp/SourceGroupInfo');
 var StreamInfo = require('./../../common/semanticSdp/StreamInfo');
 var TrackInfo = require('./../../common/semanticSdp/TrackInfo');
 var RIDInfo = require('./../../common/semanticSdp/RIDInfo');
@@ -40,6 +41,7 @@ function addSsrc(sources, ssrc, sdp, media, msid = sdp.msidSemantic.token) {
     stream.addTrack(track);
   }
   track.addSSRC(source);
+  return track;
 }
 
 function getMediaInfoFromDescription(info, sdp, mediaType) {
@@ -134,6 +136,15 @@ function getMediaInfoFromDescription(info, sdp, mediaType) {
           addSsrc(sources, ssrc, sdp, media, streamLabel);
         });
       });
+
+      const videoRtxSsrcMap = info.getVideoRtxSsrcMap();
+      Object.keys(videoRtxSsrcMap).forEach((streamLabel) => {
+        Object.keys(videoRtxSsrcMap[streamLabel]).forEach((ssrc) => {
+          const rtxSsrc = videoRtxSsrcMap[streamLabel][ssrc];
+          const track = addSsrc(sources, rtxSsrc, sdp, media, streamLabel);
+          track.addSourceGroup(new SourceGroupInfo('FID', [ssrc, rtxSsrc]));
+        });
+      });
     }
 
     const rids = info.getRids();
@@ -227,6 +238,7 @@ class SessionDescription {
     const streamId = stream.id;
     let videoSsrcList = [];
     let simulcastVideoSsrcList;
+    const videoRtxSsrcs = new Map();
 
     stream.getTracks().forEach((track) => {
       if (track.getMedia() === 'audio') {
@@ -241,12 +253,20 @@ class SessionDescription {
       track.getSourceGroups().forEach((group) => {
         if (group.getSemantics().toUpperCase() === 'SIM') {
           simulcastVideoSsrcList = group.getSSRCs();
+        } else if (group.getSemantics().toUpperCase() === 'FID') {
+          // Retransmissions (RTX) of the first SSRC come on the second one
+          videoRtxSsrcs.set(group.getSSRCs()[0], group.getSSRCs()[1]);
         }
       });
     });
 
-    videoSsrcList = simulcastVideoSsrcList || videoSsrcList;
+    const rtxSsrcs = Array.from(videoRtxSsrcs.values());
+    videoSsrcList = simulcastVideoSsrcList ||
+      videoSsrcList.filter((ssrc) => rtxSsrcs.indexOf(ssrc) === -1);
     info.setVideoSsrcList(streamId, videoSsrcList);
+    videoRtxSsrcs.forEach((rtxSsrc, ssrc) => {
+      info.setVideoRtxSsrc(streamId, ssrc, rtxSsrc);
+    });
   }
 
   processSdp() {
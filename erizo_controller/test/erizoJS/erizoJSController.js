@@ -49,6 +49,23 @@ describe('Erizo JS Controller', function() {
     expect(controller.removeSubscriptions).not.to.be.undefined;  // jshint ignore:line
   });
 
+  describe('Get Worker Stats', function() {
+    it('should report the stats of both thread pools', function() {
+      var threadPool = {getStats: sinon.stub().returns('{"0":{"handlers":{}}}')};
+      var ioThreadPool = {getStats: sinon.stub().returns('{"0":{"sendErrors":0}}')};
+      var callback = sinon.stub();
+      controller = require('../../erizoJS/erizoJSController').ErizoJSController(threadPool, ioThreadPool);
+
+      controller.getWorkerStats(callback);
+
+      expect(callback.callCount).to.equal(1);
+      expect(callback.args[0]).to.deep.equal(['callback', {
+        workers: {0: {handlers: {}}},
+        ioWorkers: {0: {sendErrors: 0}}
+      }]);
+    });
+  });
+
   describe('Add External Input', function() {
     var callback;
     var kArbitraryStreamId = 'streamId1';
@@ -143,6 +143,7 @@ var reset = module.exports.reset = function() {
     setBundle: sinon.stub(),
     setAudioAndVideo: sinon.stub(),
     setVideoSsrcList: sinon.stub(),
+    setVideoRtxSsrc: sinon.stub(),
     postProcessInfo: sinon.stub(),
     hasAudio: sinon.stub(),
     hasVideo: sinon.stub(),
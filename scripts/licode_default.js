@@ -182,6 +182,29 @@ config.erizo.maxport = 0; // default value: 0
 //Use of internal nICEr library instead of libNice.
 config.erizo.useNicer = false;  // default value: false
 
+// If not 0, all connections of an ErizoJS share a single UDP port and run as ICE-lite agents. Every IO worker
+// opens its own socket on it with SO_REUSEPORT. Overrides useNicer, except for peers without rtcp-mux, which get
+// a socket per component as if it was 0.
+// ErizoAgent gives its ErizoJS processes consecutive ports starting at this one, so the range from udpMuxPort to
+// udpMuxPort + erizoAgent.maxProcesses - 1 has to be open.
+config.erizo.udpMuxPort = 0;  // default value: 0
+// Let the kernel coalesce bursts of received datagrams (UDP_GRO) on the udpMuxPort sockets.
+// Sends are always coalesced with UDP GSO when the kernel supports it.
+config.erizo.udpMuxGro = false;  // default value: false
+// Event loop of the IO workers: 'nrappkit' or 'io_uring' (Linux >= 6.0, falls back to 'nrappkit').
+// With 'io_uring' the udpMuxPort sockets are read and written through the ring. It requires udpMuxPort.
+config.erizo.ioWorkerBackend = 'nrappkit';  // default value: 'nrappkit'
+
+// DTLS certificate (PEM) and private key shared by all ErizoJS processes. When they cannot be read, the first
+// process generates them and saves them there. Leave empty to generate a new certificate in every process.
+config.erizo.dtlsCertificateFile = '';  // default value: ''
+config.erizo.dtlsKeyFile = '';  // default value: ''
+
+// Measures packets, drops and time of every handler of the MediaStreams. They show up under "handlers" in the
+// stream stats and, per worker, in the getWorkerStats RPC of ErizoJS, which is also broadcast every 30s when
+// erizoController.report.rtcp_stats is on. It costs two clock reads per handler and packet.
+config.erizo.handlerStats = false;  // default value: false
+
 config.erizo.disabledHandlers = []; // there are no handlers disabled by default
 
 /***** END *****/